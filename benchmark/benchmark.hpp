@@ -0,0 +1,101 @@
+#ifndef SIPLASPLAS_BENCHMARK_BENCHMARK_HPP
+#define SIPLASPLAS_BENCHMARK_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace cpp
+{
+
+namespace benchmark
+{
+
+/**
+ * \brief Prevents the compiler from optimizing away the computation
+ * of the given value
+ */
+template<typename T>
+inline void doNotOptimize(T&& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * \brief Prevents the compiler from caching memory values across this point
+ */
+inline void clobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * \brief Result of a benchmark run
+ */
+struct Result
+{
+    std::string name;
+    std::uint64_t iterations;
+    double nsPerIteration;
+};
+
+/**
+ * \brief Runs the given function in a loop until the run takes
+ * at least \p minTime, then prints the average time per iteration
+ *
+ * \param name Name of the benchmark
+ * \param function Benchmark body. Invoked once per iteration
+ * \param minTime Minimal duration of the measured run
+ *
+ * \returns The benchmark results
+ */
+template<typename Function>
+Result run(const std::string& name, Function function,
+           std::chrono::nanoseconds minTime = std::chrono::milliseconds(200))
+{
+    using clock = std::chrono::steady_clock;
+
+    std::uint64_t iterations = 1;
+    std::chrono::nanoseconds elapsed{0};
+
+    while(true)
+    {
+        const auto start = clock::now();
+
+        for(std::uint64_t i = 0; i < iterations; ++i)
+        {
+            function();
+        }
+
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+
+        if(elapsed >= minTime)
+        {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    Result result{name, iterations, static_cast<double>(elapsed.count()) / iterations};
+    std::printf("%-60s %12.3f ns %14llu iterations\n", result.name.c_str(),
+        result.nsPerIteration, static_cast<unsigned long long>(result.iterations));
+    std::fflush(stdout);
+
+    return result;
+}
+
+}
+
+}
+
+#endif // SIPLASPLAS_BENCHMARK_BENCHMARK_HPP
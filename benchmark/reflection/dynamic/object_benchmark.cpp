@@ -0,0 +1,127 @@
+#include <benchmark.hpp>
+#include <siplasplas/reflection/dynamic/object.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+using cpp::dynamic_reflection::Object;
+using cpp::dynamic_reflection::Type;
+
+namespace
+{
+
+struct Vector3
+{
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+constexpr std::size_t count = 1024;
+
+}
+
+int main()
+{
+    const std::string str = "a string long enough to not fit in the SSO buffer";
+    Object intObject{42};
+    Object stringObject{str};
+    Type vectorType = Type::get<Vector3>();
+    Type::registerType<int>();
+
+    run("new/delete: int", [] {
+        auto value = std::make_unique<int>(42);
+        doNotOptimize(value);
+    });
+    run("Type: construct/destroy Vector3", [&] {
+        void* object = vectorType.construct();
+        doNotOptimize(object);
+        vectorType.destroy(object);
+    });
+    run("Object: construct/destroy int", [] {
+        Object object{42};
+        doNotOptimize(object);
+    });
+    run("Object: construct/destroy Vector3 from Type", [&] {
+        Object object{vectorType};
+        doNotOptimize(object);
+    });
+    run("Object: copy int", [&] {
+        Object copy{intObject};
+        doNotOptimize(copy);
+    });
+    run("Object: copy std::string", [&] {
+        Object copy{stringObject};
+        doNotOptimize(copy);
+    });
+    run("Object: copy assign, changing type", [&] {
+        Object object{42};
+        object = stringObject;
+        doNotOptimize(object);
+    });
+
+    const std::string vectorName = vectorType.typeName();
+    const std::string vectorClassName = "struct " + vectorName;
+
+    run("Type: get by name", [&] {
+        doNotOptimize(Type::get(vectorName));
+    });
+    run("Type: get by name with struct prefix", [&] {
+        doNotOptimize(Type::get(vectorClassName));
+    });
+    run("Object: fromString int", [] {
+        Object object = Object::fromString("int", "42");
+        doNotOptimize(object);
+    });
+
+    // Many live objects, freed in allocation order, so storage
+    // is recycled in bulk instead of one slot at a time
+    std::vector<std::unique_ptr<int>> pointers;
+    std::vector<void*> raw;
+    std::vector<Object> objects;
+    pointers.reserve(count);
+    raw.reserve(count);
+    objects.reserve(count);
+
+    run("new/delete: 1024 ints", [&] {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            pointers.push_back(std::make_unique<int>(static_cast<int>(i)));
+        }
+
+        doNotOptimize(pointers.data());
+        pointers.clear();
+    });
+    run("Type: 1024 Vector3", [&] {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            raw.push_back(vectorType.construct());
+        }
+
+        doNotOptimize(raw.data());
+
+        for(void* object : raw)
+        {
+            vectorType.destroy(object);
+        }
+
+        raw.clear();
+    });
+    run("Object: 1024 ints", [&] {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            objects.emplace_back(static_cast<int>(i));
+        }
+
+        doNotOptimize(objects.data());
+        objects.clear();
+    });
+    run("Object: 1024 std::string copies", [&] {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            objects.emplace_back(stringObject);
+        }
+
+        doNotOptimize(objects.data());
+        objects.clear();
+    });
+}
@@ -0,0 +1,205 @@
+#include <benchmark.hpp>
+#include "datamodel.hpp"
+#include <siplasplas/reflection/static/binary.hpp>
+#include <siplasplas/utility/fusion.hpp>
+#include <json.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+using namespace benchmark_model;
+namespace binary = cpp::static_reflection::binary;
+
+namespace
+{
+
+/*
+ * JSON path: the reflection driven JSON walker of the serialization
+ * example, without type names. Objects map field names to values
+ */
+template<typename T>
+std::enable_if_t<!std::is_class<T>::value, nlohmann::json> toJson(const T& value);
+nlohmann::json toJson(const std::string& value);
+template<typename T>
+nlohmann::json toJson(const std::vector<T>& values);
+template<typename Value>
+nlohmann::json toJson(const std::map<std::string, Value>& values);
+template<typename T>
+std::enable_if_t<std::is_class<T>::value, nlohmann::json> toJson(const T& object);
+
+template<typename T>
+std::enable_if_t<!std::is_class<T>::value> fromJson(const nlohmann::json& json, T& value);
+void fromJson(const nlohmann::json& json, std::string& value);
+template<typename T>
+void fromJson(const nlohmann::json& json, std::vector<T>& values);
+template<typename Value>
+void fromJson(const nlohmann::json& json, std::map<std::string, Value>& values);
+template<typename T>
+std::enable_if_t<std::is_class<T>::value> fromJson(const nlohmann::json& json, T& object);
+
+template<typename T>
+std::enable_if_t<!std::is_class<T>::value, nlohmann::json> toJson(const T& value)
+{
+    return value;
+}
+
+nlohmann::json toJson(const std::string& value)
+{
+    return value;
+}
+
+template<typename T>
+nlohmann::json toJson(const std::vector<T>& values)
+{
+    auto json = nlohmann::json::array();
+
+    for(const auto& value : values)
+    {
+        json.push_back(toJson(value));
+    }
+
+    return json;
+}
+
+template<typename Value>
+nlohmann::json toJson(const std::map<std::string, Value>& values)
+{
+    auto json = nlohmann::json::object();
+
+    for(const auto& keyValue : values)
+    {
+        json[keyValue.first] = toJson(keyValue.second);
+    }
+
+    return json;
+}
+
+template<typename T>
+std::enable_if_t<std::is_class<T>::value, nlohmann::json> toJson(const T& object)
+{
+    auto json = nlohmann::json::object();
+
+    cpp::foreach_type<typename cpp::static_reflection::Class<T>::Fields>([&](auto type)
+    {
+        using FieldInfo = cpp::meta::type_t<decltype(type)>;
+        json[FieldInfo::SourceInfo::spelling().c_str()] = toJson(FieldInfo::get(object));
+    });
+
+    return json;
+}
+
+template<typename T>
+std::enable_if_t<!std::is_class<T>::value> fromJson(const nlohmann::json& json, T& value)
+{
+    value = json.get<T>();
+}
+
+void fromJson(const nlohmann::json& json, std::string& value)
+{
+    value = json.get<std::string>();
+}
+
+template<typename T>
+void fromJson(const nlohmann::json& json, std::vector<T>& values)
+{
+    values.resize(json.size());
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        fromJson(json[i], values[i]);
+    }
+}
+
+template<typename Value>
+void fromJson(const nlohmann::json& json, std::map<std::string, Value>& values)
+{
+    values.clear();
+
+    for(auto it = json.begin(); it != json.end(); ++it)
+    {
+        fromJson(it.value(), values[it.key()]);
+    }
+}
+
+template<typename T>
+std::enable_if_t<std::is_class<T>::value> fromJson(const nlohmann::json& json, T& object)
+{
+    cpp::foreach_type<typename cpp::static_reflection::Class<T>::Fields>([&](auto type)
+    {
+        using FieldInfo = cpp::meta::type_t<decltype(type)>;
+        fromJson(json[FieldInfo::SourceInfo::spelling().c_str()], FieldInfo::get(object));
+    });
+}
+
+std::vector<Sample> makeSamples(std::size_t count)
+{
+    std::vector<Sample> samples(count);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        auto& sample = samples[i];
+
+        sample.sensor = "sensor-" + std::to_string(i % 16);
+        sample.timestamp = 1500000000000ull + i;
+        sample.position = {i * 0.5, i * 0.25, -1.0 * i};
+        sample.readings.assign(16, static_cast<float>(i) * 0.1f);
+        sample.tags = {{"unit", static_cast<int>(i % 3)}, {"quality", 100}};
+    }
+
+    return samples;
+}
+
+constexpr std::size_t count = 1000;
+
+}
+
+int main()
+{
+    const auto samples = makeSamples(count);
+    const std::vector<Position> positions(count * 16, Position{1.0, 2.0, 3.0});
+
+    std::vector<char> binaryBuffer;
+    std::string jsonBuffer;
+
+    const auto binarySize = binary::serialize(samples).size();
+    const auto jsonSize = toJson(samples).dump().size();
+
+    std::printf("1000 samples: binary %zu bytes, json %zu bytes\n", binarySize, jsonSize);
+
+    run("binary: serialize 1000 samples", [&] {
+        binaryBuffer.clear();
+        binary::serialize(samples, binaryBuffer);
+        doNotOptimize(binaryBuffer.data());
+    });
+    run("json: serialize 1000 samples", [&] {
+        jsonBuffer = toJson(samples).dump();
+        doNotOptimize(jsonBuffer.data());
+    });
+
+    {
+        binaryBuffer = binary::serialize(samples);
+        jsonBuffer = toJson(samples).dump();
+        std::vector<Sample> result;
+
+        run("binary: deserialize 1000 samples", [&] {
+            binary::deserialize(binaryBuffer.data(), binaryBuffer.size(), result);
+            doNotOptimize(result.data());
+        });
+        run("json: deserialize 1000 samples", [&] {
+            fromJson(nlohmann::json::parse(jsonBuffer), result);
+            doNotOptimize(result.data());
+        });
+    }
+
+    // Packed classes: one copy for the whole vector
+    run("binary: serialize 16000 positions", [&] {
+        binaryBuffer.clear();
+        binary::serialize(positions, binaryBuffer);
+        doNotOptimize(binaryBuffer.data());
+    });
+    run("json: serialize 16000 positions", [&] {
+        jsonBuffer = toJson(positions).dump();
+        doNotOptimize(jsonBuffer.data());
+    });
+}
@@ -0,0 +1,32 @@
+#ifndef SIPLASPLAS_BENCHMARK_REFLECTION_STATIC_DATAMODEL_HPP
+#define SIPLASPLAS_BENCHMARK_REFLECTION_STATIC_DATAMODEL_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace benchmark_model
+{
+
+struct Position
+{
+    double x;
+    double y;
+    double z;
+};
+
+struct Sample
+{
+    std::string sensor;
+    std::uint64_t timestamp;
+    Position position;
+    std::vector<float> readings;
+    std::map<std::string, int> tags;
+};
+
+}
+
+#include <reflection/benchmark/reflection/static/datamodel.hpp>
+
+#endif // SIPLASPLAS_BENCHMARK_REFLECTION_STATIC_DATAMODEL_HPP
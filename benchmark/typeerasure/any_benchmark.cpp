@@ -0,0 +1,67 @@
+#include <benchmark.hpp>
+#include <siplasplas/typeerasure/any.hpp>
+#include <string>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+class Class
+{
+public:
+    int i = 0;
+    std::string str = "hello";
+
+    int addInts(int a, int b) const
+    {
+        return a + b + i;
+    }
+
+    void setInt(int value)
+    {
+        i = value;
+    }
+};
+
+}
+
+int main()
+{
+    Class object;
+    int a = 20, b = 22;
+
+    cpp::Any32 any{object};
+    any("addInts") = &Class::addInts;
+    any("setInt") = &Class::setInt;
+    any["i"] = &Class::i;
+    any["str"] = &Class::str;
+
+    run("direct: method call", [&] {
+        doNotOptimize(object.addInts(a, b));
+    });
+    run("Any32: method call by name", [&] {
+        doNotOptimize(any("addInts")(a, b));
+    });
+    run("Any32: void method call by name", [&] {
+        any("setInt")(a);
+    });
+
+    auto method = any("addInts");
+    run("Any32: method call through cached proxy", [&] {
+        doNotOptimize(method(a, b));
+    });
+
+    run("Any32: method lookup", [&] {
+        doNotOptimize(any.hasMethod("addInts"));
+    });
+    run("Any32: attribute get by name (int)", [&] {
+        doNotOptimize(any["i"].get<int>());
+    });
+    run("Any32: attribute get by name (std::string)", [&] {
+        doNotOptimize(any["str"].get<std::string>());
+    });
+    run("Any32: attribute set by name (int)", [&] {
+        any["i"] = a;
+    });
+}
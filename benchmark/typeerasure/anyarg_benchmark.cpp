@@ -0,0 +1,47 @@
+#include <benchmark.hpp>
+#include <siplasplas/typeerasure/anyarg.hpp>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+
+int main()
+{
+    int i = 42;
+    const int constInt = 42;
+    std::string str = "hello";
+    cpp::SimpleAny32 any{i};
+
+    run("AnyArg: pack int lvalue", [&] {
+        cpp::AnyArg arg{i};
+        doNotOptimize(arg);
+    });
+    run("AnyArg: pack const int lvalue", [&] {
+        cpp::AnyArg arg{constInt};
+        doNotOptimize(arg);
+    });
+    run("AnyArg: pack int rvalue", [&] {
+        cpp::AnyArg arg{42};
+        doNotOptimize(arg);
+    });
+    run("AnyArg: pack std::string lvalue", [&] {
+        cpp::AnyArg arg{str};
+        doNotOptimize(arg);
+    });
+    run("AnyArg: pack ReferenceSimpleAny", [&] {
+        cpp::AnyArg arg{any.getReference()};
+        doNotOptimize(arg);
+    });
+    run("AnyArg: pack and get int", [&] {
+        cpp::AnyArg arg{i};
+        doNotOptimize(arg.get<int>());
+    });
+    run("AnyArg: pack 3 args array", [&] {
+        cpp::AnyArg args[] = {i, str, constInt, cpp::AnyArg(nullptr)};
+        doNotOptimize(args);
+    });
+    run("AnyArg: pack 3 args vector", [&] {
+        std::vector<cpp::AnyArg> args{i, str, constInt};
+        doNotOptimize(args);
+    });
+}
@@ -0,0 +1,57 @@
+#include <benchmark.hpp>
+#include <siplasplas/typeerasure/field.hpp>
+#include <string>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+class Class
+{
+public:
+    int i = 0;
+    std::string str = "hello";
+};
+
+}
+
+int main()
+{
+    Class object;
+    cpp::SimpleAny32 anyObject{object};
+    int value = 42;
+    const std::string str = "hello, world!";
+
+    cpp::typeerasure::Field32 intField{&Class::i};
+    cpp::typeerasure::Field32 stringField{&Class::str};
+
+    run("direct: get int member", [&] {
+        doNotOptimize(object.i);
+    });
+    run("Field32: get int (getAs)", [&] {
+        doNotOptimize(intField.getAs<int>(object));
+    });
+    run("Field32: get int (type-erased)", [&] {
+        doNotOptimize(intField.get(object));
+    });
+    run("Field32: get int from SimpleAny32 object", [&] {
+        doNotOptimize(intField.getAs<int>(anyObject));
+    });
+    run("Field32: get std::string (getAs)", [&] {
+        doNotOptimize(stringField.getAs<std::string>(object));
+    });
+
+    run("direct: set int member", [&] {
+        object.i = value;
+        clobberMemory();
+    });
+    run("Field32: set int", [&] {
+        intField.getAs<int>(object) = value;
+        clobberMemory();
+    });
+    run("Field32: set std::string", [&] {
+        stringField.getAs<std::string>(object) = str;
+        clobberMemory();
+    });
+}
@@ -0,0 +1,185 @@
+#include <benchmark.hpp>
+#include <siplasplas/typeerasure/function.hpp>
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+using namespace cpp::typeerasure;
+
+namespace
+{
+
+int addInts(int a, int b)
+{
+    return a + b;
+}
+
+using Big = std::array<int, 16>;
+
+Big makeBig(int i)
+{
+    Big big;
+    big.fill(i);
+    return big;
+}
+
+struct Class
+{
+    int value = 2;
+
+    int addInts(int a, int b) const
+    {
+        return a + b + value;
+    }
+};
+
+}
+
+int main()
+{
+    int a = 20, b = 22;
+    Class object;
+    std::string str = "hello";
+
+    auto lambda = [&str](int i) { return static_cast<int>(str.size()) + i; };
+
+    // Baseline: direct calls
+    {
+        int (*volatile function)(int, int) = addInts;
+
+        run("direct: free function pointer", [&] {
+            doNotOptimize(function(a, b));
+        });
+        run("direct: lambda", [&] {
+            doNotOptimize(lambda(a));
+        });
+    }
+
+    // std::function
+    {
+        std::function<int(int, int)> free{addInts};
+        std::function<int(const Class&, int, int)> member{&Class::addInts};
+        std::function<int(int)> functor{lambda};
+
+        run("std::function: free function", [&] {
+            doNotOptimize(free(a, b));
+        });
+        run("std::function: member function", [&] {
+            doNotOptimize(member(object, a, b));
+        });
+        run("std::function: lambda", [&] {
+            doNotOptimize(functor(a));
+        });
+    }
+
+    // cpp::typeerasure::Function32
+    {
+        Function32 free{addInts};
+        Function32 member{&Class::addInts};
+        Function32 functor{lambda};
+        std::vector<cpp::AnyArg> args{a, b};
+        std::vector<cpp::SimpleAny32> anyArgs{cpp::SimpleAny32{a}, cpp::SimpleAny32{b}};
+
+        run("Function32: free function", [&] {
+            doNotOptimize(free(a, b));
+        });
+        run("Function32: member function", [&] {
+            doNotOptimize(member(object, a, b));
+        });
+        run("Function32: lambda", [&] {
+            doNotOptimize(functor(a));
+        });
+        run("Function32: free function, invoke(vector<AnyArg>)", [&] {
+            doNotOptimize(free.invoke(args));
+        });
+        run("Function32: free function, invoke(vector<SimpleAny32>)", [&] {
+            doNotOptimize(free.invoke(anyArgs));
+        });
+    }
+
+    // Return values overflowing the SimpleAny storage
+    {
+        Function32 function{makeBig};
+        cpp::AnyArg args[] = {a, cpp::AnyArg(nullptr)};
+        Big result;
+        std::aligned_storage_t<sizeof(Big), alignof(Big)> storage;
+        const auto resultType = cpp::typeerasure::TypeInfo::get<Big>();
+
+        run("Function32: big return value, invoke()", [&] {
+            doNotOptimize(function.invoke(args));
+        });
+        run("Function32: big return value, invokeInto(void*)", [&] {
+            function.invokeInto(&storage, resultType, args);
+            doNotOptimize(storage);
+        });
+        run("Function32: big return value, invokeInto(ReferenceSimpleAny)", [&] {
+            function.invokeInto(cpp::ReferenceSimpleAny{result}, args);
+            doNotOptimize(result);
+        });
+    }
+
+    // Applying a function to a collection
+    {
+        constexpr int count = 1024;
+        Function32 function{addInts};
+        std::vector<cpp::AnyVector> columns = {
+            cpp::AnyVector::create<int>(),
+            cpp::AnyVector::create<int>()
+        };
+        auto results = cpp::AnyVector::create<int>();
+        std::vector<int> lhs, rhs, nativeResults;
+
+        for(int i = 0; i < count; ++i)
+        {
+            columns[0].push_back(i);
+            columns[1].push_back(i);
+            lhs.push_back(i);
+            rhs.push_back(i);
+        }
+
+        nativeResults.reserve(count);
+        results.reserve(count);
+
+        run("direct: free function, 1024 calls loop", [&] {
+            nativeResults.clear();
+            for(int i = 0; i < count; ++i)
+            {
+                nativeResults.push_back(addInts(lhs[i], rhs[i]));
+            }
+            doNotOptimize(nativeResults.data());
+        });
+        run("Function32: free function, 1024 calls loop", [&] {
+            nativeResults.clear();
+            for(int i = 0; i < count; ++i)
+            {
+                nativeResults.push_back(function(lhs[i], rhs[i]).get<int>());
+            }
+            doNotOptimize(nativeResults.data());
+        });
+        run("Function32: free function, invokeBatch() 1024 rows", [&] {
+            results.clear();
+            function.invokeBatch(columns, &results);
+            doNotOptimize(results.data());
+        });
+    }
+
+    // Construction and copy
+    {
+        Function32 function{lambda};
+
+        run("std::function: construct from lambda", [&] {
+            std::function<int(int)> f{lambda};
+            doNotOptimize(f);
+        });
+        run("Function32: construct from lambda", [&] {
+            Function32 f{lambda};
+            doNotOptimize(f);
+        });
+        run("Function32: copy", [&] {
+            Function32 copy{function};
+            doNotOptimize(copy);
+        });
+    }
+}
@@ -0,0 +1,65 @@
+#include <benchmark.hpp>
+#include <siplasplas/typeerasure/simpleany.hpp>
+#include <array>
+#include <string>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+// Payloads: fits in any storage, fits in 32 and 64 byte storages,
+// and overflows all the storages (heap allocated)
+using Trivial  = int;
+using Small    = std::string;
+using Overflow = std::array<char, 128>;
+
+template<typename Any, typename T>
+void benchmarkPayload(const std::string& anyName, const std::string& payloadName, const T& value)
+{
+    const std::string prefix = anyName + " (" + payloadName + "): ";
+    Any any{value};
+
+    run(prefix + "construct", [&] {
+        Any other{value};
+        doNotOptimize(other);
+    });
+    run(prefix + "copy", [&] {
+        Any copy{any};
+        doNotOptimize(copy);
+    });
+    run(prefix + "move", [&] {
+        Any moved{std::move(any)};
+        doNotOptimize(moved);
+        any = std::move(moved);
+    });
+    run(prefix + "copy assign", [&] {
+        Any copy;
+        copy = any;
+        doNotOptimize(copy);
+    });
+    run(prefix + "get", [&] {
+        doNotOptimize(any.template get<T>());
+    });
+}
+
+template<typename Any>
+void benchmarkAny(const std::string& name)
+{
+    Overflow overflow;
+    overflow.fill('a');
+
+    benchmarkPayload<Any>(name, "trivial", Trivial{42});
+    benchmarkPayload<Any>(name, "small", Small{"hello"});
+    benchmarkPayload<Any>(name, "overflow", overflow);
+}
+
+}
+
+int main()
+{
+    benchmarkAny<cpp::SimpleAny8>("SimpleAny8");
+    benchmarkAny<cpp::SimpleAny16>("SimpleAny16");
+    benchmarkAny<cpp::SimpleAny32>("SimpleAny32");
+    benchmarkAny<cpp::SimpleAny64>("SimpleAny64");
+}
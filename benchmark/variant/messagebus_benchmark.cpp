@@ -0,0 +1,109 @@
+#include <benchmark.hpp>
+#include <siplasplas/variant/messagebus.hpp>
+#include <thread>
+#include <vector>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+struct Matrix
+{
+    float values[4][4];
+};
+
+using Event = cpp::Message<2, int, float, Matrix>;
+
+struct Handler : public cpp::HandlerFor<Handler, Event>
+{
+    long count = 0;
+
+    void process(int, int) { count += 1; }
+    void process(int, float) { count += 2; }
+    void process(const Matrix&, float) { count += 3; }
+};
+
+constexpr std::size_t batch = 512;
+
+}
+
+int main()
+{
+    std::vector<Event> events;
+
+    for(std::size_t i = 0; i < batch; ++i)
+    {
+        switch(i % 3)
+        {
+        case 0:  events.emplace_back(1, 2); break;
+        case 1:  events.emplace_back(1, 2.0f); break;
+        default: events.emplace_back(Matrix{}, 2.0f); break;
+        }
+    }
+
+    Handler handler;
+
+    run("MessageHandler: receive (512 messages)", [&] {
+        for(const auto& event : events)
+        {
+            handler.receive(event);
+        }
+        doNotOptimize(handler.count);
+    });
+
+    cpp::MessageBus<Event, 1024> bus;
+    bus.connect(handler);
+
+    run("MessageBus: publish + dispatch (512 messages)", [&] {
+        for(const auto& event : events)
+        {
+            bus.publish(event);
+        }
+        bus.dispatch();
+        doNotOptimize(handler.count);
+    });
+
+    cpp::MessageBus<Event, 1024> mailboxBus;
+    cpp::Mailbox<Handler, Event, 1024> mailbox{handler};
+    mailboxBus.connect(mailbox);
+
+    run("MessageBus: publish + dispatch + mailbox dispatch (512 messages)", [&] {
+        for(const auto& event : events)
+        {
+            mailboxBus.publish(event);
+        }
+        mailboxBus.dispatch();
+        mailbox.dispatch();
+        doNotOptimize(handler.count);
+    });
+
+    // Cross thread delivery: The benchmark thread publishes and dispatches,
+    // a receiver thread drains the mailbox
+    std::atomic<bool> done{false};
+    std::thread receiver{[&]
+    {
+        while(!done.load(std::memory_order_relaxed))
+        {
+            mailbox.dispatch();
+        }
+    }};
+
+    run("MessageBus: cross-thread mailbox delivery (512 messages)", [&] {
+        for(const auto& event : events)
+        {
+            while(!mailboxBus.publish(event))
+            {
+                mailboxBus.dispatch();
+            }
+        }
+
+        while(mailboxBus.pending() > 0)
+        {
+            mailboxBus.dispatch();
+        }
+    });
+
+    done = true;
+    receiver.join();
+}
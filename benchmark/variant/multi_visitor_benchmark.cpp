@@ -0,0 +1,98 @@
+#include <benchmark.hpp>
+#include <siplasplas/variant/messagebus.hpp>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+struct Matrix
+{
+    float values[4][4];
+};
+
+struct Handler : public cpp::MessageHandler<Handler, 1, float, int, std::string, Matrix>,
+                 public cpp::MessageHandler<Handler, 2, float, int, std::string, Matrix>,
+                 public cpp::MessageHandler<Handler, 3, float, int, std::string, Matrix>
+{
+    using cpp::MessageHandler<Handler, 1, float, int, std::string, Matrix>::receive;
+    using cpp::MessageHandler<Handler, 2, float, int, std::string, Matrix>::receive;
+    using cpp::MessageHandler<Handler, 3, float, int, std::string, Matrix>::receive;
+
+    mutable long count = 0;
+
+    void process(float) const { count += 1; }
+    void process(int) const { count += 2; }
+    void process(const std::string&) const { count += 3; }
+    void process(const Matrix&) const { count += 4; }
+
+    void process(int, int) const { count += 5; }
+    void process(const std::string&, float) const { count += 6; }
+    void process(const Matrix&, const std::string&) const { count += 7; }
+
+    void process(int, float, const std::string&) const { count += 8; }
+    void process(const Matrix&, int, int) const { count += 9; }
+};
+
+using Value = cpp::Variant<float, int, std::string, Matrix>;
+
+Value value(std::size_t i)
+{
+    switch(i % 4)
+    {
+    case 0:  return 1.0f;
+    case 1:  return 1;
+    case 2:  return std::string{"hello"};
+    default: return Matrix{};
+    }
+}
+
+template<typename Message, std::size_t... Is>
+Message message(std::size_t i, std::index_sequence<Is...>)
+{
+    // Shift the alternative of each argument differently so
+    // the messages go through many different combinations
+    return Message{value(i*(Is + 1) + Is)...};
+}
+
+template<std::size_t Arity>
+std::vector<cpp::Message<Arity, float, int, std::string, Matrix>> messages(std::size_t count)
+{
+    std::vector<cpp::Message<Arity, float, int, std::string, Matrix>> result;
+    result.reserve(count);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        result.push_back(message<cpp::Message<Arity, float, int, std::string, Matrix>>(
+            i, std::make_index_sequence<Arity>()
+        ));
+    }
+
+    return result;
+}
+
+template<std::size_t Arity>
+void runReceive(const std::string& name)
+{
+    Handler handler;
+    const auto input = messages<Arity>(1024);
+
+    run(name + " (1024 messages)", [&] {
+        for(const auto& message : input)
+        {
+            handler.receive(message);
+        }
+        doNotOptimize(handler.count);
+    });
+}
+
+}
+
+int main()
+{
+    runReceive<1>("multi_visitor: 1-ary message receive");
+    runReceive<2>("multi_visitor: 2-ary message receive");
+    runReceive<3>("multi_visitor: 3-ary message receive");
+}
@@ -0,0 +1,334 @@
+#include <benchmark.hpp>
+#include <siplasplas/variant/variant.hpp>
+#include <siplasplas/variant/optional.hpp>
+#include <siplasplas/variant/multi_visitor.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <variant>
+#include <optional>
+#define SIPLASPLAS_BENCHMARK_STD_VARIANT
+#endif
+
+#ifdef SIPLASPLAS_BENCHMARK_BOOST_VARIANT
+#include <boost/variant.hpp>
+#include <boost/variant/multivisitors.hpp>
+#include <boost/optional.hpp>
+#endif
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+constexpr std::size_t count = 1024;
+
+// Alternative I of a variant with trivial payload
+template<std::size_t I>
+struct Trivial
+{
+    int value;
+
+    static Trivial make()
+    {
+        return {static_cast<int>(I)};
+    }
+
+    int key() const
+    {
+        return value;
+    }
+};
+
+// Alternative I of a variant with non-trivial payload
+template<std::size_t I>
+struct NonTrivial
+{
+    std::string value;
+
+    static NonTrivial make()
+    {
+        return {std::string(I + 1, 'a')};
+    }
+
+    int key() const
+    {
+        return static_cast<int>(value.size());
+    }
+};
+
+template<template<typename...> class Variant, template<std::size_t> class Alternative, typename Is>
+struct MakeVariant;
+
+template<template<typename...> class Variant, template<std::size_t> class Alternative, std::size_t... Is>
+struct MakeVariant<Variant, Alternative, std::index_sequence<Is...>>
+{
+    using type = Variant<Alternative<Is>...>;
+
+    template<typename T>
+    static type makeAlternative()
+    {
+        return type(T::make());
+    }
+
+    // Returns a variant with the I-th alternative active,
+    // being I a runtime value
+    static type make(std::size_t i)
+    {
+        using make_t = type(*)();
+        static const make_t makers[] = {&makeAlternative<Alternative<Is>>...};
+
+        return makers[i]();
+    }
+};
+
+template<template<typename...> class Variant, template<std::size_t> class Alternative, std::size_t Count>
+using VariantOf = MakeVariant<Variant, Alternative, std::make_index_sequence<Count>>;
+
+struct Key
+{
+    template<typename T>
+    int operator()(const T& value) const
+    {
+        return value.key();
+    }
+
+    template<typename T, typename U>
+    int operator()(const T& lhs, const U& rhs) const
+    {
+        return lhs.key() + rhs.key();
+    }
+};
+
+// Adapters to the visitation API of each variant implementation
+
+struct CppVariant
+{
+    template<typename... Ts>
+    using variant = cpp::Variant<Ts...>;
+
+    static constexpr const char* name = "cpp::Variant";
+    static constexpr std::size_t maxAlternatives = 32;
+
+    template<typename V>
+    static int visit(const V& v)
+    {
+        return v.template visit<int>(Key{});
+    }
+
+    template<typename V>
+    static int visit(const V& lhs, const V& rhs)
+    {
+        return cpp::multi_visitor<int>(Key{})(lhs, rhs);
+    }
+};
+
+#ifdef SIPLASPLAS_BENCHMARK_STD_VARIANT
+struct StdVariant
+{
+    template<typename... Ts>
+    using variant = std::variant<Ts...>;
+
+    static constexpr const char* name = "std::variant";
+    static constexpr std::size_t maxAlternatives = 32;
+
+    template<typename V>
+    static int visit(const V& v)
+    {
+        return std::visit(Key{}, v);
+    }
+
+    template<typename V>
+    static int visit(const V& lhs, const V& rhs)
+    {
+        return std::visit(Key{}, lhs, rhs);
+    }
+};
+#endif
+
+#ifdef SIPLASPLAS_BENCHMARK_BOOST_VARIANT
+struct BoostVariant
+{
+    template<typename... Ts>
+    using variant = boost::variant<Ts...>;
+
+    static constexpr const char* name = "boost::variant";
+    // boost::variant alternatives are stored in a MPL list,
+    // limited to 20 types by default
+    static constexpr std::size_t maxAlternatives = 20;
+
+    struct BoostKey : public boost::static_visitor<int>, public Key
+    {};
+
+    template<typename V>
+    static int visit(const V& v)
+    {
+        return boost::apply_visitor(BoostKey{}, v);
+    }
+
+    template<typename V>
+    static int visit(const V& lhs, const V& rhs)
+    {
+        return boost::apply_visitor(BoostKey{}, lhs, rhs);
+    }
+};
+#endif
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void benchmarkVariant(const char*, std::false_type)
+{
+    std::printf("%s<%zu alternatives>: not supported\n", Impl::name, Alternatives);
+}
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void benchmarkVariant(const char* payload, std::true_type)
+{
+    using Maker = VariantOf<Impl::template variant, Alternative, Alternatives>;
+    using Variant = typename Maker::type;
+
+    std::mt19937 prng{42};
+    std::uniform_int_distribution<std::size_t> alternative{0, Alternatives - 1};
+    std::vector<Variant> lhs, rhs, assigned;
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        lhs.push_back(Maker::make(alternative(prng)));
+        rhs.push_back(Maker::make(alternative(prng)));
+        assigned.push_back(Maker::make(0));
+    }
+
+    const std::string prefix = std::string{Impl::name} + "<" + std::to_string(Alternatives) + " " + payload + ">: ";
+    int sum = 0;
+
+    run(prefix + "visit (1024 variants)", [&] {
+        for(const auto& v : lhs)
+        {
+            sum += Impl::visit(v);
+        }
+        doNotOptimize(sum);
+    });
+
+    run(prefix + "multi visit (1024 pairs)", [&] {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            sum += Impl::visit(lhs[i], rhs[i]);
+        }
+        doNotOptimize(sum);
+    });
+
+    // Alternates the source of the assignments so the active
+    // alternative of the destination changes most of the times
+    bool fromLhs = true;
+
+    run(prefix + "assignment churn (1024 variants)", [&] {
+        const auto& from = fromLhs ? lhs : rhs;
+        fromLhs = !fromLhs;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            assigned[i] = from[i];
+        }
+        clobberMemory();
+    });
+}
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void benchmarkVariant(const char* payload)
+{
+    benchmarkVariant<Impl, Alternative, Alternatives>(payload,
+        std::integral_constant<bool, (Alternatives <= Impl::maxAlternatives)>());
+}
+
+template<typename Impl>
+void benchmarkVariants()
+{
+    benchmarkVariant<Impl, Trivial, 2>("trivial");
+    benchmarkVariant<Impl, Trivial, 8>("trivial");
+    benchmarkVariant<Impl, Trivial, 32>("trivial");
+    benchmarkVariant<Impl, NonTrivial, 2>("non-trivial");
+    benchmarkVariant<Impl, NonTrivial, 8>("non-trivial");
+    benchmarkVariant<Impl, NonTrivial, 32>("non-trivial");
+}
+
+template<typename Optional>
+void benchmarkOptional(const std::string& name)
+{
+    std::vector<Optional> optionals(count);
+    const std::string value = "hello";
+
+    run(name + ": assign and reset (1024 optionals)", [&] {
+        for(auto& optional : optionals)
+        {
+            optional = value;
+        }
+        for(auto& optional : optionals)
+        {
+            optional = Optional();
+        }
+        clobberMemory();
+    });
+}
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void printSize(const char* payload, std::true_type)
+{
+    std::printf("sizeof(%s<%zu %s>) = %zu\n", Impl::name, Alternatives, payload,
+        sizeof(typename VariantOf<Impl::template variant, Alternative, Alternatives>::type));
+}
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void printSize(const char*, std::false_type)
+{}
+
+template<typename Impl, template<std::size_t> class Alternative, std::size_t Alternatives>
+void printSize(const char* payload)
+{
+    printSize<Impl, Alternative, Alternatives>(payload,
+        std::integral_constant<bool, (Alternatives <= Impl::maxAlternatives)>());
+}
+
+template<typename Impl>
+void printSizes()
+{
+    printSize<Impl, Trivial, 2>("trivial");
+    printSize<Impl, Trivial, 8>("trivial");
+    printSize<Impl, Trivial, 32>("trivial");
+    printSize<Impl, NonTrivial, 2>("non-trivial");
+}
+
+}
+
+int main()
+{
+    printSizes<CppVariant>();
+    std::printf("sizeof(cpp::Optional<int>) = %zu, sizeof(cpp::Optional<std::string>) = %zu\n",
+        sizeof(cpp::Optional<int>), sizeof(cpp::Optional<std::string>));
+#ifdef SIPLASPLAS_BENCHMARK_STD_VARIANT
+    printSizes<StdVariant>();
+    std::printf("sizeof(std::optional<int>) = %zu, sizeof(std::optional<std::string>) = %zu\n",
+        sizeof(std::optional<int>), sizeof(std::optional<std::string>));
+#endif
+#ifdef SIPLASPLAS_BENCHMARK_BOOST_VARIANT
+    printSizes<BoostVariant>();
+    std::printf("sizeof(boost::optional<int>) = %zu, sizeof(boost::optional<std::string>) = %zu\n",
+        sizeof(boost::optional<int>), sizeof(boost::optional<std::string>));
+#endif
+
+    benchmarkVariants<CppVariant>();
+#ifdef SIPLASPLAS_BENCHMARK_STD_VARIANT
+    benchmarkVariants<StdVariant>();
+#endif
+#ifdef SIPLASPLAS_BENCHMARK_BOOST_VARIANT
+    benchmarkVariants<BoostVariant>();
+#endif
+
+    benchmarkOptional<cpp::Optional<std::string>>("cpp::Optional<std::string>");
+#ifdef SIPLASPLAS_BENCHMARK_STD_VARIANT
+    benchmarkOptional<std::optional<std::string>>("std::optional<std::string>");
+#endif
+#ifdef SIPLASPLAS_BENCHMARK_BOOST_VARIANT
+    benchmarkOptional<boost::optional<std::string>>("boost::optional<std::string>");
+#endif
+}
@@ -0,0 +1,91 @@
+#include <benchmark.hpp>
+#include <siplasplas/variant/variantvector.hpp>
+#include <random>
+#include <vector>
+
+using namespace cpp::benchmark;
+
+namespace
+{
+
+struct Matrix
+{
+    float values[4][4];
+};
+
+using Variant = cpp::Variant<int, float, Matrix>;
+using VariantVector = cpp::VariantVector<int, float, Matrix>;
+
+constexpr std::size_t count = 4096;
+
+}
+
+int main()
+{
+    std::vector<Variant> variants;
+    VariantVector vector;
+    std::mt19937 prng{42};
+    std::uniform_int_distribution<int> alternative{0, 2};
+
+    variants.reserve(count);
+    vector.reserve(count);
+
+    // Random alternatives, so per element dispatch is unpredictable
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        switch(alternative(prng))
+        {
+        case 0:
+            variants.emplace_back(1);
+            vector.push_back(1);
+            break;
+        case 1:
+            variants.emplace_back(1.0f);
+            vector.push_back(1.0f);
+            break;
+        default:
+            variants.emplace_back(Matrix{});
+            vector.push_back(Matrix{});
+            break;
+        }
+    }
+
+    float sum = 0.0f;
+
+    auto accumulate = cpp::visitor<void>(
+        [&sum](int i) { sum += i; },
+        [&sum](float f) { sum += f; },
+        [&sum](const Matrix& m) { sum += m.values[0][0]; }
+    );
+
+    run("std::vector<cpp::Variant>: visit (4096 elements)", [&] {
+        for(const auto& variant : variants)
+        {
+            variant.visit(accumulate);
+        }
+        doNotOptimize(sum);
+    });
+    run("cpp::VariantVector: visit in order (4096 elements)", [&] {
+        vector.visit(accumulate);
+        doNotOptimize(sum);
+    });
+    run("cpp::VariantVector: visit partitions (4096 elements)", [&] {
+        vector.visit_partitions(accumulate);
+        doNotOptimize(sum);
+    });
+
+    run("std::vector<cpp::Variant>: increment floats (4096 elements)", [&] {
+        for(auto& variant : variants)
+        {
+            if(variant.index() == Variant::index_of<float>())
+            {
+                variant.get<float>() += 1.0f;
+            }
+        }
+        clobberMemory();
+    });
+    run("cpp::VariantVector: increment floats (4096 elements)", [&] {
+        vector.visit_type<float>([](float& f) { f += 1.0f; });
+        clobberMemory();
+    });
+}
@@ -296,6 +296,10 @@ macro(add_siplasplas_test NAME)
     add_siplasplas_target("${NAME}" UNIT_TEST NAMESPACE tests ${ARGN})
 endmacro()
 
+macro(add_siplasplas_benchmark NAME)
+    add_siplasplas_executable("${NAME}" NAMESPACE benchmarks ${ARGN})
+endmacro()
+
 macro(add_siplasplas_example NAME)
     add_siplasplas_executable("${NAME}" NAMESPACE examples ${ARGN})
 
@@ -308,6 +312,10 @@ macro(add_siplasplas_test_simple NAME)
     add_siplasplas_test("${NAME}" SOURCES ${NAME}_test.cpp ${ARGN})
 endmacro()
 
+macro(add_siplasplas_benchmark_simple NAME)
+    add_siplasplas_benchmark("${NAME}" SOURCES ${NAME}_benchmark.cpp ${ARGN})
+endmacro()
+
 macro(add_siplasplas_example_simple NAME)
     add_siplasplas_example("${NAME}" SOURCES ${NAME}.cpp ${ARGN})
 endmacro()
@@ -3,7 +3,7 @@
 
 /*
  * This example shows the enum reflection API.
- * All query methods are C++11 constexpr
+ * All query methods are constexpr
  */
 
 int main()
@@ -0,0 +1,67 @@
+#include <benchmark.hpp>
+#include "datamodel.hpp"
+#include "mapping.hpp"
+#include <commmodel.pb.h>
+#include <siplasplas/reflection/static/protobuf.hpp>
+#include <reflection/examples/reflection/static/protoserialization/datamodel.hpp>
+#include <reflection/build/examples/reflection/static/protoserialization/commmodel.pb.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace cpp::benchmark;
+namespace wire = cpp::static_reflection::protobuf;
+
+/*
+ * Compares the two ways of sending the data model as commmodel.proto messages:
+ *
+ *  - mapping: copy the data model into the generated protobuf message classes
+ *    (mapping::write()), then serialize the messages with libprotobuf.
+ *  - wire: encode the data model directly, with the reflection driven protobuf wire
+ *    encoder. The data model fields are declared in the same order as the fields
+ *    of commmodel.proto, so the default field numbers match.
+ */
+int main()
+{
+    SettingsOperation data;
+    data.operation = Operation::Get;
+    data.settings.netwokSettings.ipAddress = "192.168.1.2";
+    data.settings.netwokSettings.gateway = "192.168.1.1";
+    data.settings.netwokSettings.pingInterval = std::chrono::milliseconds(10000);
+    data.settings.serverSettings.port = 4242;
+
+    const std::string protobufBytes = mapping::write<commmodel::SettingsOperation>(data).SerializeAsString();
+    const std::vector<char> wireBytes = wire::serialize(data);
+
+    if(std::string(wireBytes.begin(), wireBytes.end()) != protobufBytes)
+    {
+        std::cerr << "The wire encoder output does not match libprotobuf's" << std::endl;
+        return 1;
+    }
+
+    std::string string;
+    std::vector<char> buffer;
+
+    run("mapping: write + SerializeToString", [&] {
+        string.clear();
+        mapping::write<commmodel::SettingsOperation>(data).SerializeToString(&string);
+        doNotOptimize(string);
+    });
+    run("wire: serialize", [&] {
+        buffer.clear();
+        wire::serialize(data, buffer);
+        doNotOptimize(buffer);
+    });
+
+    run("mapping: ParseFromString + read", [&] {
+        commmodel::SettingsOperation proto;
+        proto.ParseFromString(protobufBytes);
+        auto result = mapping::read<SettingsOperation>(proto);
+        doNotOptimize(result);
+    });
+    run("wire: deserialize", [&] {
+        SettingsOperation result;
+        wire::deserialize(wireBytes.data(), wireBytes.size(), result);
+        doNotOptimize(result);
+    });
+}
@@ -1,9 +1,10 @@
 
-#include "messaging.hpp"
+#include <siplasplas/variant/messagebus.hpp>
 
 #include <iostream>
+#include <thread>
 
-using namespace ::cpp::examples;
+using namespace ::cpp;
 
 struct TransformMatrix
 {
@@ -57,4 +58,21 @@ int main()
     myObject.receive(number);
     myObject.receive(transform);
     myObject.receive(appmsgs::LoggingMessage{"hello"s, "world"s});
+
+    // Messages can also be routed through a bus, delivering them
+    // to handlers living in other threads via mailboxes
+    MessageBus<appmsgs::ActionMessage> bus;
+    Mailbox<MyClass, appmsgs::ActionMessage> mailbox{myObject};
+    bus.connect(mailbox);
+
+    bus.publish(hello);
+    bus.publish(transform);
+    bus.dispatch();
+
+    std::thread receiver{[&mailbox]
+    {
+        mailbox.dispatch();
+    }};
+
+    receiver.join();
 }
@@ -104,6 +104,16 @@ public:
     {
         return begin();
     }
+
+    /**
+     * \brief Returns the number of characters of the string
+     *
+     * Views of string literals include the null terminator, which is not counted
+     */
+    constexpr std::size_t length() const
+    {
+        return (size() > 0 && (*this)[size() - 1] == '\0') ? size() - 1 : size();
+    }
 };
 
 using StringViews = ArrayView<const char*>;
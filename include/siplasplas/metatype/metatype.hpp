@@ -2,11 +2,11 @@
 #ifndef SIPLASPLAS_METATYPE_METATYPE_HPP
 #define SIPLASPLAS_METATYPE_METATYPE_HPP
 
-#include <unordered_map>
 #include <memory>
 
 #include <ctti/type_id.hpp>
 #include <string>
+#include <siplasplas/utility/typenameindex.hpp>
 #include <siplasplas/metatype/export.hpp>
 
 namespace cpp
@@ -18,16 +18,18 @@ namespace cpp
         static void registerMetatype()
         {
             std::unique_ptr<MetaTypeBase> metaType = std::unique_ptr<MetaType<T>>( new MetaType<T>{} );
+            const auto name = ctti::type_id<T>().name();
 
-            registry[ctti::unnamed_type_id<T>()] = std::move(metaType);
+            registry.insert(name.begin(), name.length(), std::move(metaType));
         }
 
+        static void* create(const char* typeName, std::size_t length);
         static void* create(const std::string& typeName);
 
         template<typename T, std::size_t N>
         static T* create(const char (&typeName)[N])
         {
-            return static_cast<T*>(create(typeName));
+            return static_cast<T*>(create(typeName, N - 1));
         }
 
         template<typename T>
@@ -46,8 +48,8 @@ namespace cpp
             virtual void* create() const = 0;
         };
 
-        using MetaTypeRegistry = std::unordered_map<ctti::type_index, std::unique_ptr<MetaTypeBase>>;
-        
+        using MetaTypeRegistry = cpp::TypeNameIndex<std::unique_ptr<MetaTypeBase>>;
+
         static MetaTypeRegistry registry;
 
         
@@ -59,8 +61,6 @@ namespace cpp
                 return static_cast<void*>(new T{});
             }
         };
-
-        static void* try_create(const std::string& typeName);
     };
 }
 
@@ -102,14 +102,28 @@ public:
      *
      * \returns A cpp::Any32 object hosting the object. The any has methods and attributes
      * registered pointing to the member functions and objects of the class type, so the returned
-     * object can be manipulated in an OOP way
+     * object can be manipulated in an OOP way. The methods are not copied to each object, all the
+     * objects created by the class share its method table (See methods())
      */
     cpp::Any32 create();
 
+    /**
+     * \brief Returns the method table shared by the objects created with create()
+     *
+     * The table is built the first time it's requested, and rebuilt only if member
+     * entities were registered in the class since then. Objects created before a
+     * rebuild keep the table they were created with.
+     */
+    const std::shared_ptr<const cpp::Any32::Methods>& methods();
+
 private:
     Class(const SourceInfo& sourceInfo, const cpp::typeerasure::TypeInfo& typeInfo);
 
+    std::shared_ptr<Entity> clone() const override;
+
     cpp::typeerasure::TypeInfo _typeInfo;
+    std::shared_ptr<const cpp::Any32::Methods> _methods;
+    std::size_t _methodsChildrenCount;
 };
 
 } // dynamic_reflection
@@ -0,0 +1,298 @@
+#ifndef SIPLASPLAS_REFLECTION_DYNAMIC_DETAIL_OBJECTPOOL_HPP
+#define SIPLASPLAS_REFLECTION_DYNAMIC_DETAIL_OBJECTPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * \brief Maximum number of free slots each thread keeps per type before
+ * giving them back to the shared pool. Define it as 0 to disable the
+ * thread local caches, so every allocation takes the pool lock
+ */
+#ifndef SIPLASPLAS_REFLECTION_OBJECT_POOL_CACHE_SIZE
+#define SIPLASPLAS_REFLECTION_OBJECT_POOL_CACHE_SIZE 64
+#endif // SIPLASPLAS_REFLECTION_OBJECT_POOL_CACHE_SIZE
+
+namespace cpp
+{
+
+namespace dynamic_reflection
+{
+
+namespace detail
+{
+
+/**
+ * \brief Pooled storage for the instances of type T created through
+ * cpp::dynamic_reflection::Type
+ *
+ * Storage is taken from blocks of fixed size slots. Free slots are linked
+ * through their own storage, so both allocate() and deallocate() are O(1):
+ * a freed slot is pushed to the free list directly, no lookup of its block
+ * is needed.
+ *
+ * Each thread keeps a bounded cache of free slots, so the common allocate/free
+ * churn does not take the pool lock. Slots freed by a thread different from the
+ * one that allocated them go to the cache of the freeing thread. Blocks are never
+ * released, the pool lives until the end of the program so objects with static
+ * storage duration can be destroyed safely at exit.
+ */
+template<typename T>
+class ObjectPool
+{
+public:
+    /**
+     * \brief Returns uninitialized storage suitable for an object of type T
+     */
+    static void* allocate()
+    {
+        Cache& cache = threadCache();
+
+        if(cache.head == nullptr)
+        {
+            return shared().refill(cache);
+        }
+
+        Slot* slot = cache.head;
+        cache.head = slot->next;
+        --cache.count;
+
+        return slot;
+    }
+
+    /**
+     * \brief Returns the storage of an object previously allocated with allocate()
+     */
+    static void deallocate(void* pointer)
+    {
+        Cache& cache = threadCache();
+        Slot* slot = static_cast<Slot*>(pointer);
+
+        if(cache.count < cache.capacity)
+        {
+            slot->next = cache.head;
+            cache.head = slot;
+            ++cache.count;
+        }
+        else
+        {
+            shared().release(cache, slot);
+        }
+    }
+
+    /**
+     * \brief Returns the size in bytes of the pool slots
+     */
+    static constexpr std::size_t slotSize()
+    {
+        return roundUp(
+            sizeof(T) > sizeof(Slot) ? sizeof(T) : sizeof(Slot),
+            slotAlignment()
+        );
+    }
+
+    /**
+     * \brief Returns the alignment of the pool slots
+     */
+    static constexpr std::size_t slotAlignment()
+    {
+        return alignof(T) > alignof(Slot) ? alignof(T) : alignof(Slot);
+    }
+
+    /**
+     * \brief Returns the number of slots allocated per block
+     */
+    static constexpr std::size_t slotsPerBlock()
+    {
+        return slotSize() < blockBytes() / 16 ? blockBytes() / slotSize() : 16;
+    }
+
+private:
+    struct Slot
+    {
+        Slot* next;
+    };
+
+    struct Cache
+    {
+        Slot* head;
+        std::size_t count;
+        std::size_t capacity;
+        bool flushRegistered;
+    };
+
+    static constexpr std::size_t blockBytes()
+    {
+        return 64 * 1024;
+    }
+
+    static constexpr std::size_t cacheSize()
+    {
+        return SIPLASPLAS_REFLECTION_OBJECT_POOL_CACHE_SIZE;
+    }
+
+    static constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    class Shared
+    {
+    public:
+        // Pops a slot for the caller and moves up to half a cache
+        // of free slots to the thread cache
+        void* refill(Cache& cache)
+        {
+            std::lock_guard<std::mutex> guard{_mutex};
+
+            if(_free == nullptr)
+            {
+                grow();
+            }
+
+            Slot* result = _free;
+            _free = result->next;
+
+            while(_free != nullptr && cache.count < cache.capacity / 2)
+            {
+                Slot* slot = _free;
+                _free = slot->next;
+                slot->next = cache.head;
+                cache.head = slot;
+                ++cache.count;
+            }
+
+            return result;
+        }
+
+        // Gives back the slot plus half of the thread cache, so
+        // a thread that only frees does not take the lock per slot
+        void release(Cache& cache, Slot* slot)
+        {
+            slot->next = nullptr;
+            Slot* last = slot;
+
+            while(cache.count > cache.capacity / 2)
+            {
+                Slot* cached = cache.head;
+                cache.head = cached->next;
+                --cache.count;
+                cached->next = slot;
+                slot = cached;
+            }
+
+            std::lock_guard<std::mutex> guard{_mutex};
+            last->next = _free;
+            _free = slot;
+        }
+
+        void flush(Cache& cache)
+        {
+            // Further allocations from this thread go to the pool directly
+            cache.capacity = 0;
+
+            if(cache.head == nullptr)
+            {
+                return;
+            }
+
+            Slot* last = cache.head;
+
+            while(last->next != nullptr)
+            {
+                last = last->next;
+            }
+
+            std::lock_guard<std::mutex> guard{_mutex};
+            last->next = _free;
+            _free = cache.head;
+            cache.head = nullptr;
+            cache.count = 0;
+        }
+
+        void registerFlush(Cache& cache)
+        {
+            if(cache.capacity > 0 && !cache.flushRegistered)
+            {
+                cache.flushRegistered = true;
+                static thread_local Flush flush{*this, cache};
+                (void)flush;
+            }
+        }
+
+    private:
+        std::mutex _mutex;
+        Slot* _free = nullptr;
+        std::vector<std::unique_ptr<char[]>> _blocks;
+
+        void grow()
+        {
+            const std::size_t bytes = slotsPerBlock() * slotSize() + slotAlignment() - 1;
+            _blocks.emplace_back(new char[bytes]);
+
+            const auto address = reinterpret_cast<std::uintptr_t>(_blocks.back().get());
+            char* begin = _blocks.back().get() + (roundUp(address, slotAlignment()) - address);
+
+            for(std::size_t i = slotsPerBlock(); i > 0; --i)
+            {
+                Slot* slot = new(begin + (i - 1) * slotSize()) Slot;
+                slot->next = _free;
+                _free = slot;
+            }
+        }
+
+        // Returns the slots cached by a thread to the pool when the thread exits.
+        // The cache itself is trivially destructible, so deallocations done after
+        // this point (such as objects destroyed by other thread locals) still work
+        class Flush
+        {
+        public:
+            Flush(Shared& shared, Cache& cache) :
+                _shared(shared),
+                _cache(cache)
+            {}
+
+            ~Flush()
+            {
+                _shared.flush(_cache);
+            }
+
+        private:
+            Shared& _shared;
+            Cache& _cache;
+        };
+    };
+
+    static Shared& shared()
+    {
+        // Never destroyed, see class documentation
+        static Shared* shared = new Shared;
+        return *shared;
+    }
+
+    static Cache& threadCache()
+    {
+        static thread_local Cache cache{nullptr, 0, cacheSize(), false};
+
+        // Registered on first use, so threads that only free objects
+        // give their cached slots back too
+        if(!cache.flushRegistered)
+        {
+            shared().registerFlush(cache);
+        }
+
+        return cache;
+    }
+};
+
+}
+
+}
+
+}
+
+#endif // SIPLASPLAS_REFLECTION_DYNAMIC_DETAIL_OBJECTPOOL_HPP
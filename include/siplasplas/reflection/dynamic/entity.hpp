@@ -5,8 +5,10 @@
 #include "detail/runtime_forward.hpp"
 #include <siplasplas/reflection/dynamic/export.hpp>
 
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <unordered_set>
+#include <vector>
 
 namespace cpp
 {
@@ -22,8 +24,24 @@ namespace dynamic_reflection
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Entity : public std::enable_shared_from_this<Entity>
 {
 public:
+    /**
+     * \brief Index of an entity in the runtime it is registered in
+     */
+    using Id = std::uint32_t;
+
+    /**
+     * \brief Id of entities not registered in a runtime
+     */
+    static constexpr Id InvalidId = std::numeric_limits<Id>::max();
+
     virtual ~Entity() = default;
 
+    /**
+     * \brief Returns the id of the entity in its runtime, or InvalidId if
+     * the entity is not registered in a runtime (See Runtime::getEntity(Id))
+     */
+    Id id() const;
+
     /**
      * \brief Returns a reference to the parent entity
      * The behavior is undefined if the entity has no parent entity (See orphan())
@@ -95,7 +113,8 @@ public:
      * \brief Links the given entity as child of the entity
      *
      * This function links the given entity as a child entity of the entity object.
-     * At the same time, the given entity links this entity as its parent.
+     * At the same time, the given entity links this entity as its parent and is
+     * registered in the runtime of this entity.
      * The behavior is undefined if the given entity already has a parent (See orphan()).
      * If the entity object already has a child entity with the given entity full name,
      * the given entity is ignored
@@ -190,6 +209,20 @@ public:
      */
     std::vector<std::string> getChildrenNamesByKind(const SourceInfo::Kind& kind);
 
+    /**
+     * \brief Returns the ids of the child entities, in registration order
+     *
+     * Children can be accessed with Runtime::getEntity(Id) without any name lookup:
+     *
+     * ``` cpp
+     * for(Entity::Id id : entity.children())
+     * {
+     *     const auto& child = entity.runtime().getEntity(id);
+     * }
+     * ```
+     */
+    const std::vector<Id>& children() const;
+
     /**
      * \brief Returns the shared pointer holding the entity object
      */
@@ -214,10 +247,21 @@ protected:
     Entity(const SourceInfo& sourceInfo);
 
 private:
-    std::weak_ptr<Entity> _parent;
+    friend class Runtime;
+    friend class RuntimeSnapshot;
+
+    /**
+     * \brief Returns a copy of the entity, with the same id, parent, and children.
+     * Used by Runtime::freeze() to build snapshots that are not affected by later
+     * changes to the entity
+     */
+    virtual std::shared_ptr<Entity> clone() const = 0;
+
     Runtime* _runtime;
+    Id _id;
+    Id _parent;
     SourceInfo _sourceInfo;
-    std::unordered_set<std::string> _children;
+    std::vector<Id> _children;
 };
 
 }
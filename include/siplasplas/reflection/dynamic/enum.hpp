@@ -4,6 +4,7 @@
 #include "entity.hpp"
 #include <siplasplas/typeerasure/typeinfo.hpp>
 #include <siplasplas/typeerasure/simpleany.hpp>
+#include <siplasplas/constexpr/stringview.hpp>
 
 namespace cpp
 {
@@ -14,6 +15,11 @@ namespace dynamic_reflection
 /**
  * \ingroup dynamic-reflection
  * \brief Stores dynamic reflection information of an enumeration type
+ *
+ * Name and value lookups (fromString(), toString()) don't scan the constants:
+ * names are indexed by an open addressing hash table built when the entity is
+ * created, and values by a direct index table if the values are contiguous enough
+ * (The usual case), or by a sorted table otherwise.
  */
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Enum : public Entity
 {
@@ -98,17 +104,39 @@ public:
     /**
      * \brief Returns the enumeration value of the constant with the given name
      *
-     * \param name Enumeration constant name. The behavior is undefined if the enum has no
-     * constant with the given name
+     * \param name Enumeration constant name
+     *
+     * \throws std::domain_error If the enum has no constant with the given name
      */
-    std::int64_t fromString(const std::string& name) const;
+    std::int64_t fromString(const cpp::constexp::ConstStringView& name) const;
+
+    /**
+     * \brief Returns the enumeration value of the constant with the given name
+     *
+     * \param name Pointer to the constant name. Does not need to be null terminated
+     * \param length Length of the constant name
+     *
+     * \throws std::domain_error If the enum has no constant with the given name
+     */
+    std::int64_t fromString(const char* name, std::size_t length) const;
+
+    /**
+     * \brief Checks whether the enumeration has a constant with the given name
+     */
+    bool has(const cpp::constexp::ConstStringView& name) const;
+
+    /**
+     * \brief Checks whether the enumeration has a constant with the given value
+     */
+    bool has(std::int64_t value) const;
 
     /**
      * \brief Returns The name of the enumeration constant with the given value
      *
-     * \param value Enumeration constant value. The behavior is undefined if the enum has no
-     * constant with that value. If there are multiple constants with that value, the first
-     * is returned
+     * \param value Enumeration constant value. If there are multiple constants with that
+     * value, the first is returned
+     *
+     * \throws std::domain_error If the enum has no constant with the given value
      */
     const std::string& toString(std::int64_t value) const;
 
@@ -121,10 +149,30 @@ private:
         const std::vector<std::int64_t>& constantsValues
     );
 
+    static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFF;
+
+    std::shared_ptr<Entity> clone() const override;
+
     cpp::typeerasure::TypeInfo _type;
     cpp::typeerasure::TypeInfo _underlyingType;
     std::vector<std::string>  _names;
     std::vector<std::int64_t> _values;
+
+    // Open addressing (linear probing) table of constant indices, with a power
+    // of two size. Empty slots hold InvalidIndex
+    std::vector<std::uint32_t> _nameSlots;
+    std::vector<std::size_t>   _nameHashes;
+
+    // If _denseValues is not empty, _denseValues[value - _minValue] is the index of the
+    // first constant with that value (InvalidIndex if none). Else _sortedValues holds
+    // the (value, index) pairs sorted by value
+    std::int64_t _minValue;
+    std::vector<std::uint32_t> _denseValues;
+    std::vector<std::pair<std::int64_t, std::uint32_t>> _sortedValues;
+
+    void buildIndices();
+    std::size_t findName(const char* name, std::size_t length) const;
+    std::size_t findValue(std::int64_t value) const;
 };
 
 }
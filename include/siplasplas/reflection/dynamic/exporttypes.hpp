@@ -2,6 +2,8 @@
 #define SIPLASPLAS_REFLECTION_DYNAMIC_EXPORTTYPES_HPP
 
 #include "sourceinfo.hpp"
+#include "metadata.hpp"
+#include "field.hpp"
 #include <siplasplas/typeerasure/anystorage/fixedsize.hpp>
 #include <siplasplas/typeerasure/function.hpp>
 #include <siplasplas/reflection/static/api.hpp>
@@ -33,13 +35,35 @@ template<typename T>
 }
 
 using MethodPointer = cpp::typeerasure::Function32;
-using FieldPointer  = MethodPointer;
+using FieldPointer  = cpp::typeerasure::Field32;
+
+/**
+ * \brief Describes an exported member object (See FieldLoader)
+ */
+struct FieldDescriptor
+{
+    FieldPointer field;
+    const void* classTypeInfo;
+    const void* typeInfo;
+    std::size_t offset;
+};
+
+template<typename Class, typename T>
+FieldDescriptor fieldDescriptor(T Class::* member)
+{
+    return {
+        FieldPointer{member},
+        typeInfoRef<Class>(),
+        typeInfoRef<T>(),
+        ::cpp::dynamic_reflection::Field::offsetOf(member)
+    };
+}
 
 using EnumLoader      = void(*)(void* context, const void* sourceInfo, const void* typeInfo, const void* underlyingTypeInfo, std::size_t count, const char* names[], const std::int64_t values[]);
 using EnumValueLoader = void(*)(void* context, const void* sourceInfo, const char*, std::int64_t);
 using ClassLoader     = void(*)(void* context, const void* sourceInfo, const void* typeInfo);
 using MethodLoader    = void(*)(void* context, const void* sourceInfo, void* method);
-using FieldLoader     = void(*)(void* context, const void* sourceInfo, void* field);
+using FieldLoader     = void(*)(void* context, const void* sourceInfo, void* field); // field points to a FieldDescriptor
 
 template<typename T, std::size_t... Is>
 void loadEnumImpl(void* context, EnumLoader loadEnum, EnumValueLoader loadEnumValue, cpp::meta::index_sequence<Is...>)
@@ -102,9 +126,9 @@ void loadClass(
     ::cpp::foreach_type<typename Class::Fields>([=](auto type)
     {
         using Field = ::cpp::meta::type_t<decltype(type)>;
-        auto fieldPtr = FieldPointer(Field::get());
+        auto field = fieldDescriptor(Field::get());
 
-        loadField(context, sourceInfoRef<Field>(), &fieldPtr);
+        loadField(context, sourceInfoRef<Field>(), &field);
     });
 
     ::cpp::foreach_type<typename Class::Classes>([=](auto type)
@@ -171,6 +195,147 @@ std::enable_if_t<!std::is_enum<T>::value> loadType(
     );
 }
 
+/**
+ * \brief Loads a single entity of a library (See SIPLASPLAS_REFLECTION_DYNAMIC_LOADENTITY)
+ */
+using ExportedEntityLoader = void(*)(
+    void* context,
+    ClassLoader loadClass,
+    EnumLoader loadEnum,
+    EnumValueLoader loadEnumValue,
+    MethodLoader loadMethod,
+    FieldLoader loadField
+);
+
+/**
+ * \brief Metadata blob of the types exported by a library, with the loader of each
+ * entity in record order
+ */
+struct ExportedMetadata
+{
+    std::vector<std::uint32_t> blob;
+    std::vector<ExportedEntityLoader> loaders;
+};
+
+template<typename T>
+void loadClassEntity(void* context, ClassLoader loadClass, EnumLoader, EnumValueLoader, MethodLoader, FieldLoader)
+{
+    loadClass(context, sourceInfoRef<::cpp::static_reflection::Class<T>>(), typeInfoRef<T>());
+}
+
+template<typename Method>
+void loadMethodEntity(void* context, ClassLoader, EnumLoader, EnumValueLoader, MethodLoader loadMethod, FieldLoader)
+{
+    auto methodPtr = MethodPointer(Method::get());
+    loadMethod(context, sourceInfoRef<Method>(), &methodPtr);
+}
+
+template<typename Field>
+void loadFieldEntity(void* context, ClassLoader, EnumLoader, EnumValueLoader, MethodLoader, FieldLoader loadField)
+{
+    auto field = fieldDescriptor(Field::get());
+    loadField(context, sourceInfoRef<Field>(), &field);
+}
+
+template<typename T>
+void loadEnumEntity(void* context, ClassLoader, EnumLoader loadEnum, EnumValueLoader loadEnumValue, MethodLoader, FieldLoader)
+{
+    detail::loadEnum<T>(context, loadEnum, loadEnumValue);
+}
+
+inline void addMetadataEntity(
+    MetadataBuilder& builder,
+    std::vector<ExportedEntityLoader>& loaders,
+    const ::cpp::dynamic_reflection::SourceInfo& sourceInfo,
+    ExportedEntityLoader loader)
+{
+    builder.add(sourceInfo, loaders.size());
+    loaders.push_back(loader);
+}
+
+template<typename T>
+void addMetadataEnum(MetadataBuilder& builder, std::vector<ExportedEntityLoader>& loaders)
+{
+    addMetadataEntity(builder, loaders, *sourceInfoRef<::cpp::static_reflection::Enum<T>>(), &loadEnumEntity<T>);
+}
+
+template<typename T>
+void addMetadataClass(MetadataBuilder& builder, std::vector<ExportedEntityLoader>& loaders)
+{
+    using Class = ::cpp::static_reflection::Class<T>;
+
+    addMetadataEntity(builder, loaders, *sourceInfoRef<Class>(), &loadClassEntity<T>);
+
+    ::cpp::foreach_type<typename Class::Methods>([&](auto type)
+    {
+        using Method = ::cpp::meta::type_t<decltype(type)>;
+        addMetadataEntity(builder, loaders, *sourceInfoRef<Method>(), &loadMethodEntity<Method>);
+    });
+
+    ::cpp::foreach_type<typename Class::Fields>([&](auto type)
+    {
+        using Field = ::cpp::meta::type_t<decltype(type)>;
+        addMetadataEntity(builder, loaders, *sourceInfoRef<Field>(), &loadFieldEntity<Field>);
+    });
+
+    ::cpp::foreach_type<typename Class::Classes>([&](auto type)
+    {
+        using ClassInfo = ::cpp::meta::type_t<decltype(type)>;
+        detail::addMetadataClass<::cpp::meta::type_t<ClassInfo>>(builder, loaders);
+    });
+
+    ::cpp::foreach_type<typename Class::Enums>([&](auto type)
+    {
+        using EnumInfo = ::cpp::meta::type_t<decltype(type)>;
+        detail::addMetadataEnum<::cpp::meta::type_t<EnumInfo>>(builder, loaders);
+    });
+}
+
+template<typename T>
+std::enable_if_t<std::is_enum<T>::value> addMetadataType(MetadataBuilder& builder, std::vector<ExportedEntityLoader>& loaders)
+{
+    detail::addMetadataEnum<T>(builder, loaders);
+}
+
+template<typename T>
+std::enable_if_t<!std::is_enum<T>::value> addMetadataType(MetadataBuilder& builder, std::vector<ExportedEntityLoader>& loaders)
+{
+    detail::addMetadataClass<T>(builder, loaders);
+}
+
+/**
+ * \brief Returns the metadata of the given exported types. It's built once,
+ * the first time it's requested
+ */
+template<typename... Ts>
+const ExportedMetadata& exportedMetadata()
+{
+    static const ExportedMetadata metadata = []
+    {
+        MetadataBuilder builder;
+        std::vector<ExportedEntityLoader> loaders;
+
+        ::cpp::foreach_type<Ts...>([&](auto type)
+        {
+            detail::addMetadataType<::cpp::meta::type_t<decltype(type)>>(builder, loaders);
+        });
+
+        ExportedMetadata result;
+        std::vector<std::size_t> keys;
+        result.blob = builder.build(keys);
+        result.loaders.reserve(keys.size());
+
+        for(std::size_t key : keys)
+        {
+            result.loaders.push_back(loaders[key]);
+        }
+
+        return result;
+    }();
+
+    return metadata;
+}
+
 template<typename... Ts>
 void loadTypes(
     void* context,
@@ -209,6 +374,11 @@ void loadTypes(
  * loaded at runtime and uses this exported C API to load type information
  * into a cpp::dynamic_reflection::Runtime object.
  *
+ * Besides the function loading all the types at once, the macro defines a function
+ * returning a metadata blob of the exported entities (See cpp::dynamic_reflection::Metadata)
+ * and a function loading a single entity given its index in the blob, so runtime loaders
+ * can create the entities on demand.
+ *
  * \param Variadic pack of types to export
  */
 #define SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT_TYPES(...)               \
@@ -229,8 +399,51 @@ extern "C" void SIPLASPLAS_REFLECTION_DYNAMIC_LOADTYPES(              \
         loadMethod,                                                   \
         loadField                                                     \
     );                                                                \
+}                                                                     \
+                                                                      \
+extern "C" const void* SIPLASPLAS_REFLECTION_DYNAMIC_METADATA(        \
+    std::size_t* size                                                 \
+)                                                                     \
+{                                                                     \
+    const auto& metadata =                                            \
+        ::cpp::dynamic_reflection::detail::exportedMetadata<__VA_ARGS__>(); \
+    *size = metadata.blob.size() * sizeof(std::uint32_t);             \
+    return metadata.blob.data();                                      \
+}                                                                     \
+                                                                      \
+extern "C" void SIPLASPLAS_REFLECTION_DYNAMIC_LOADENTITY(             \
+    std::uint32_t index,                                              \
+    void* context,                                                    \
+    ::cpp::dynamic_reflection::detail::ClassLoader loadClass,         \
+    ::cpp::dynamic_reflection::detail::EnumLoader loadEnum,           \
+    ::cpp::dynamic_reflection::detail::EnumValueLoader loadEnumValue, \
+    ::cpp::dynamic_reflection::detail::MethodLoader loadMethod,       \
+    ::cpp::dynamic_reflection::detail::FieldLoader loadField          \
+)                                                                     \
+{                                                                     \
+    ::cpp::dynamic_reflection::detail::exportedMetadata<__VA_ARGS__>() \
+        .loaders[index](                                              \
+            context,                                                  \
+            loadClass,                                                \
+            loadEnum,                                                 \
+            loadEnumValue,                                            \
+            loadMethod,                                               \
+            loadField                                                 \
+        );                                                            \
 }
 
+using MetadataGetter = const void*(*)(std::size_t*);
+
+using EntityLoader = void(*)(
+    std::uint32_t,
+    void*,
+    ::cpp::dynamic_reflection::detail::ClassLoader,
+    ::cpp::dynamic_reflection::detail::EnumLoader,
+    ::cpp::dynamic_reflection::detail::EnumValueLoader,
+    ::cpp::dynamic_reflection::detail::MethodLoader,
+    ::cpp::dynamic_reflection::detail::FieldLoader
+);
+
 using TypeLoader = void(*)(
     void*,
     ::cpp::dynamic_reflection::detail::ClassLoader,
@@ -5,10 +5,12 @@
 #include <siplasplas/typeerasure/field.hpp>
 #include <siplasplas/typeerasure/simpleany.hpp>
 #include <siplasplas/typeerasure/any.hpp>
+#include <siplasplas/typeerasure/typeinfo.hpp>
 
 #include <type_traits>
 #include <string>
 #include <cstddef>
+#include <limits>
 
 namespace cpp
 {
@@ -19,19 +21,74 @@ namespace dynamic_reflection
 /**
  * \ingroup dynamic-reflection
  * \brief Stores dynamic reflection information of a member object
+ *
+ * Members of standard layout classes are accessed by byte offset: reading or
+ * writing the member of an object through address(), value() or gather() is
+ * pointer arithmetic on the object address, with no type-erased invocation.
+ * Members of other classes (whose offset is not well defined) are accessed
+ * through the stored member object pointer (See getField()).
  */
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Field : public Entity
 {
 public:
+    /**
+     * \brief Offset of fields that must be accessed through the member object pointer
+     */
+    static constexpr std::size_t NoOffset = std::numeric_limits<std::size_t>::max();
+
     /**
      * \brief Instances a field entity given its source information and a member object pointer
      *
      * \param sourceInfo Field source information
      * \param field Type erased member object pointer. Must be non-empty.
+     * \param classTypeInfo Type information of the class the member belongs to
+     * \param typeInfo Type information of the member
+     * \param offset Offset in bytes of the member from the beginning of the object,
+     * or NoOffset if the member must be accessed through the member pointer (See offsetOf())
+     *
+     * \returns A shared pointer holding the field entity
+     */
+    static std::shared_ptr<Field> create(
+        const SourceInfo& sourceInfo,
+        const cpp::typeerasure::Field32& field,
+        const cpp::typeerasure::TypeInfo& classTypeInfo,
+        const cpp::typeerasure::TypeInfo& typeInfo,
+        std::size_t offset = NoOffset
+    );
+
+    /**
+     * \brief Instances a field entity given its source information and a member object pointer
+     *
+     * The member type information and offset are taken from the member object pointer
+     *
+     * \param sourceInfo Field source information
+     * \param member Member object pointer
      *
      * \returns A shared pointer holding the field entity
      */
-    static std::shared_ptr<Field> create(const SourceInfo& sourceInfo, const cpp::typeerasure::Field32& field);
+    template<typename Class, typename T>
+    static std::shared_ptr<Field> create(const SourceInfo& sourceInfo, T Class::* member)
+    {
+        return create(
+            sourceInfo,
+            cpp::typeerasure::Field32{member},
+            cpp::typeerasure::TypeInfo::get<Class>(),
+            cpp::typeerasure::TypeInfo::get<T>(),
+            offsetOf(member)
+        );
+    }
+
+    /**
+     * \brief Returns the offset in bytes of a member from the beginning of its
+     * class, or NoOffset if the class is not standard layout
+     *
+     * This is `offsetof()` for member object pointers
+     */
+    template<typename Class, typename T>
+    static std::size_t offsetOf(T Class::* member)
+    {
+        return offsetOf(member, std::is_standard_layout<Class>());
+    }
 
     /**
      * \brief Returns a reference to a field entity from a pointer to an entity
@@ -79,10 +136,159 @@ public:
         return _field.getAs<T>(std::forward<Object>(object));
     }
 
+    /**
+     * \brief Checks whether the member is accessed by offset (See offset())
+     */
+    bool hasOffset() const;
+
+    /**
+     * \brief Returns the offset in bytes of the member from the beginning of
+     * the object, NoOffset if the member is not accessed by offset
+     */
+    std::size_t offset() const;
+
+    /**
+     * \brief Returns type information of the member
+     */
+    const cpp::typeerasure::TypeInfo& typeInfo() const;
+
+    /**
+     * \brief Returns type information of the class the member belongs to
+     */
+    const cpp::typeerasure::TypeInfo& classTypeInfo() const;
+
+    /**
+     * \brief Returns the address of the member object of the given object
+     *
+     * \param object Pointer to an object of the class type (See classTypeInfo())
+     */
+    void* address(void* object) const;
+
+    /**
+     * \brief Returns the address of the member object of the given object
+     *
+     * \param object Pointer to an object of the class type (See classTypeInfo())
+     */
+    const void* address(const void* object) const;
+
+    /**
+     * \brief Returns a reference to the member object of the given object
+     *
+     * \tparam T Type of the member. The behavior is undefined if it's not
+     * the type of the member (See typeInfo())
+     * \param object Pointer to an object of the class type
+     */
+    template<typename T>
+    T& value(void* object) const
+    {
+        return *static_cast<T*>(address(object));
+    }
+
+    /**
+     * \brief Returns a reference to the member object of the given object
+     *
+     * \tparam T Type of the member. The behavior is undefined if it's not
+     * the type of the member (See typeInfo())
+     * \param object Pointer to an object of the class type
+     */
+    template<typename T>
+    const T& value(const void* object) const
+    {
+        return *static_cast<const T*>(address(object));
+    }
+
+    /**
+     * \brief Assigns the member object of the given object
+     *
+     * \param object Pointer to an object of the class type
+     * \param value Pointer to the value to copy assign, of the member type
+     */
+    void set(void* object, const void* value) const;
+
+    /**
+     * \brief Reads the member object of many objects into a contiguous array
+     *
+     * ``` cpp
+     * std::vector<Point> points = ...;
+     * std::vector<float> xs(points.size());
+     * field.gather(points.data(), points.size(), sizeof(Point), xs.data());
+     * ```
+     *
+     * \tparam T Type of the member. The behavior is undefined if it's not
+     * the type of the member (See typeInfo())
+     * \param objects Pointer to the first object
+     * \param count Number of objects
+     * \param stride Distance in bytes between consecutive objects
+     * \param out Array of \p count values, which are copy assigned
+     */
+    template<typename T>
+    void gather(const void* objects, std::size_t count, std::size_t stride, T* out) const
+    {
+        const auto* object = static_cast<const char*>(objects);
+
+        if(hasOffset())
+        {
+            object += _offset;
+
+            for(std::size_t i = 0; i < count; ++i, object += stride)
+            {
+                out[i] = *reinterpret_cast<const T*>(object);
+            }
+        }
+        else
+        {
+            for(std::size_t i = 0; i < count; ++i, object += stride)
+            {
+                out[i] = value<T>(static_cast<const void*>(object));
+            }
+        }
+    }
+
+    /**
+     * \brief Reads the member object of many objects into a contiguous array
+     *
+     * \param objects Pointer to the first object
+     * \param count Number of objects
+     * \param stride Distance in bytes between consecutive objects
+     * \param out Uninitialized storage for \p count values of the member type,
+     * where the values are copy constructed
+     */
+    void gather(const void* objects, std::size_t count, std::size_t stride, void* out) const;
+
 private:
-    Field(const SourceInfo& sourceInfo, const cpp::typeerasure::Field32& field);
+    Field(
+        const SourceInfo& sourceInfo,
+        const cpp::typeerasure::Field32& field,
+        const cpp::typeerasure::TypeInfo& classTypeInfo,
+        const cpp::typeerasure::TypeInfo& typeInfo,
+        std::size_t offset
+    );
+
+    std::shared_ptr<Entity> clone() const override;
 
     cpp::typeerasure::Field32 _field;
+    cpp::typeerasure::TypeInfo _classTypeInfo;
+    cpp::typeerasure::TypeInfo _typeInfo;
+    std::size_t _offset;
+
+    template<typename Class, typename T>
+    static std::size_t offsetOf(T Class::* member, std::true_type)
+    {
+        // offsetof() can't take a member pointer. The object is
+        // never constructed, only addresses are computed
+        std::aligned_storage_t<sizeof(Class), alignof(Class)> storage;
+        const auto* object = reinterpret_cast<const Class*>(&storage);
+
+        return static_cast<std::size_t>(
+            reinterpret_cast<const char*>(&(object->*member)) - reinterpret_cast<const char*>(object)
+        );
+    }
+
+    template<typename Class, typename T>
+    static std::size_t offsetOf(T Class::*, std::false_type)
+    {
+        return NoOffset;
+    }
 };
 
 }
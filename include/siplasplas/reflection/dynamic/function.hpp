@@ -35,6 +35,16 @@ public:
         return _functionPointer(std::forward<Args>(args)...);
     }
 
+    /**
+     * \brief Invokes the function once per element of the given argument columns
+     *
+     * See cpp::typeerasure::Function::invokeBatch()
+     *
+     * \param columns Argument columns, one per function parameter
+     * \param results Optional vector to append the return values to
+     */
+    void invokeBatch(std::vector<cpp::AnyVector>& columns, cpp::AnyVector* results = nullptr) const;
+
     /**
      * \brief Returns a pointer to the function
      */
@@ -66,6 +76,8 @@ public:
 private:
     Function(const SourceInfo& sourceInfo, const cpp::typeerasure::Function32& function);
 
+    std::shared_ptr<Entity> clone() const override;
+
     cpp::typeerasure::Function32 _functionPointer;
 };
 
@@ -0,0 +1,205 @@
+#ifndef SIPLASPLAS_REFLECTION_DYNAMIC_METADATA_HPP
+#define SIPLASPLAS_REFLECTION_DYNAMIC_METADATA_HPP
+
+#include "sourceinfo.hpp"
+#include <siplasplas/reflection/dynamic/export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cpp
+{
+
+namespace dynamic_reflection
+{
+
+namespace detail
+{
+
+/**
+ * \brief Header of a dynamic reflection metadata blob
+ */
+struct MetadataHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t entityCount;
+    std::uint32_t stringPoolSize;
+};
+
+/**
+ * \brief Entity record of a dynamic reflection metadata blob
+ *
+ * Records reference their names and relatives by offset/index only, so
+ * the blob can be placed (or mapped) at any address.
+ */
+struct MetadataRecord
+{
+    std::uint32_t fullName;       // Offset of the full name in the string pool
+    std::uint32_t fullNameLength;
+    std::uint32_t parent;         // Index of the parent record, Metadata::InvalidIndex if it has none
+    std::uint32_t firstChild;     // Index of the first child record. Children are contiguous
+    std::uint32_t childCount;
+    std::uint32_t kind;           // cpp::dynamic_reflection::Kind
+};
+
+}
+
+/**
+ * \ingroup dynamic-reflection
+ * \brief Read-only view of a dynamic reflection metadata blob
+ *
+ * A metadata blob describes the entities exported by a library (See
+ * SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT_TYPES()) without any pointer, so it can
+ * be used in place from the library image or from a memory mapped file. The blob
+ * is laid out as:
+ *
+ *  - A detail::MetadataHeader.
+ *  - The entity records, in tree order: the children of each entity are contiguous.
+ *  - The record indices sorted by full name, for lookups by name.
+ *  - The string pool with the full names of the entities.
+ *
+ * Metadata does not own the blob, the blob must outlive the view.
+ */
+class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Metadata
+{
+public:
+    using Index = std::uint32_t;
+
+    static constexpr Index InvalidIndex = 0xFFFFFFFF;
+    static constexpr std::uint32_t Magic = 0x4D525043; // "CPRM"
+    static constexpr std::uint32_t Version = 1;
+
+    /**
+     * \brief Initializes an empty metadata view
+     */
+    Metadata();
+
+    /**
+     * \brief Initializes a view of the given metadata blob
+     *
+     * \param blob Pointer to the beginning of the blob. Must be aligned at least
+     * as an std::uint32_t
+     * \param size Size in bytes of the blob
+     *
+     * \throws std::runtime_error If the blob is not a valid metadata blob
+     */
+    Metadata(const void* blob, std::size_t size);
+
+    /**
+     * \brief Returns the number of entities described by the blob
+     */
+    std::size_t count() const;
+
+    /**
+     * \brief Checks whether the view references no blob or an empty one
+     */
+    bool empty() const;
+
+    /**
+     * \brief Returns the index of the entity with the given full name, InvalidIndex
+     * if there's no such entity. No string is built for the lookup
+     */
+    Index find(const char* fullName, std::size_t length) const;
+
+    /**
+     * \brief Returns the index of the entity with the given full name, InvalidIndex
+     * if there's no such entity
+     */
+    Index find(const std::string& fullName) const;
+
+    /**
+     * \brief Returns the full name of the given entity. The returned string is not
+     * null terminated (See fullNameLength())
+     */
+    const char* fullName(Index index) const;
+
+    /**
+     * \brief Returns the length of the full name of the given entity
+     */
+    std::size_t fullNameLength(Index index) const;
+
+    /**
+     * \brief Returns the kind of the given entity
+     */
+    Kind kind(Index index) const;
+
+    /**
+     * \brief Returns the index of the parent entity of the given entity, InvalidIndex
+     * if the entity is declared at global scope or its parent is not in the blob
+     */
+    Index parent(Index index) const;
+
+    /**
+     * \brief Returns the index of the first child entity of the given entity.
+     * Children indices go from firstChild() to firstChild() + childCount()
+     */
+    Index firstChild(Index index) const;
+
+    /**
+     * \brief Returns the number of child entities of the given entity
+     */
+    std::size_t childCount(Index index) const;
+
+private:
+    const detail::MetadataHeader* _header;
+    const detail::MetadataRecord* _records;
+    const Index* _byName;
+    const char* _strings;
+
+    const detail::MetadataRecord& record(Index index) const;
+};
+
+namespace detail
+{
+
+/**
+ * \brief Builds a metadata blob from the source information of a set of entities
+ *
+ * Entities can be added in any order. Entities whose parent entity is not
+ * added are stored as global scope entities (Their parent index is
+ * Metadata::InvalidIndex).
+ */
+class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT MetadataBuilder
+{
+public:
+    /**
+     * \brief Adds an entity
+     *
+     * \param sourceInfo Source information of the entity
+     * \param key User value associated to the entity (See build())
+     */
+    void add(const SourceInfo& sourceInfo, std::size_t key);
+
+    /**
+     * \brief Builds the blob
+     *
+     * \param keys Filled with the keys of the added entities, in record
+     * order: `keys[i]` is the key of the i-th record of the blob
+     *
+     * \returns The blob, stored in std::uint32_t units so it's suitably aligned
+     * for Metadata
+     */
+    std::vector<std::uint32_t> build(std::vector<std::size_t>& keys) const;
+
+private:
+    struct Entry
+    {
+        std::string fullName;
+        std::string parentFullName;
+        Kind kind;
+        std::size_t key;
+    };
+
+    std::vector<Entry> _entries;
+};
+
+}
+
+}
+
+}
+
+#endif // SIPLASPLAS_REFLECTION_DYNAMIC_METADATA_HPP
@@ -76,6 +76,8 @@ public:
 
 private:
     Namespace(const SourceInfo& sourceInfo);
+
+    std::shared_ptr<Entity> clone() const override;
 };
 
 }
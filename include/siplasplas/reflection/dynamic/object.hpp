@@ -5,18 +5,36 @@
 
 #include <memory>
 #include <cassert>
+#include <cstddef>
 #include <type_traits>
 
+/**
+ * \brief Size in bytes of the buffer used by cpp::dynamic_reflection::Object
+ * to store small values without allocating them
+ */
+#ifndef SIPLASPLAS_REFLECTION_OBJECT_INLINE_STORAGE_SIZE
+#define SIPLASPLAS_REFLECTION_OBJECT_INLINE_STORAGE_SIZE (4 * sizeof(void*))
+#endif // SIPLASPLAS_REFLECTION_OBJECT_INLINE_STORAGE_SIZE
+
 namespace cpp
 {
 
 namespace dynamic_reflection
 {
 
+/**
+ * \brief Type erased value, reference, or pointer
+ *
+ * Values whose size and alignment fit in the object inline buffer
+ * (see SIPLASPLAS_REFLECTION_OBJECT_INLINE_STORAGE_SIZE) and that are nothrow
+ * move constructible are stored inline, so no allocation is done to create,
+ * copy, or move them. Bigger values are allocated by their type.
+ */
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Object
 {
 public:
     static constexpr bool ConstructReference = true;
+    static constexpr std::size_t InlineStorageSize = SIPLASPLAS_REFLECTION_OBJECT_INLINE_STORAGE_SIZE;
 
     enum class Kind
     {
@@ -36,7 +54,7 @@ public:
     Object(T&& value) :
         _type{cpp::dynamic_reflection::Type::get<std::decay_t<T>>()},
         _kind{Kind::VALUE},
-        _object{_type.copy_construct(&value)}
+        _object{copyValue(&value)}
     {}
     template<typename T>
     Object(const T* pointer) :
@@ -81,10 +99,28 @@ public:
     std::string toString() const;
     static Object fromString(const std::string& typeName, const std::string& value);
 
+    /**
+     * \brief Checks whether values of the given type are stored inline
+     */
+    static bool storedInline(const cpp::dynamic_reflection::Type& type);
+
+    /**
+     * \brief Checks whether the object value is stored in the object inline buffer
+     */
+    bool isInline() const;
+
 private:
     cpp::dynamic_reflection::Type _type;
     Kind _kind;
     void* _object;
+    std::aligned_storage_t<InlineStorageSize, alignof(std::max_align_t)> _storage;
+
+    // Returns the inline buffer if a value of the current
+    // type fits there, nullptr if it must be allocated
+    void* inlineStorage();
+    void* constructValue();
+    void* copyValue(const void* value);
+    void* moveValue(void* value);
 
     void destroy();
 };
@@ -3,15 +3,138 @@
 
 #include "namespace.hpp"
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace cpp
 {
 
 namespace dynamic_reflection
 {
 
+/**
+ * \ingroup dynamic-reflection
+ * \brief Immutable copy of the entity tables of a runtime
+ *
+ * A snapshot is built with Runtime::freeze() and never changes after that, so
+ * any number of threads can query it concurrently without locking, even while the
+ * runtime is being modified. The snapshot owns copies of the runtime entities, so
+ * it is not affected by entities registered in the runtime after the snapshot was
+ * taken, nor by clearing the runtime.
+ *
+ * The copies are detached from the runtime: navigate the entity tree with the
+ * snapshot (See findChild() and children()) instead of with the Entity interface
+ * (Entity::parent(), Entity::getChildByName(), etc), which needs a runtime.
+ *
+ * Snapshots never load entities on demand: load everything the readers need
+ * before freezing (See RuntimeLoader::loadAll()).
+ */
+class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT RuntimeSnapshot
+{
+public:
+    /**
+     * \brief Returns the name of the runtime the snapshot was taken from
+     */
+    const std::string& name() const;
+
+    /**
+     * \brief Returns the number of entities in the snapshot
+     */
+    std::size_t entityCount() const;
+
+    /**
+     * \brief Returns the entity with the given id
+     *
+     * \param id Entity id. The behavior is undefined if id >= entityCount()
+     */
+    const Entity& getEntity(Entity::Id id) const;
+
+    /**
+     * \brief Returns the entity with the given id
+     *
+     * \tparam EntityType Entity type (cpp::dynamic_reflection::Class,
+     * cpp::dynamic_reflection::Enum, etc). Throws if the type doesn't match the
+     * entity kind
+     */
+    template<typename EntityType>
+    const EntityType& getEntity(Entity::Id id) const
+    {
+        return EntityType::fromEntity(_entities[id]);
+    }
+
+    /**
+     * \brief Returns the id of the entity with the given full name, or
+     * Entity::InvalidId if there's no such entity
+     */
+    Entity::Id getEntityId(const std::string& fullName) const;
+
+    /**
+     * \brief Returns the entity with the given full name, nullptr if there's
+     * no such entity
+     */
+    const Entity* findEntity(const std::string& fullName) const;
+
+    /**
+     * \brief Returns the child entity of the given entity with the given name
+     *
+     * \param parent Id of the parent entity
+     * \param name Name (not full name) of the child entity
+     * \param length Length of the name
+     *
+     * \returns A pointer to the child entity, nullptr if there's no such child
+     */
+    const Entity* findChild(Entity::Id parent, const char* name, std::size_t length) const;
+
+    /**
+     * \brief Returns the child entity of the given entity with the given name,
+     * nullptr if there's no such child
+     */
+    const Entity* findChild(Entity::Id parent, const std::string& name) const;
+
+    /**
+     * \brief Returns the ids of the children of the given entity when the
+     * snapshot was taken
+     */
+    const std::vector<Entity::Id>& children(Entity::Id id) const;
+
+    /**
+     * \brief Returns the ids of the entities of a given kind, in registration order
+     */
+    const std::vector<Entity::Id>& getEntitiesByKind(const SourceInfo::Kind& kind) const;
+
+private:
+    friend class Runtime;
+
+    RuntimeSnapshot() = default;
+
+    std::string _name;
+    std::vector<std::shared_ptr<Entity>> _entities;
+    std::unordered_map<std::string, Entity::Id> _ids;
+    std::unordered_multimap<std::uint64_t, Entity::Id> _childrenByName;
+    std::array<std::vector<Entity::Id>, static_cast<std::size_t>(SourceInfo::Kind::UNKNOWN) + 1> _entitiesByKind;
+};
+
 /**
  * \ingroup dynamic-reflection
  * \brief Provides access to dynamic type and function information at runtime
+ *
+ * Entities are stored in a contiguous table indexed by entity id (See Entity::id()),
+ * with one array of ids per entity kind. Full names and (parent, name) pairs are
+ * indexed once at registration, so navigating the entity tree by name or by id
+ * does not build any string.
+ *
+ * Entities can also be registered on demand: if an entity loader is set (See
+ * setEntityLoader()), lookups by name of entities not registered yet ask the
+ * loader for them before failing.
+ *
+ * The runtime is not synchronized. To share reflection information with other
+ * threads, register the entities from one thread and publish a frozen snapshot
+ * of the runtime (See publish() and snapshot()). Readers work with the snapshot
+ * they got while the runtime is updated and a new snapshot published.
  */
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT Runtime
 {
@@ -28,7 +151,15 @@ public:
     Runtime(const std::string& name);
 
     /**
-     * \brief Clears registered type information
+     * \brief Function registering an entity on demand
+     *
+     * Takes the full name of the requested entity, and returns whether an entity
+     * with that name was registered in the runtime.
+     */
+    using EntityLoader = std::function<bool(const std::string& fullName)>;
+
+    /**
+     * \brief Clears registered type information and the entity loader
      */
     void clear();
 
@@ -59,12 +190,21 @@ public:
     /**
      * \brief Checks if an enity is registered with the given name
      *
+     * If the entity is not registered yet, the entity loader is asked
+     * for it (See setEntityLoader())
+     *
      * \param fullName Entity full qualified name
      *
-     * \returns True if the runtime has an entity registered with the given
+     * \returns True if the runtime has (or could load) an entity with the given
      * full name. False instead
      */
-    bool hasEntity(const std::string& fullName) const;
+    bool hasEntity(const std::string& fullName);
+
+    /**
+     * \brief Checks if an entity with the given name is already registered,
+     * without asking the entity loader
+     */
+    bool hasLoadedEntity(const std::string& fullName) const;
 
     /**
      * \brief Returns a reference to the specified entity
@@ -94,6 +234,99 @@ public:
         return EntityType::fromEntity(getEntity(fullName).pointer());
     }
 
+    /**
+     * \brief Returns a reference to the entity with the given id
+     *
+     * \param id Entity id. The behavior is undefined if there's no entity
+     * registered with that id (See Entity::id())
+     */
+    Entity& getEntity(Entity::Id id);
+
+    /**
+     * \brief Returns the id of the entity with the given full name, or
+     * Entity::InvalidId if there's no such entity
+     *
+     * If the entity is not registered yet, the entity loader is asked
+     * for it (See setEntityLoader())
+     */
+    Entity::Id getEntityId(const std::string& fullName);
+
+    /**
+     * \brief Returns the id of the already registered entity with the given full
+     * name, or Entity::InvalidId if there's no such entity. The entity loader is
+     * not asked
+     */
+    Entity::Id getLoadedEntityId(const std::string& fullName) const;
+
+    /**
+     * \brief Returns the child entity of the given entity with the given name
+     *
+     * \param parent Id of the parent entity
+     * \param name Name (not full name) of the child entity. No string is built for
+     * the lookup
+     * \param length Length of the name
+     *
+     * \returns A pointer to the child entity, nullptr if there's no such child
+     */
+    Entity* findChild(Entity::Id parent, const char* name, std::size_t length);
+
+    /**
+     * \brief Returns the child entity of the given entity with the given name,
+     * nullptr if there's no such child
+     */
+    Entity* findChild(Entity::Id parent, const std::string& name);
+
+    /**
+     * \brief Returns the ids of the registered entities of a given kind,
+     * in registration order
+     */
+    const std::vector<Entity::Id>& getEntitiesByKind(const SourceInfo::Kind& kind) const;
+
+    /**
+     * \brief Returns the number of registered entities
+     */
+    std::size_t entityCount() const;
+
+    /**
+     * \brief Sets the function used to register entities on demand
+     *
+     * getEntity(), getEntityId(), hasEntity(), namespace_() and the child lookups
+     * of entities (See Entity::getChildByName()) invoke the loader when the requested
+     * entity is not registered. Use hasLoadedEntity() and getLoadedEntityId() to
+     * query the registered entities only. Enumerations of entities (Such as getEntitiesByKind()
+     * or Entity::children()) only see the entities registered so far.
+     *
+     * \param loader Entity loader. Can be empty, to disable loading on demand
+     */
+    void setEntityLoader(EntityLoader loader);
+
+    /**
+     * \brief Returns an immutable snapshot of the registered entities
+     *
+     * The entities are copied into the snapshot, so the runtime can be modified
+     * after freezing it and the changes are not visible through the snapshot.
+     * See RuntimeSnapshot
+     */
+    std::shared_ptr<const RuntimeSnapshot> freeze() const;
+
+    /**
+     * \brief Freezes the runtime and publishes the snapshot
+     *
+     * The published snapshot is replaced atomically: threads calling snapshot()
+     * concurrently get either the previous snapshot or the new one. Readers holding
+     * the previous snapshot can keep using it until they release it.
+     */
+    void publish();
+
+    /**
+     * \brief Returns the last published snapshot, nullptr if no snapshot
+     * was published yet
+     *
+     * Can be called concurrently with publish() and with any modification of the
+     * runtime. Clearing the runtime does not unpublish the snapshot.
+     */
+    std::shared_ptr<const RuntimeSnapshot> snapshot() const;
+
     /**
      * \brief Registers an entity in the dynamic reflection runtime
      *
@@ -111,8 +344,23 @@ public:
     const std::string& name() const;
 
 private:
+    friend class Entity;
+
     std::string _name;
-    std::unordered_map<std::string, std::shared_ptr<Entity>> _entities;
+    std::vector<std::shared_ptr<Entity>> _entities;
+    std::unordered_map<std::string, Entity::Id> _ids;
+    std::unordered_multimap<std::uint64_t, Entity::Id> _childrenByName;
+    std::array<std::vector<Entity::Id>, static_cast<std::size_t>(SourceInfo::Kind::UNKNOWN) + 1> _entitiesByKind;
+    EntityLoader _entityLoader;
+    std::shared_ptr<const RuntimeSnapshot> _snapshot; // Accessed with std::atomic_load/store only
+
+    // Returns the id of the entity, loading it if it's not registered
+    // yet. Returns Entity::InvalidId if there's no such entity
+    Entity::Id lookup(const std::string& fullName);
+
+    // Assigns an id to an entity already linked to its parent and
+    // indexes it by name and kind
+    void registerEntity(const std::shared_ptr<Entity>& entity);
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include <siplasplas/reflection/dynamic/export.hpp>
 #include <siplasplas/reflection/dynamic/runtime.hpp>
+#include <siplasplas/reflection/dynamic/metadata.hpp>
 #include <siplasplas/utility/dynamiclibrary.hpp>
 #include <siplasplas/variant/optional.hpp>
 
@@ -15,6 +16,15 @@ namespace dynamic_reflection
 /**
  * \ingroup dynamic-reflection
  * \brief Loads dynamic reflection information from an external library
+ *
+ * If the library exports a metadata blob (See SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT_TYPES())
+ * the library entities are not loaded upfront: the loader reads the blob in place and
+ * registers each entity in the runtime the first time it's looked up by name (See
+ * Runtime::setEntityLoader()). Loading a class loads its member functions and objects too.
+ * Libraries without metadata are loaded eagerly.
+ *
+ * The runtime entity loader references the runtime loader, so runtime loaders
+ * cannot be copied nor moved.
  */
 class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT RuntimeLoader
 {
@@ -37,6 +47,11 @@ public:
      */
     RuntimeLoader(const cpp::DynamicLibrary& library);
 
+    RuntimeLoader(const RuntimeLoader&) = delete;
+    RuntimeLoader(RuntimeLoader&&) = delete;
+    RuntimeLoader& operator=(const RuntimeLoader&) = delete;
+    RuntimeLoader& operator=(RuntimeLoader&&) = delete;
+
     /**
      * \brief Loads reflection information from the given external library
      *
@@ -48,10 +63,27 @@ public:
      *  The behavior is undefined if the library has no type export function
      *  See SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT_TYPES() macro.
      *
+     *  If the library exports a metadata blob, entities are registered on demand
+     *  instead (See class documentation).
+     *
      * \param library External library to load reflection information from
      */
     void load(const cpp::DynamicLibrary& library);
 
+    /**
+     * \brief Registers all the library entities not loaded yet in the runtime
+     *
+     * Use it before enumerating the runtime entities (Such as with
+     * Runtime::getEntitiesByKind()) when the library is loaded on demand
+     */
+    void loadAll();
+
+    /**
+     * \brief Returns the metadata of the loaded library. Empty if the library
+     * does not export metadata
+     */
+    const Metadata& metadata() const;
+
     /**
      * \brief Returns a reference to the loaded runtime
      */
@@ -60,8 +92,12 @@ public:
 private:
     Optional<cpp::DynamicLibrary> _library;
     cpp::dynamic_reflection::Runtime _runtime;
+    Metadata _metadata;
+    std::vector<bool> _loaded;
 
     cpp::DynamicLibrary::Symbol& getRuntimeLoader();
+    bool loadEntity(const std::string& fullName);
+    void loadEntity(Metadata::Index index);
 };
 
 }
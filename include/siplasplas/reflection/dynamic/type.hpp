@@ -2,15 +2,17 @@
 #define SIPLASPLAS_REFLECTION_DYNAMIC_TYPE_HPP
 
 #include <siplasplas/reflection/common/type_info.hpp>
-#include <siplasplas/allocator/freelist_allocator.hpp>
 #include <siplasplas/utility/exception.hpp>
 #include <siplasplas/utility/lexical_cast.hpp>
 #include <siplasplas/utility/meta.hpp>
+#include <siplasplas/utility/typenameindex.hpp>
+#include <siplasplas/constexpr/stringview.hpp>
 #include <siplasplas/reflection/dynamic/export.hpp>
+#include <siplasplas/reflection/dynamic/detail/objectpool.hpp>
 
-#include <unordered_map>
+#include <cstdint>
+#include <cstring>
 #include <vector>
-#include <algorithm>
 
 namespace cpp
 {
@@ -23,21 +25,21 @@ namespace detail
     template<typename T>
     struct CustomTypeName
     {
-        static constexpr ctti::unnamed_type_id_t id()
+        static constexpr ctti::detail::cstring name()
         {
-            return ctti::unnamed_type_id<T>();
+            return ctti::type_id<T>().name();
         }
     };
 
-#define CPP_REFLECTION_CUSTOM_TYPENAME_FOR(type, name)  \
-    namespace cpp { namespace detail {                  \
-    template<>                                          \
-    struct CustomTypeName<type> {                       \
-        static constexpr ::ctti::unnamed_type_id_t id() \
-        {                                               \
-            return ::ctti::id_from_name(name);          \
-        }                                               \
-    }; }}
+#define CPP_REFLECTION_CUSTOM_TYPENAME_FOR(type, typeName)                   \
+    namespace cpp { namespace dynamic_reflection { namespace detail {        \
+    template<>                                                               \
+    struct CustomTypeName<type> {                                            \
+        static constexpr ::ctti::detail::cstring name()                      \
+        {                                                                    \
+            return typeName;                                                 \
+        }                                                                    \
+    }; }}}
 }
 
 #define CPP_REFLECTION_FORCE_TYPENAME(type) CPP_REFLECTION_CUSTOM_TYPENAME_FOR(type, #type)
@@ -77,6 +79,26 @@ public:
         _behavior->destroy(object);
     }
 
+    void construct_at(void* where) const
+    {
+        _behavior->construct_at(where);
+    }
+
+    void copy_construct_at(void* where, const void* object) const
+    {
+        _behavior->copy_construct_at(where, object);
+    }
+
+    void move_construct_at(void* where, void* object) const
+    {
+        _behavior->move_construct_at(where, object);
+    }
+
+    void destroy_at(void* object) const
+    {
+        _behavior->destroy_at(object);
+    }
+
     std::string toString(void* object) const
     {
         return _behavior->toString(object);
@@ -87,6 +109,11 @@ public:
         return _behavior->fromString(value);
     }
 
+    void fromString_at(void* where, const std::string& value) const
+    {
+        _behavior->fromString_at(where, value);
+    }
+
     const cpp::TypeInfo& type() const
     {
         return _behavior->type();
@@ -102,6 +129,15 @@ public:
         return typeInfo().name();
     }
 
+    /**
+     * \brief Returns an identifier of the type computed from its registered
+     * name. The id is the same across runs and platforms, see cpp::TypeNameIndex
+     */
+    std::uint64_t id() const
+    {
+        return _behavior->id();
+    }
+
     template<typename T>
     static void registerType()
     {
@@ -120,36 +156,61 @@ public:
         return getType<T>();
     }
 
-    static Type& get(const std::string& typeName)
+    /**
+     * \brief Returns the type registered with the given name. The class, struct,
+     * enum, and union prefixes added by some compilers are ignored
+     *
+     * \throws std::runtime_error if there's no type registered with that name
+     */
+    static Type& get(const char* typeName, std::size_t length)
     {
-        auto try_get = [](const std::string typeName) -> Type*
+        Type* type = types().find(typeName, length);
+
+        if(type == nullptr)
         {
-            auto id = ctti::id_from_name(typeName);
-            auto it = types().find(id);
+            throw std::runtime_error{"Type '" + std::string{typeName, length} + "' not registered"};
+        }
 
-            if(it != std::end(types()))
-                return &it->second;
-            else
-                return nullptr;
-        };
+        return *type;
+    }
 
-        Type* type = nullptr;
+    static Type& get(const std::string& typeName)
+    {
+        return get(typeName.c_str(), typeName.size());
+    }
 
-        if(!(type = try_get(typeName)) &&
-           !(type = try_get("class " + typeName)) &&
-           !(type = try_get("struct " + typeName)))
-        {
-            throw std::runtime_error{"Type '" + typeName + "' not registered"};
-        }
-        else
+    static Type& get(const char* typeName)
+    {
+        return get(typeName, std::strlen(typeName));
+    }
+
+    static Type& get(const cpp::constexp::ConstStringView& typeName)
+    {
+        return get(typeName.begin(), typeName.length());
+    }
+
+    /**
+     * \brief Returns the type with the given id (See Type::id())
+     *
+     * \throws std::runtime_error if there's no type registered with that id
+     */
+    static Type& fromId(std::uint64_t id)
+    {
+        Type* type = types().find(id);
+
+        if(type == nullptr)
         {
-            return *type;
+            throw std::runtime_error{"No type registered with id " + std::to_string(id)};
         }
+
+        return *type;
     }
 
     friend bool operator==(const Type& lhs, const Type& rhs)
     {
-        return lhs.typeInfo() == rhs.typeInfo();
+        // Behaviors are unique per registered type, but handles created
+        // by different binaries may still point to different records
+        return lhs._behavior == rhs._behavior || lhs.typeInfo() == rhs.typeInfo();
     }
 
     friend bool operator!=(const Type& lhs, const Type& rhs)
@@ -157,9 +218,21 @@ public:
         return !(lhs == rhs);
     }
 
+    /**
+     * \brief Type erased special functions of a registered type
+     *
+     * Behaviors are created when a type is registered and are never
+     * destroyed, so Type handles are plain pointers to them with no
+     * ownership.
+     */
     class SIPLASPLAS_REFLECTION_DYNAMIC_EXPORT TypeBehavior
     {
     public:
+        TypeBehavior(const cpp::TypeInfo& type, std::uint64_t id) :
+            _type{type},
+            _id{id}
+        {}
+
         virtual ~TypeBehavior() = default;
 
         virtual void* construct() = 0;
@@ -170,7 +243,27 @@ public:
         virtual void move_assign(void* object, void* other) = 0;
         virtual std::string toString(void* object) = 0;
         virtual void* fromString(const std::string& value) = 0;
-        virtual const cpp::TypeInfo& type() const = 0;
+
+        // Same as above, but working on storage owned by the caller
+        virtual void construct_at(void* where) = 0;
+        virtual void destroy_at(void* object) = 0;
+        virtual void copy_construct_at(void* where, const void* object) = 0;
+        virtual void move_construct_at(void* where, void* object) = 0;
+        virtual void fromString_at(void* where, const std::string& value) = 0;
+
+        const cpp::TypeInfo& type() const
+        {
+            return _type;
+        }
+
+        std::uint64_t id() const
+        {
+            return _id;
+        }
+
+    private:
+        cpp::TypeInfo _type;
+        std::uint64_t _id;
     };
 
 private:
@@ -205,25 +298,23 @@ private:
     class TypeBehaiorOf: public TypeBehavior
     {
     public:
-        TypeBehaiorOf() :
-            _type{cpp::TypeInfo::get<T>()}
-        {
-            _objectsArena.emplace_back(512 * (sizeof(T) + alignof(T)));
-        }
+        TypeBehaiorOf(std::uint64_t id) :
+            TypeBehavior{cpp::TypeInfo::get<T>(), id}
+        {}
 
         void* construct() override
         {
-            return new(allocate_object()) T();
+            return create();
         }
 
         void* copy_construct(const void* object) override
         {
-            return new(allocate_object()) T(*reinterpret_cast<const T*>(object));
+            return create(*reinterpret_cast<const T*>(object));
         }
 
         void* move_construct(void* object) override
         {
-            return new(allocate_object()) T(std::move(*reinterpret_cast<T*>(object)));
+            return create(std::move(*reinterpret_cast<T*>(object)));
         }
 
         void copy_assign(void* object, const void* other) override
@@ -242,6 +333,26 @@ private:
             deallocate_object(object);
         }
 
+        void construct_at(void* where) override
+        {
+            new(where) T();
+        }
+
+        void destroy_at(void* object) override
+        {
+            reinterpret_cast<T*>(object)->~T();
+        }
+
+        void copy_construct_at(void* where, const void* object) override
+        {
+            new(where) T(*reinterpret_cast<const T*>(object));
+        }
+
+        void move_construct_at(void* where, void* object) override
+        {
+            new(where) T(std::move(*reinterpret_cast<T*>(object)));
+        }
+
         std::string toString(void* object) override
         {
             return ToString<T>::apply(*static_cast<T*>(object));
@@ -253,14 +364,12 @@ private:
             return copy_construct(&object); // Copy returned object
         }
 
-        const cpp::TypeInfo& type() const override
+        void fromString_at(void* where, const std::string& value) override
         {
-            return _type;
+            new(where) T(FromString<T>::apply(value));
         }
 
     private:
-        cpp::TypeInfo _type;
-
         template<typename U, typename = void>
         class ToString
         {
@@ -309,92 +418,29 @@ private:
             }
         };
 
-        class StorageBlock
-        {
-        public:
-            StorageBlock(std::size_t bytes) :
-                _block{ new char[bytes]},
-                _bytes{bytes},
-                _freeList{ begin(), end(), sizeof(T), alignof(T) }
-            {}
-
-            void* begin() const
-            {
-                return _block.get();
-            }
-
-            void* end() const
-            {
-                return _block.get() + _bytes;
-            }
-
-            std::size_t bytes() const
-            {
-                return _bytes;
-            }
-
-            cpp::FreeListAllocator freeList() const
-            {
-                return _freeList;
-            }
-
-        private:
-            std::unique_ptr<char[]> _block;
-            std::size_t _bytes;
-            cpp::FreeListAllocator _freeList;
-        };
-
-        std::vector<StorageBlock> _objectsArena;
-
         void* allocate_object()
         {
-            return std::malloc(sizeof(T));
-        }
-
-        void* allocate(std::vector<StorageBlock>& arena, std::size_t sizeOf, std::size_t alignment, int tries = 1)
-        {
-            void* slot = arena.back().freeList().allocate(sizeOf, alignment);
-
-            if(slot)
-                return slot;
-            else
-            {
-                if(tries < 10)
-                {
-                    // Freelist out of space, allocate new block
-                    arena.emplace_back(512*(sizeOf + alignment));
-
-                    // try again
-                    return allocate(arena,sizeOf, alignment, tries + 1);
-                }
-                else
-                {
-                    cpp::Throw<std::runtime_error>("Cannot allocate more storage for meta-instances");
-                    return nullptr;
-                }
-            }
+            return detail::ObjectPool<T>::allocate();
         }
 
         void deallocate_object(void* pointer)
         {
-            return std::free(pointer);
+            detail::ObjectPool<T>::deallocate(pointer);
         }
 
-        void deallocate(std::vector<StorageBlock>& arena, void* pointer)
+        template<typename... Args>
+        void* create(Args&&... args)
         {
-            auto blockIt = std::find_if(std::begin(arena), std::end(arena),
-            [pointer](const StorageBlock& block)
-            {
-                return block.freeList().belongs_to_storage(pointer);
-            });
+            void* storage = allocate_object();
 
-            if(blockIt != std::end(arena))
+            try
             {
-                blockIt->freeList().deallocate(pointer, sizeof(T));
+                return new(storage) T(std::forward<Args>(args)...);
             }
-            else
+            catch(...)
             {
-                cpp::Throw<std::runtime_error>("Cannot deallocate object @{}", pointer);
+                deallocate_object(storage);
+                throw;
             }
         }
     };
@@ -404,7 +450,16 @@ private:
     {
         static Type& type{ [&]() -> Type&
         {
-            return types()[detail::CustomTypeName<T>::id()] = Type{new TypeBehaiorOf<T>()};
+            const auto name = detail::CustomTypeName<T>::name();
+            auto registered = types().insert(name.begin(), name.length(), Type{});
+
+            if(registered.second)
+            {
+                // Intentionally leaked, see TypeBehavior
+                registered.first = Type{new TypeBehaiorOf<T>(Types::id(name.begin(), name.length()))};
+            }
+
+            return registered.first;
         }()};
 
         return type;
@@ -414,9 +469,9 @@ private:
         _behavior{behavior}
     {}
 
-    std::shared_ptr<TypeBehavior> _behavior;
+    TypeBehavior* _behavior = nullptr;
 
-    using Types = std::unordered_map<ctti::type_index, Type>;
+    using Types = cpp::TypeNameIndex<Type>;
 
     static Types& types();
 };
@@ -0,0 +1,834 @@
+#ifndef SIPLASPLAS_REFLECTION_STATIC_BINARY_HPP
+#define SIPLASPLAS_REFLECTION_STATIC_BINARY_HPP
+
+#include "class.hpp"
+#include "field.hpp"
+#include "sourceinfo.hpp"
+#include <siplasplas/utility/meta.hpp>
+#include <siplasplas/utility/exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpp
+{
+
+namespace static_reflection
+{
+
+/**
+ * \ingroup static-reflection
+ * \defgroup binary-serialization
+ * \brief Binary serialization of reflected types
+ *
+ * Serializes values to a compact binary format, walking the static reflection
+ * information of user classes (See cpp::static_reflection::Class) at compile time.
+ * The serializer of each type is selected at compile time, there's no runtime type
+ * dispatch nor type tags in the output:
+ *
+ *  - Arithmetic values are written as their bytes, bools as one byte (0 or 1), and
+ *    enumeration values as their underlying integer.
+ *  - Strings and containers are written as a varint (LEB128) element count followed
+ *    by their elements.
+ *  - `std::array`, `std::pair` and `std::tuple` are written as their elements.
+ *  - Reflected classes are written as their public member objects, in declaration order.
+ *
+ * Types whose serialized form is exactly their object representation, and for which
+ * any sequence of bytes is a valid value (Arithmetic values other than bool, and standard
+ * layout trivially copyable classes whose reflected members are themselves packed and fill
+ * the whole object) are "packed": they are written and read with a single `memcpy()`, and
+ * so are contiguous sequences of them (Such as a `std::vector` of a packed class). Bools and
+ * enums are never packed, so their values are validated when reading untrusted data.
+ *
+ * Values are written in the native byte order and representation, so data can only be
+ * read back on platforms with the same endianness and type sizes.
+ */
+namespace binary
+{
+
+/**
+ * \ingroup binary-serialization
+ * \brief Appends serialized data to a byte buffer
+ */
+class Writer
+{
+public:
+    /**
+     * \brief Initializes a writer appending to the given buffer
+     */
+    explicit Writer(std::vector<char>& buffer) :
+        _buffer(buffer)
+    {}
+
+    /**
+     * \brief Appends the given bytes
+     */
+    void write(const void* data, std::size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        _buffer.insert(_buffer.end(), bytes, bytes + size);
+    }
+
+    /**
+     * \brief Appends an unsigned integer in LEB128 varint encoding
+     */
+    void writeVarint(std::uint64_t value)
+    {
+        char bytes[10];
+        std::size_t size = 0;
+
+        while(value >= 0x80)
+        {
+            bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+
+        bytes[size++] = static_cast<char>(value);
+        write(bytes, size);
+    }
+
+    /**
+     * \brief Makes room for at least \p size more bytes, keeping the
+     * geometric growth of the buffer
+     */
+    void reserve(std::size_t size)
+    {
+        if(_buffer.capacity() - _buffer.size() < size)
+        {
+            _buffer.reserve(std::max(_buffer.size() + size, 2 * _buffer.capacity()));
+        }
+    }
+
+    /**
+     * \brief Returns the buffer the writer appends to
+     */
+    std::vector<char>& buffer()
+    {
+        return _buffer;
+    }
+
+private:
+    std::vector<char>& _buffer;
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Reads serialized data from a byte range
+ *
+ * All reads are bounds checked: reading past the end of the range throws
+ * `std::runtime_error`, as does reading element counts that cannot fit in the
+ * rest of the data (So corrupt data cannot trigger huge allocations).
+ */
+class Reader
+{
+public:
+    /**
+     * \brief Initializes a reader of the given range. The range must outlive the reader
+     */
+    Reader(const void* data, std::size_t size) :
+        _current{static_cast<const char*>(data)},
+        _end{static_cast<const char*>(data) + size}
+    {}
+
+    /**
+     * \brief Reads \p size bytes into \p data
+     */
+    void read(void* data, std::size_t size)
+    {
+        if(remaining() < size)
+        {
+            cpp::Throw<std::runtime_error>(
+                "Truncated binary data: reading {} bytes, {} bytes left",
+                size, remaining()
+            );
+        }
+
+        std::memcpy(data, _current, size);
+        _current += size;
+    }
+
+    /**
+     * \brief Reads an unsigned integer in LEB128 varint encoding
+     */
+    std::uint64_t readVarint()
+    {
+        std::uint64_t value = 0;
+
+        for(unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if(_current == _end)
+            {
+                cpp::Throw<std::runtime_error>("Truncated binary data: unterminated varint");
+            }
+
+            const auto byte = static_cast<unsigned char>(*_current++);
+
+            // The tenth byte only holds the most significant bit
+            if(shift == 63 && byte > 1)
+            {
+                break;
+            }
+
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+
+        cpp::Throw<std::runtime_error>("Invalid binary data: varint longer than 64 bits");
+        return value;
+    }
+
+    /**
+     * \brief Reads a container element count
+     *
+     * \param minElementSize Minimal number of bytes a serialized element takes.
+     * Used to reject counts larger than the remaining data. Elements of empty types
+     * count as one byte, so a corrupt count never makes the caller allocate more
+     * elements than bytes left
+     */
+    std::size_t readCount(std::size_t minElementSize)
+    {
+        const std::uint64_t count = readVarint();
+        minElementSize = std::max<std::size_t>(minElementSize, 1);
+
+        if(count > remaining() / minElementSize)
+        {
+            cpp::Throw<std::runtime_error>(
+                "Invalid binary data: {} elements of at least {} bytes, {} bytes left",
+                count, minElementSize, remaining()
+            );
+        }
+
+        return static_cast<std::size_t>(count);
+    }
+
+    /**
+     * \brief Skips the next \p size bytes
+     */
+    void skip(std::size_t size)
+    {
+        if(remaining() < size)
+        {
+            cpp::Throw<std::runtime_error>(
+                "Truncated binary data: skipping {} bytes, {} bytes left",
+                size, remaining()
+            );
+        }
+
+        _current += size;
+    }
+
+    /**
+     * \brief Returns a reader of the next \p size bytes, and skips them
+     */
+    Reader split(std::size_t size)
+    {
+        const char* begin = _current;
+        skip(size);
+        return {begin, size};
+    }
+
+    /**
+     * \brief Returns the number of bytes not read yet
+     */
+    std::size_t remaining() const
+    {
+        return static_cast<std::size_t>(_end - _current);
+    }
+
+private:
+    const char* _current;
+    const char* _end;
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Implements serialization of values of type T
+ *
+ * Specializations provide:
+ *  - `static void write(Writer&, const T&)`
+ *  - `static void read(Reader&, T&)`
+ *  - `static constexpr bool packed`: Whether the serialized form of T is its object
+ *  representation.
+ *  - `static constexpr std::size_t minSize`: Minimal size of a serialized T.
+ *
+ * The primary template implements serialization of reflected classes. Specialize
+ * it to customize the serialization of a type.
+ */
+template<typename T, typename = void>
+class Serializer;
+
+namespace detail
+{
+
+template<typename Fields>
+class FieldsSerializer;
+
+template<typename... Fields>
+class FieldsSerializer<::cpp::meta::list<Fields...>>
+{
+public:
+    static constexpr bool allPacked()
+    {
+        bool result = true;
+
+        for(bool packed : {true, Serializer<typename Fields::decay_t>::packed...})
+        {
+            result = result && packed;
+        }
+
+        return result;
+    }
+
+    static constexpr std::size_t sizeOf()
+    {
+        std::size_t result = 0;
+
+        for(std::size_t size : {std::size_t{0}, sizeof(typename Fields::decay_t)...})
+        {
+            result += size;
+        }
+
+        return result;
+    }
+
+    static constexpr std::size_t minSize()
+    {
+        std::size_t result = 0;
+
+        for(std::size_t size : {std::size_t{0}, Serializer<typename Fields::decay_t>::minSize...})
+        {
+            result += size;
+        }
+
+        return result;
+    }
+
+    template<typename Class>
+    static void write(Writer& writer, const Class& object)
+    {
+        (void)std::initializer_list<int>{0, (
+            Serializer<typename Fields::decay_t>::write(writer, Fields::get(object)), 0
+        )...};
+    }
+
+    template<typename Class>
+    static void read(Reader& reader, Class& object)
+    {
+        (void)std::initializer_list<int>{0, (
+            Serializer<typename Fields::decay_t>::read(reader, Fields::get(object)), 0
+        )...};
+    }
+};
+
+template<typename Tuple, typename Indices>
+class TupleSerializer;
+
+template<typename Tuple, std::size_t... Is>
+class TupleSerializer<Tuple, std::index_sequence<Is...>>
+{
+public:
+    static constexpr std::size_t minSize()
+    {
+        std::size_t result = 0;
+
+        for(std::size_t size : {std::size_t{0}, Serializer<std::decay_t<std::tuple_element_t<Is, Tuple>>>::minSize...})
+        {
+            result += size;
+        }
+
+        return result;
+    }
+
+    static void write(Writer& writer, const Tuple& tuple)
+    {
+        (void)std::initializer_list<int>{0, (
+            Serializer<std::decay_t<std::tuple_element_t<Is, Tuple>>>::write(writer, std::get<Is>(tuple)), 0
+        )...};
+    }
+
+    static void read(Reader& reader, Tuple& tuple)
+    {
+        (void)std::initializer_list<int>{0, (
+            Serializer<std::decay_t<std::tuple_element_t<Is, Tuple>>>::read(reader, std::get<Is>(tuple)), 0
+        )...};
+    }
+};
+
+template<typename Map>
+class MapSerializer
+{
+public:
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = 1;
+
+    static void write(Writer& writer, const Map& map)
+    {
+        writer.writeVarint(map.size());
+
+        for(const auto& keyValue : map)
+        {
+            Serializer<Key>::write(writer, keyValue.first);
+            Serializer<Value>::write(writer, keyValue.second);
+        }
+    }
+
+    static void read(Reader& reader, Map& map)
+    {
+        const std::size_t count = reader.readCount(Serializer<Key>::minSize + Serializer<Value>::minSize);
+        map.clear();
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            Key key{};
+            Serializer<Key>::read(reader, key);
+            Serializer<Value>::read(reader, map[std::move(key)]);
+        }
+    }
+};
+
+}
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes reflected classes as their public member objects
+ */
+template<typename T, typename>
+class Serializer
+{
+    using Fields = typename ::cpp::static_reflection::Class<T>::Fields;
+    using FieldsSerializer = detail::FieldsSerializer<Fields>;
+
+    static_assert(std::is_class<T>::value,
+        "Binary serialization is not supported for this type");
+    static_assert(
+        !std::is_same<typename ::cpp::static_reflection::Class<T>::SourceInfo, meta::EmptySourceInfo<T>>::value ||
+        !std::is_same<Fields, ::cpp::meta::list<>>::value,
+        "Binary serialization of a class requires its static reflection information. "
+        "Include the reflection header of the class, or specialize cpp::static_reflection::binary::Serializer"
+    );
+
+public:
+    static constexpr bool packed =
+        std::is_trivially_copyable<T>::value &&
+        std::is_standard_layout<T>::value &&
+        FieldsSerializer::allPacked() &&
+        FieldsSerializer::sizeOf() == sizeof(T);
+
+    static constexpr std::size_t minSize = packed ? sizeof(T) : FieldsSerializer::minSize();
+
+    static void write(Writer& writer, const T& object)
+    {
+        write(writer, object, std::integral_constant<bool, packed>());
+    }
+
+    static void read(Reader& reader, T& object)
+    {
+        read(reader, object, std::integral_constant<bool, packed>());
+    }
+
+private:
+    static void write(Writer& writer, const T& object, std::true_type)
+    {
+        writer.write(&object, sizeof(T));
+    }
+
+    static void write(Writer& writer, const T& object, std::false_type)
+    {
+        FieldsSerializer::write(writer, object);
+    }
+
+    static void read(Reader& reader, T& object, std::true_type)
+    {
+        reader.read(&object, sizeof(T));
+    }
+
+    static void read(Reader& reader, T& object, std::false_type)
+    {
+        FieldsSerializer::read(reader, object);
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes arithmetic values as their bytes
+ */
+template<typename T>
+class Serializer<T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>>
+{
+public:
+    static constexpr bool packed = true;
+    static constexpr std::size_t minSize = sizeof(T);
+
+    static void write(Writer& writer, const T& value)
+    {
+        writer.write(&value, sizeof(T));
+    }
+
+    static void read(Reader& reader, T& value)
+    {
+        reader.read(&value, sizeof(T));
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes bools as one byte, 0 or 1. Other bytes are rejected when reading
+ */
+template<>
+class Serializer<bool>
+{
+public:
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = 1;
+
+    static void write(Writer& writer, const bool& value)
+    {
+        const unsigned char byte = value ? 1 : 0;
+        writer.write(&byte, 1);
+    }
+
+    static void read(Reader& reader, bool& value)
+    {
+        unsigned char byte = 0;
+        reader.read(&byte, 1);
+
+        if(byte > 1)
+        {
+            cpp::Throw<std::runtime_error>("Invalid binary data: {} is not a bool value", static_cast<unsigned>(byte));
+        }
+
+        value = (byte == 1);
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes enumeration values as their underlying integer
+ */
+template<typename T>
+class Serializer<T, std::enable_if_t<std::is_enum<T>::value>>
+{
+public:
+    using Underlying = std::underlying_type_t<T>;
+
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = Serializer<Underlying>::minSize;
+
+    static void write(Writer& writer, const T& value)
+    {
+        Serializer<Underlying>::write(writer, static_cast<Underlying>(value));
+    }
+
+    static void read(Reader& reader, T& value)
+    {
+        Underlying underlying{};
+        Serializer<Underlying>::read(reader, underlying);
+        value = static_cast<T>(underlying);
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes strings as their length followed by their characters
+ */
+template<typename Char, typename Traits, typename Allocator>
+class Serializer<std::basic_string<Char, Traits, Allocator>>
+{
+public:
+    using String = std::basic_string<Char, Traits, Allocator>;
+
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = 1;
+
+    static void write(Writer& writer, const String& string)
+    {
+        writer.writeVarint(string.size());
+        writer.write(string.data(), string.size() * sizeof(Char));
+    }
+
+    static void read(Reader& reader, String& string)
+    {
+        string.resize(reader.readCount(sizeof(Char)));
+        reader.read(&string[0], string.size() * sizeof(Char));
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes vectors as their size followed by their elements. Vectors of
+ * packed elements are copied in one go
+ */
+template<typename T, typename Allocator>
+class Serializer<std::vector<T, Allocator>>
+{
+public:
+    using Vector = std::vector<T, Allocator>;
+
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = 1;
+
+    static void write(Writer& writer, const Vector& vector)
+    {
+        writer.writeVarint(vector.size());
+        write(writer, vector, std::integral_constant<bool, Serializer<T>::packed>());
+    }
+
+    static void read(Reader& reader, Vector& vector)
+    {
+        vector.resize(reader.readCount(Serializer<T>::minSize));
+        read(reader, vector, std::integral_constant<bool, Serializer<T>::packed>());
+    }
+
+private:
+    static void write(Writer& writer, const Vector& vector, std::true_type)
+    {
+        writer.write(vector.data(), vector.size() * sizeof(T));
+    }
+
+    static void write(Writer& writer, const Vector& vector, std::false_type)
+    {
+        for(const T& element : vector)
+        {
+            Serializer<T>::write(writer, element);
+        }
+    }
+
+    static void read(Reader& reader, Vector& vector, std::true_type)
+    {
+        reader.read(vector.data(), vector.size() * sizeof(T));
+    }
+
+    static void read(Reader& reader, Vector& vector, std::false_type)
+    {
+        for(T& element : vector)
+        {
+            Serializer<T>::read(reader, element);
+        }
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes bool vectors as their size followed by one byte per element
+ */
+template<typename Allocator>
+class Serializer<std::vector<bool, Allocator>>
+{
+public:
+    using Vector = std::vector<bool, Allocator>;
+
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = 1;
+
+    static void write(Writer& writer, const Vector& vector)
+    {
+        writer.writeVarint(vector.size());
+
+        for(const bool element : vector)
+        {
+            Serializer<bool>::write(writer, element);
+        }
+    }
+
+    static void read(Reader& reader, Vector& vector)
+    {
+        vector.resize(reader.readCount(Serializer<bool>::minSize));
+
+        for(std::size_t i = 0; i < vector.size(); ++i)
+        {
+            bool element = false;
+            Serializer<bool>::read(reader, element);
+            vector[i] = element;
+        }
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes fixed size arrays as their elements
+ */
+template<typename T, std::size_t N>
+class Serializer<std::array<T, N>>
+{
+public:
+    using Array = std::array<T, N>;
+
+    static constexpr bool packed = Serializer<T>::packed && sizeof(Array) == N * sizeof(T);
+    static constexpr std::size_t minSize = N * Serializer<T>::minSize;
+
+    static void write(Writer& writer, const Array& array)
+    {
+        write(writer, array, std::integral_constant<bool, packed>());
+    }
+
+    static void read(Reader& reader, Array& array)
+    {
+        read(reader, array, std::integral_constant<bool, packed>());
+    }
+
+private:
+    static void write(Writer& writer, const Array& array, std::true_type)
+    {
+        writer.write(array.data(), sizeof(Array));
+    }
+
+    static void write(Writer& writer, const Array& array, std::false_type)
+    {
+        for(const T& element : array)
+        {
+            Serializer<T>::write(writer, element);
+        }
+    }
+
+    static void read(Reader& reader, Array& array, std::true_type)
+    {
+        reader.read(array.data(), sizeof(Array));
+    }
+
+    static void read(Reader& reader, Array& array, std::false_type)
+    {
+        for(T& element : array)
+        {
+            Serializer<T>::read(reader, element);
+        }
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes pairs as their first and second elements
+ */
+template<typename First, typename Second>
+class Serializer<std::pair<First, Second>>
+{
+public:
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize = Serializer<First>::minSize + Serializer<Second>::minSize;
+
+    static void write(Writer& writer, const std::pair<First, Second>& pair)
+    {
+        Serializer<First>::write(writer, pair.first);
+        Serializer<Second>::write(writer, pair.second);
+    }
+
+    static void read(Reader& reader, std::pair<First, Second>& pair)
+    {
+        Serializer<First>::read(reader, pair.first);
+        Serializer<Second>::read(reader, pair.second);
+    }
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes tuples as their elements
+ */
+template<typename... Ts>
+class Serializer<std::tuple<Ts...>> :
+    public detail::TupleSerializer<std::tuple<Ts...>, std::index_sequence_for<Ts...>>
+{
+public:
+    static constexpr bool packed = false;
+    static constexpr std::size_t minSize =
+        detail::TupleSerializer<std::tuple<Ts...>, std::index_sequence_for<Ts...>>::minSize();
+};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes maps as their size followed by their key-value pairs
+ */
+template<typename Key, typename Value, typename Compare, typename Allocator>
+class Serializer<std::map<Key, Value, Compare, Allocator>> :
+    public detail::MapSerializer<std::map<Key, Value, Compare, Allocator>>
+{};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Serializes unordered maps as their size followed by their key-value pairs
+ */
+template<typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+class Serializer<std::unordered_map<Key, Value, Hash, Equal, Allocator>> :
+    public detail::MapSerializer<std::unordered_map<Key, Value, Hash, Equal, Allocator>>
+{};
+
+/**
+ * \ingroup binary-serialization
+ * \brief Appends the serialized value to the given buffer
+ */
+template<typename T>
+void serialize(const T& value, std::vector<char>& buffer)
+{
+    Writer writer{buffer};
+    writer.reserve(Serializer<T>::minSize);
+    Serializer<T>::write(writer, value);
+}
+
+/**
+ * \ingroup binary-serialization
+ * \brief Returns a buffer with the serialized value
+ */
+template<typename T>
+std::vector<char> serialize(const T& value)
+{
+    std::vector<char> buffer;
+    serialize(value, buffer);
+    return buffer;
+}
+
+/**
+ * \ingroup binary-serialization
+ * \brief Reads a serialized value
+ *
+ * \param data Pointer to the serialized data
+ * \param size Size in bytes of the serialized data
+ * \param value Object the value is read into
+ *
+ * \returns The number of bytes read
+ * \throws std::runtime_error If the data is truncated or corrupt
+ */
+template<typename T>
+std::size_t deserialize(const void* data, std::size_t size, T& value)
+{
+    Reader reader{data, size};
+    Serializer<T>::read(reader, value);
+    return size - reader.remaining();
+}
+
+/**
+ * \ingroup binary-serialization
+ * \brief Returns the value serialized in the given buffer
+ *
+ * \throws std::runtime_error If the data is truncated or corrupt
+ */
+template<typename T>
+T deserialize(const std::vector<char>& buffer)
+{
+    T value{};
+    deserialize(buffer.data(), buffer.size(), value);
+    return value;
+}
+
+}
+
+}
+
+}
+
+#endif // SIPLASPLAS_REFLECTION_STATIC_BINARY_HPP
@@ -2,8 +2,10 @@
 #define SIPLASPLAS_REFLECTION_STATIC_ENUM_HPP
 
 #include <siplasplas/utility/meta.hpp>
+#include <siplasplas/utility/hash.hpp>
 #include <siplasplas/constexpr/arrayview.hpp>
 #include <siplasplas/constexpr/meta.hpp>
+#include <cstdint>
 #include <string>
 #include <limits>
 #include <array>
@@ -15,6 +17,167 @@ namespace static_reflection
 namespace meta
 {
 
+namespace detail
+{
+
+/**
+ * \brief Fixed size table usable in constant expressions
+ */
+template<typename T, std::size_t Size>
+struct EnumTable
+{
+    T entries[Size];
+};
+
+/**
+ * \brief Returns the number of slots of the name hash table of an
+ * enumeration with the given number of constants (A power of two, with a
+ * load factor of 1/2 at most)
+ */
+constexpr std::size_t enumNameSlots(std::size_t count)
+{
+    std::size_t slots = 2;
+
+    while(slots < 2 * count)
+    {
+        slots *= 2;
+    }
+
+    return slots;
+}
+
+/**
+ * \brief Builds the name hash table of an enumeration
+ *
+ * Open addressing with linear probing. Each slot holds the index of a
+ * constant, empty slots hold `count`
+ */
+template<std::size_t Slots, std::size_t N>
+constexpr EnumTable<std::size_t, Slots> enumNameTable(const EnumTable<std::uint64_t, N> hashes, std::size_t count)
+{
+    EnumTable<std::size_t, Slots> table{};
+
+    for(std::size_t slot = 0; slot < Slots; ++slot)
+    {
+        table.entries[slot] = count;
+    }
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t slot = hashes.entries[i] & (Slots - 1);
+
+        while(table.entries[slot] != count)
+        {
+            slot = (slot + 1) & (Slots - 1);
+        }
+
+        table.entries[slot] = i;
+    }
+
+    return table;
+}
+
+/**
+ * \brief Returns the distance between a value and the minimum value
+ * of an enumeration, computed in unsigned arithmetic so it never overflows
+ */
+template<typename T>
+constexpr std::uint64_t enumValueOffset(T value, T min)
+{
+    return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min);
+}
+
+template<typename T, std::size_t N>
+constexpr T enumMinValue(const EnumTable<T, N> values, std::size_t count)
+{
+    T min = values.entries[0];
+
+    for(std::size_t i = 1; i < count; ++i)
+    {
+        if(values.entries[i] < min)
+        {
+            min = values.entries[i];
+        }
+    }
+
+    return min;
+}
+
+template<typename T, std::size_t N>
+constexpr std::uint64_t enumValueRange(const EnumTable<T, N> values, std::size_t count)
+{
+    const T min = enumMinValue(values, count);
+    std::uint64_t range = 0;
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint64_t offset = enumValueOffset(values.entries[i], min);
+
+        if(offset > range)
+        {
+            range = offset;
+        }
+    }
+
+    return range;
+}
+
+/**
+ * \brief Checks whether the values of an enumeration are contiguous
+ * enough to be indexed directly
+ */
+constexpr bool enumDenseValues(std::uint64_t range, std::size_t count)
+{
+    return count > 0 && range < 2 * count + 16;
+}
+
+/**
+ * \brief Builds the value index of an enumeration
+ *
+ * If the values are dense (See enumDenseValues()), `entries[value - min]` is the
+ * index of the first constant with that value (`count` if there's none). Else the
+ * table holds the constant indices sorted by value, ties in declaration order.
+ */
+template<std::size_t Size, typename T, std::size_t N>
+constexpr EnumTable<std::size_t, Size> enumValueTable(const EnumTable<T, N> values, std::size_t count, bool dense)
+{
+    EnumTable<std::size_t, Size> table{};
+
+    if(dense)
+    {
+        const T min = enumMinValue(values, count);
+
+        for(std::size_t i = 0; i < Size; ++i)
+        {
+            table.entries[i] = count;
+        }
+
+        for(std::size_t i = count; i-- > 0;)
+        {
+            table.entries[enumValueOffset(values.entries[i], min)] = i;
+        }
+    }
+    else
+    {
+        // Insertion sort, stable
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t j = i;
+
+            for(; j > 0 && values.entries[i] < values.entries[table.entries[j - 1]]; --j)
+            {
+                table.entries[j] = table.entries[j - 1];
+            }
+
+            table.entries[j] = i;
+        }
+    }
+
+    return table;
+}
+
+}
+
 template<
     typename SourceInfo,
     typename EnumType,
@@ -45,6 +208,11 @@ class Enum<
  * This class stores information of a given enumeration type and exposes it
  * as methods that can be used to query for enumeration values, get string representations
  * of enumeration values, indexing the enumeration, etc.
+ *
+ * Conversions don't scan the constants: a hash table of the names and an index of
+ * the values (A direct table if the values are contiguous enough, sorted otherwise)
+ * are computed at compile time, so toString(), fromString() and has() are constant
+ * time (Logarithmic for sparse values) both at runtime and in constant expressions.
  */
 class Enum
 #endif // SIPLASPLAS_DOXYGEN_RUNNING
@@ -174,7 +342,9 @@ public:
      */
     static constexpr const char* toString(const EnumType value)
     {
-        return _toString(value, 0);
+        const std::size_t i = _findValue(static_cast<UnderlyingType>(value));
+
+        return (i < _count) ? Enum::name(i) : nullptr;
     }
 
     /**
@@ -191,7 +361,11 @@ public:
      */
     static constexpr EnumType fromString(const char* name)
     {
-        return _fromString(name, 0);
+        const std::size_t i = _findName(name);
+
+        return (i < _count) ?
+            Enum::value(i) :
+            static_cast<EnumType>(std::numeric_limits<UnderlyingType>::max());
     }
 
     /**
@@ -206,7 +380,7 @@ public:
      */
     static constexpr bool has(const char* name)
     {
-        return _has(name, 0);
+        return _findName(name) < _count;
     }
 
     /**
@@ -216,7 +390,7 @@ public:
      */
     static constexpr bool has(const UnderlyingType value)
     {
-        return _has(value, 0);
+        return _findValue(value) < _count;
     }
 
 private:
@@ -224,35 +398,89 @@ private:
         ::cpp::constexp::SequenceToString<ConstantsNames>::c_str()...
     }};
 
+    static constexpr std::size_t _count = sizeof...(Constants);
+
+    // Tables have an extra entry so they are never empty
+    static constexpr detail::EnumTable<UnderlyingType, _count + 1> _valuesTable = {{
+        static_cast<UnderlyingType>(Constants)..., UnderlyingType{}
+    }};
+    static constexpr UnderlyingType _minValue = detail::enumMinValue(_valuesTable, _count);
+    static constexpr std::uint64_t _valueRange = detail::enumValueRange(_valuesTable, _count);
+    static constexpr bool _denseValues = detail::enumDenseValues(_valueRange, _count);
+    static constexpr std::size_t _nameSlots = detail::enumNameSlots(_count);
+    static constexpr std::size_t _valueEntries = _denseValues ? static_cast<std::size_t>(_valueRange) + 1 : _count + 1;
+
+    using NameTable  = detail::EnumTable<std::size_t, _nameSlots>;
+    using ValueTable = detail::EnumTable<std::size_t, _valueEntries>;
+
+    static constexpr NameTable _nameTable = detail::enumNameTable<_nameSlots>(
+        detail::EnumTable<std::uint64_t, _count + 1>{{
+            ::cpp::fnv1a(::cpp::constexp::SequenceToString<ConstantsNames>::c_str())..., 0
+        }},
+        _count
+    );
+    static constexpr ValueTable _valueTable = detail::enumValueTable<_valueEntries>(
+        _valuesTable, _count, _denseValues
+    );
+
     static constexpr bool streq(const char* lhs, const char* rhs)
     {
-        return ((*rhs and *lhs) ? (*lhs == *rhs) and streq(lhs + 1, rhs + 1) : (not *lhs and not *rhs));
-    }
+        for(; *lhs != '\0' && *lhs == *rhs; ++lhs, ++rhs);
 
-    static constexpr const char* _toString(const EnumType value, std::size_t i)
-    {
-        return (i < sizeof...(Constants)) ?
-            ((value == Enum::value(i)) ? Enum::name(i) : _toString(value, i + 1))
-        :
-            nullptr;
+        return *lhs == *rhs;
     }
 
-    static constexpr EnumType _fromString(const char* name, std::size_t i)
+    // Returns the index of the constant with the given name, count() if there's none
+    static constexpr std::size_t _findName(const char* name)
     {
-        return (i < sizeof...(ConstantsNames)) ?
-            (streq(name, Enum::name(i)) ? Enum::value(i) : _fromString(name, i + 1))
-        :
-            static_cast<EnumType>(std::numeric_limits<typename std::underlying_type<EnumType>::type>::max());
+        std::size_t slot = ::cpp::fnv1a(name) & (_nameSlots - 1);
+
+        for(; _nameTable.entries[slot] != _count; slot = (slot + 1) & (_nameSlots - 1))
+        {
+            if(streq(name, Enum::name(_nameTable.entries[slot])))
+            {
+                return _nameTable.entries[slot];
+            }
+        }
+
+        return _count;
     }
 
-    static constexpr bool _has(const char* name, std::size_t i)
+    // Returns the index of the first constant with the given value, count() if there's none
+    static constexpr std::size_t _findValue(const UnderlyingType value)
     {
-        return (i < sizeof...(ConstantsNames)) && (streq(name, Enum::name(i)) || _has(name, i + 1));
+        if(_denseValues)
+        {
+            const std::uint64_t offset = detail::enumValueOffset(value, _minValue);
+
+            return (offset < _valueEntries) ? _valueTable.entries[offset] : _count;
+        }
+        else
+        {
+            std::size_t begin = 0, end = _count;
+
+            while(begin < end)
+            {
+                const std::size_t middle = begin + (end - begin) / 2;
+
+                if(_underlyingValue(_valueTable.entries[middle]) < value)
+                {
+                    begin = middle + 1;
+                }
+                else
+                {
+                    end = middle;
+                }
+            }
+
+            return (begin < _count && _underlyingValue(_valueTable.entries[begin]) == value) ?
+                _valueTable.entries[begin] : _count;
+        }
     }
 
-    static constexpr bool _has(const UnderlyingType value, std::size_t i)
+    static constexpr UnderlyingType _underlyingValue(std::size_t i)
     {
-        return (i < sizeof...(Constants)) && ((value == static_cast<UnderlyingType>(Enum::value(i))) || _has(value, i + 1));
+        return static_cast<UnderlyingType>(Enum::value(i));
     }
 };
 
@@ -269,6 +497,32 @@ constexpr typename Enum<
     ::cpp::meta::list<ConstantsNames...>
 >::_namesArray;
 
+template<typename SourceInfo, typename EnumType, EnumType... Constants, typename... ConstantsNames>
+constexpr typename Enum<
+    SourceInfo,
+    EnumType,
+    ::cpp::meta::list<std::integral_constant<EnumType, Constants>...>,
+    ::cpp::meta::list<ConstantsNames...>
+>::NameTable Enum<
+    SourceInfo,
+    EnumType,
+    ::cpp::meta::list<std::integral_constant<EnumType, Constants>...>,
+    ::cpp::meta::list<ConstantsNames...>
+>::_nameTable;
+
+template<typename SourceInfo, typename EnumType, EnumType... Constants, typename... ConstantsNames>
+constexpr typename Enum<
+    SourceInfo,
+    EnumType,
+    ::cpp::meta::list<std::integral_constant<EnumType, Constants>...>,
+    ::cpp::meta::list<ConstantsNames...>
+>::ValueTable Enum<
+    SourceInfo,
+    EnumType,
+    ::cpp::meta::list<std::integral_constant<EnumType, Constants>...>,
+    ::cpp::meta::list<ConstantsNames...>
+>::_valueTable;
+
 } // namespace meta
 
 namespace codegen
@@ -0,0 +1,745 @@
+#ifndef SIPLASPLAS_REFLECTION_STATIC_PROTOBUF_HPP
+#define SIPLASPLAS_REFLECTION_STATIC_PROTOBUF_HPP
+
+#include "binary.hpp"
+#include "class.hpp"
+#include "field.hpp"
+#include "sourceinfo.hpp"
+#include <siplasplas/utility/meta.hpp>
+#include <siplasplas/utility/exception.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpp
+{
+
+namespace static_reflection
+{
+
+/**
+ * \ingroup static-reflection
+ * \defgroup protobuf-serialization
+ * \brief Protocol buffers wire format serialization of reflected types
+ *
+ * Encodes and decodes reflected classes (See cpp::static_reflection::Class) directly
+ * in the [protocol buffers wire format](https://developers.google.com/protocol-buffers/docs/encoding),
+ * without going through generated protobuf message classes. A reflected class is
+ * encoded as a message with one field per public member object, in declaration order:
+ *
+ *  - Integral values, `bool`, enumerations and `std::chrono` durations (As their
+ *    `count()`) are encoded as varints, the same as `int32`, `int64`, `uint32`,
+ *    `uint64`, `bool` and `enum` protobuf fields. Negative values are sign extended
+ *    to 64 bits. Zigzag (`sint32`, `sint64`) encoding is not supported.
+ *  - `float` and `double` are encoded as `fixed32` and `fixed64` values.
+ *  - Strings and reflected classes are encoded as length delimited `string` and
+ *    embedded message fields.
+ *  - `std::vector` members are encoded as repeated fields, one key per element (The
+ *    proto2 default). Both packed and unpacked repeated scalars are decoded.
+ *
+ * Field numbers are the 1-based declaration index of the member by default, which
+ * matches `.proto` files whose fields are numbered in the order of the C++ class.
+ * Specialize FieldNumbers to assign other numbers.
+ *
+ * All fields are always written, the same as a proto2 message with all its optional
+ * fields set. Unknown fields are skipped when decoding, and fields not found in the
+ * data keep their current value.
+ *
+ * Messages are encoded in two passes, as libprotobuf does: the first pass computes the
+ * size of the message and caches the sizes of its length delimited fields (See SizeCache),
+ * and the second one writes the fields in place, taking the length prefixes from the cache.
+ */
+namespace protobuf
+{
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Protocol buffers wire types
+ */
+enum class WireType : std::uint8_t
+{
+    VARINT           = 0,
+    FIXED64          = 1,
+    LENGTH_DELIMITED = 2,
+    FIXED32          = 5
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Assigns field numbers to the member objects of the class T
+ *
+ * `get(i)` returns the field number of the i-th reflected member object of T.
+ * The default numbers the fields in declaration order, starting from 1. Specialize
+ * it (Usually inheriting from Numbers) to match other `.proto` definitions:
+ *
+ * ``` cpp
+ * template<>
+ * class cpp::static_reflection::protobuf::FieldNumbers<MyMessage> :
+ *     public cpp::static_reflection::protobuf::Numbers<1, 4, 16>
+ * {};
+ * ```
+ */
+template<typename T>
+class FieldNumbers
+{
+public:
+    static constexpr std::uint32_t get(std::size_t index)
+    {
+        return static_cast<std::uint32_t>(index + 1);
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Explicit list of field numbers, in member declaration order. See FieldNumbers
+ */
+template<std::uint32_t... Ns>
+class Numbers
+{
+public:
+    static constexpr std::size_t count = sizeof...(Ns);
+
+    static constexpr std::uint32_t get(std::size_t index)
+    {
+        constexpr std::uint32_t numbers[] = {Ns...};
+        return numbers[index];
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Sizes of the length delimited fields of a message, in the order they are written
+ *
+ * Filled by the size pass of the encoding, and consumed in the same order by the write
+ * pass, so the size of an embedded message is computed once instead of once per
+ * nesting level.
+ */
+class SizeCache
+{
+public:
+    /**
+     * \brief Reserves an entry for the size of the next length delimited value, and
+     * returns its index
+     *
+     * Entries are reserved before computing the size of the value, so the sizes of
+     * nested values follow the size of the value that contains them
+     */
+    std::size_t reserve()
+    {
+        _sizes.push_back(0);
+        return _sizes.size() - 1;
+    }
+
+    /**
+     * \brief Sets the size of a reserved entry
+     */
+    void set(std::size_t index, std::size_t size)
+    {
+        _sizes[index] = size;
+    }
+
+    /**
+     * \brief Returns the next cached size, in reservation order
+     */
+    std::size_t next()
+    {
+        return _sizes[_next++];
+    }
+
+private:
+    std::vector<std::size_t> _sizes;
+    std::size_t _next = 0;
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Implements the encoding of values of type T
+ *
+ * Specializations provide:
+ *  - `static constexpr WireType wireType`: Wire type of the fields of type T.
+ *  - `static std::size_t size(const T&, SizeCache&)`: Size of the encoded value. For
+ *  length delimited values, the size of the payload without the length prefix. Sizes of
+ *  fields of the value go to the cache (See Field).
+ *  - `static char* write(char* out, const T&, SizeCache&)`: Writes the encoded value
+ *  (Again, without the length prefix) and returns the end of the written data. Takes the
+ *  sizes of the fields of the value from the cache.
+ *  - `static void read(binary::Reader&, T&)`: Reads an encoded value. Length delimited
+ *  values are read from a reader of their payload only.
+ *
+ * The primary template implements the encoding of reflected classes as messages.
+ * Specialize it to customize the encoding of a type.
+ */
+template<typename T, typename = void>
+class Codec;
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Implements the encoding of the fields of type T, key included
+ *
+ * The primary template encodes singular fields. Repeated fields are implemented
+ * by the `std::vector` specialization.
+ */
+template<typename T, typename = void>
+class Field;
+
+namespace detail
+{
+
+using Reader = ::cpp::static_reflection::binary::Reader;
+
+constexpr std::uint32_t MaxFieldNumber = (1u << 29) - 1;
+
+constexpr std::size_t varintSize(std::uint64_t value)
+{
+    std::size_t size = 1;
+
+    while(value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+
+    return size;
+}
+
+constexpr std::uint64_t key(std::uint32_t number, WireType wireType)
+{
+    return (static_cast<std::uint64_t>(number) << 3) | static_cast<std::uint64_t>(wireType);
+}
+
+inline char* writeVarint(char* out, std::uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        *out++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+// Fixed size values are little endian regardless of the platform
+inline char* writeFixed(char* out, std::uint64_t value, std::size_t size)
+{
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        *out++ = static_cast<char>(value >> (8 * i));
+    }
+
+    return out;
+}
+
+inline std::uint64_t readFixed(Reader& reader, std::size_t size)
+{
+    unsigned char bytes[8];
+    std::uint64_t value = 0;
+    reader.read(bytes, size);
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+inline Reader readLengthDelimited(Reader& reader)
+{
+    return reader.split(reader.readCount(1));
+}
+
+inline void skipField(Reader& reader, WireType wireType)
+{
+    switch(wireType)
+    {
+    case WireType::VARINT:
+        reader.readVarint(); break;
+    case WireType::FIXED64:
+        reader.skip(8); break;
+    case WireType::LENGTH_DELIMITED:
+        readLengthDelimited(reader); break;
+    case WireType::FIXED32:
+        reader.skip(4); break;
+    default:
+        cpp::Throw<std::runtime_error>(
+            "Invalid protobuf data: unsupported wire type {}",
+            static_cast<unsigned>(wireType)
+        );
+    }
+}
+
+inline void checkWireType(WireType wireType, WireType expected)
+{
+    if(wireType != expected)
+    {
+        cpp::Throw<std::runtime_error>(
+            "Invalid protobuf data: field with wire type {}, expected {}",
+            static_cast<unsigned>(wireType), static_cast<unsigned>(expected)
+        );
+    }
+}
+
+template<typename T, bool IsEnum = std::is_enum<T>::value>
+struct Integer
+{
+    using type = T;
+};
+
+template<typename T>
+struct Integer<T, true>
+{
+    using type = std::underlying_type_t<T>;
+};
+
+template<typename T, std::size_t FieldCount>
+constexpr bool validFieldNumbers()
+{
+    for(std::size_t i = 0; i < FieldCount; ++i)
+    {
+        const std::uint32_t number = FieldNumbers<T>::get(i);
+
+        // 19000 to 19999 are reserved by the protobuf implementation
+        if(number == 0 || number > MaxFieldNumber || (number >= 19000 && number <= 19999))
+        {
+            return false;
+        }
+
+        for(std::size_t j = 0; j < i; ++j)
+        {
+            if(FieldNumbers<T>::get(j) == number)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template<typename T, typename Fields, typename Indices>
+class MessageFields;
+
+template<typename T, typename... Fields, std::size_t... Is>
+class MessageFields<T, ::cpp::meta::list<Fields...>, std::index_sequence<Is...>>
+{
+public:
+    static_assert(validFieldNumbers<T, sizeof...(Fields)>(),
+        "Invalid protobuf field numbers. Field numbers must be unique, between 1 and 2^29 - 1, "
+        "and out of the 19000-19999 reserved range");
+
+    static std::size_t size(const T& message, SizeCache& cache)
+    {
+        std::size_t result = 0;
+
+        (void)std::initializer_list<int>{0, (
+            result += Field<typename Fields::decay_t>::size(FieldNumbers<T>::get(Is), Fields::get(message), cache), 0
+        )...};
+
+        return result;
+    }
+
+    static char* write(char* out, const T& message, SizeCache& cache)
+    {
+        (void)std::initializer_list<int>{0, (
+            out = Field<typename Fields::decay_t>::write(out, FieldNumbers<T>::get(Is), Fields::get(message), cache), 0
+        )...};
+
+        return out;
+    }
+
+    static void read(Reader& reader, T& message)
+    {
+        while(reader.remaining() > 0)
+        {
+            const std::uint64_t key = reader.readVarint();
+            const std::uint64_t number = key >> 3;
+            const auto wireType = static_cast<WireType>(key & 0x7);
+            bool found = false;
+
+            (void)std::initializer_list<int>{0, (
+                (!found && number == FieldNumbers<T>::get(Is)) ?
+                    (Field<typename Fields::decay_t>::read(reader, wireType, Fields::get(message)), found = true, 0) :
+                    0
+            )...};
+
+            if(!found)
+            {
+                skipField(reader, wireType);
+            }
+        }
+    }
+};
+
+}
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes reflected classes as messages with their public member objects as fields
+ */
+template<typename T, typename>
+class Codec
+{
+    using Fields = typename ::cpp::static_reflection::Class<T>::Fields;
+    using MessageFields = detail::MessageFields<T, Fields, std::make_index_sequence<Fields::size>>;
+
+    static_assert(std::is_class<T>::value,
+        "Protobuf serialization is not supported for this type");
+    static_assert(
+        !std::is_same<typename ::cpp::static_reflection::Class<T>::SourceInfo, meta::EmptySourceInfo<T>>::value ||
+        !std::is_same<Fields, ::cpp::meta::list<>>::value,
+        "Protobuf serialization of a class requires its static reflection information. "
+        "Include the reflection header of the class, or specialize cpp::static_reflection::protobuf::Codec"
+    );
+
+public:
+    static constexpr WireType wireType = WireType::LENGTH_DELIMITED;
+
+    static std::size_t size(const T& message, SizeCache& cache)
+    {
+        return MessageFields::size(message, cache);
+    }
+
+    static char* write(char* out, const T& message, SizeCache& cache)
+    {
+        return MessageFields::write(out, message, cache);
+    }
+
+    static void read(detail::Reader& reader, T& message)
+    {
+        MessageFields::read(reader, message);
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes integral, boolean and enumeration values as varints
+ */
+template<typename T>
+class Codec<T, std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+{
+    using Integer = typename detail::Integer<T>::type;
+
+    static std::uint64_t toVarint(const T& value)
+    {
+        // Negative values are sign extended to 64 bits, as protobuf does
+        // with int32 fields
+        return std::is_signed<Integer>::value ?
+            static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<Integer>(value))) :
+            static_cast<std::uint64_t>(static_cast<Integer>(value));
+    }
+
+public:
+    static constexpr WireType wireType = WireType::VARINT;
+
+    static std::size_t size(const T& value, SizeCache&)
+    {
+        return detail::varintSize(toVarint(value));
+    }
+
+    static char* write(char* out, const T& value, SizeCache&)
+    {
+        return detail::writeVarint(out, toVarint(value));
+    }
+
+    static void read(detail::Reader& reader, T& value)
+    {
+        value = static_cast<T>(static_cast<Integer>(reader.readVarint()));
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes floating point values as fixed32 (float) and fixed64 (double) values
+ */
+template<typename T>
+class Codec<T, std::enable_if_t<std::is_same<T, float>::value || std::is_same<T, double>::value>>
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    static_assert(sizeof(T) == sizeof(Bits), "Unsupported floating point representation");
+
+public:
+    static constexpr WireType wireType = (sizeof(T) == 4) ? WireType::FIXED32 : WireType::FIXED64;
+
+    static std::size_t size(const T&, SizeCache&)
+    {
+        return sizeof(T);
+    }
+
+    static char* write(char* out, const T& value, SizeCache&)
+    {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return detail::writeFixed(out, bits, sizeof(T));
+    }
+
+    static void read(detail::Reader& reader, T& value)
+    {
+        const auto bits = static_cast<Bits>(detail::readFixed(reader, sizeof(T)));
+        std::memcpy(&value, &bits, sizeof(T));
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes durations as the varint of their tick count
+ */
+template<typename Rep, typename Period>
+class Codec<std::chrono::duration<Rep, Period>>
+{
+    using Duration = std::chrono::duration<Rep, Period>;
+
+public:
+    static constexpr WireType wireType = Codec<Rep>::wireType;
+
+    static std::size_t size(const Duration& duration, SizeCache& cache)
+    {
+        return Codec<Rep>::size(duration.count(), cache);
+    }
+
+    static char* write(char* out, const Duration& duration, SizeCache& cache)
+    {
+        return Codec<Rep>::write(out, duration.count(), cache);
+    }
+
+    static void read(detail::Reader& reader, Duration& duration)
+    {
+        Rep count{};
+        Codec<Rep>::read(reader, count);
+        duration = Duration{count};
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes strings as length delimited values
+ */
+template<typename Traits, typename Allocator>
+class Codec<std::basic_string<char, Traits, Allocator>>
+{
+    using String = std::basic_string<char, Traits, Allocator>;
+
+public:
+    static constexpr WireType wireType = WireType::LENGTH_DELIMITED;
+
+    static std::size_t size(const String& string, SizeCache&)
+    {
+        return string.size();
+    }
+
+    static char* write(char* out, const String& string, SizeCache&)
+    {
+        std::memcpy(out, string.data(), string.size());
+        return out + string.size();
+    }
+
+    static void read(detail::Reader& reader, String& string)
+    {
+        string.resize(reader.remaining());
+        reader.read(&string[0], string.size());
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes singular fields as their key followed by their value
+ *
+ * The sizes of length delimited values are cached by size() and
+ * reused by write() for the length prefix.
+ */
+template<typename T, typename>
+class Field
+{
+    static constexpr bool lengthDelimited = Codec<T>::wireType == WireType::LENGTH_DELIMITED;
+
+    static std::size_t valueSize(const T& value, SizeCache& cache, std::true_type)
+    {
+        const std::size_t index = cache.reserve();
+        const std::size_t size = Codec<T>::size(value, cache);
+        cache.set(index, size);
+
+        return detail::varintSize(size) + size;
+    }
+
+    static std::size_t valueSize(const T& value, SizeCache& cache, std::false_type)
+    {
+        return Codec<T>::size(value, cache);
+    }
+
+public:
+    static std::size_t size(std::uint32_t number, const T& value, SizeCache& cache)
+    {
+        return detail::varintSize(detail::key(number, Codec<T>::wireType)) +
+               valueSize(value, cache, std::integral_constant<bool, lengthDelimited>());
+    }
+
+    static char* write(char* out, std::uint32_t number, const T& value, SizeCache& cache)
+    {
+        out = detail::writeVarint(out, detail::key(number, Codec<T>::wireType));
+
+        if(lengthDelimited)
+        {
+            out = detail::writeVarint(out, cache.next());
+        }
+
+        return Codec<T>::write(out, value, cache);
+    }
+
+    static void read(detail::Reader& reader, WireType wireType, T& value)
+    {
+        detail::checkWireType(wireType, Codec<T>::wireType);
+
+        if(lengthDelimited)
+        {
+            detail::Reader payload = detail::readLengthDelimited(reader);
+            Codec<T>::read(payload, value);
+        }
+        else
+        {
+            Codec<T>::read(reader, value);
+        }
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Encodes vectors as repeated fields
+ *
+ * Elements are written unpacked, one key per element. Repeated scalars are
+ * read both packed and unpacked.
+ */
+template<typename T, typename Allocator>
+class Field<std::vector<T, Allocator>>
+{
+    using Vector = std::vector<T, Allocator>;
+
+public:
+    static std::size_t size(std::uint32_t number, const Vector& vector, SizeCache& cache)
+    {
+        std::size_t result = 0;
+
+        for(const auto& element : vector)
+        {
+            result += Field<T>::size(number, element, cache);
+        }
+
+        return result;
+    }
+
+    static char* write(char* out, std::uint32_t number, const Vector& vector, SizeCache& cache)
+    {
+        for(const auto& element : vector)
+        {
+            out = Field<T>::write(out, number, element, cache);
+        }
+
+        return out;
+    }
+
+    static void read(detail::Reader& reader, WireType wireType, Vector& vector)
+    {
+        if(wireType == WireType::LENGTH_DELIMITED && Codec<T>::wireType != WireType::LENGTH_DELIMITED)
+        {
+            detail::Reader payload = detail::readLengthDelimited(reader);
+
+            while(payload.remaining() > 0)
+            {
+                T element{};
+                Codec<T>::read(payload, element);
+                vector.push_back(std::move(element));
+            }
+        }
+        else
+        {
+            T element{};
+            Field<T>::read(reader, wireType, element);
+            vector.push_back(std::move(element));
+        }
+    }
+};
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Returns the size of the encoded message
+ */
+template<typename T>
+std::size_t byteSize(const T& message)
+{
+    SizeCache cache;
+    return Codec<T>::size(message, cache);
+}
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Appends the encoded message to the given buffer
+ *
+ * The size of the message is computed first, so the buffer grows only once
+ * and fields are written in place. Embedded message sizes are computed once,
+ * in the size pass.
+ */
+template<typename T>
+void serialize(const T& message, std::vector<char>& buffer)
+{
+    SizeCache cache;
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + Codec<T>::size(message, cache));
+    Codec<T>::write(buffer.data() + offset, message, cache);
+}
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Returns a buffer with the encoded message
+ */
+template<typename T>
+std::vector<char> serialize(const T& message)
+{
+    std::vector<char> buffer;
+    serialize(message, buffer);
+    return buffer;
+}
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Reads an encoded message, merging its fields into the given object
+ *
+ * \param data Pointer to the encoded message
+ * \param size Size in bytes of the encoded message. The whole range is read
+ * \param message Object the fields are read into
+ *
+ * \throws std::runtime_error If the data is truncated or corrupt
+ */
+template<typename T>
+void deserialize(const void* data, std::size_t size, T& message)
+{
+    detail::Reader reader{data, size};
+    Codec<T>::read(reader, message);
+}
+
+/**
+ * \ingroup protobuf-serialization
+ * \brief Returns the message encoded in the given buffer
+ *
+ * \throws std::runtime_error If the data is truncated or corrupt
+ */
+template<typename T>
+T deserialize(const std::vector<char>& buffer)
+{
+    T message{};
+    deserialize(buffer.data(), buffer.size(), message);
+    return message;
+}
+
+}
+
+}
+
+}
+
+#endif // SIPLASPLAS_REFLECTION_STATIC_PROTOBUF_HPP
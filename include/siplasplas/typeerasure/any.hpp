@@ -5,6 +5,8 @@
 #include "function.hpp"
 #include "field.hpp"
 #include <siplasplas/utility/hash.hpp>
+#include <memory>
+#include <string>
 
 namespace cpp
 {
@@ -33,6 +35,11 @@ namespace cpp
  * The behavior is undefined if the user access a method or attribute the any object
  * doesn't have
  *
+ * Objects of the same class usually have the same methods. Instead of assigning
+ * each method to each object, a method table can be built once and shared by many
+ * objects (See setMethods()). Methods assigned to an object shadow the shared ones
+ * for that object only.
+ *
  * \tparam Storage Storage for the type erased object
  * \tparam FunctionsStorage Storage for the type erased methods. `Storage` by default
  * \tparam FunctionArgsStorage Storage for the type erased method call arguments. `FunctionsStorage` by default
@@ -52,6 +59,7 @@ public:
 
     using Method = cpp::typeerasure::Function<FunctionsStorage, FunctionArgsStorage>;
     using Attribute = cpp::typeerasure::Field<AttributesStorage>;
+    using Methods = cpp::HashTable<std::string, Method>;
 
     template<typename Class, typename... Args>
     static Any create(Args&&... args)
@@ -64,41 +72,73 @@ public:
     public:
         MethodProxy(Method& method, Any* this_) :
             _method{&method},
+            _shared{nullptr},
             _this{this_}
         {}
 
+        // name is the key of the method in the shared table, so it
+        // lives as long as the table and doesn't need to be copied
+        MethodProxy(const Method& shared, Any* this_, const std::string& name) :
+            _method{nullptr},
+            _shared{&shared},
+            _this{this_},
+            _name{&name}
+        {}
+
         template<typename... Args>
         auto operator()(Args&&... args)
         {
-            return (*_method)(_this->getReference(), std::forward<Args>(args)...);
+            return current()(_this->getReference(), std::forward<Args>(args)...);
         }
 
         template<typename... Args>
         auto operator()(Args&&... args) const
         {
-            return (*_method)(_this->getReference(), std::forward<Args>(args)...);
+            return current()(_this->getReference(), std::forward<Args>(args)...);
         }
 
         template<typename Callable>
         MethodProxy& operator=(Callable&& callable)
         {
+            if(_method == nullptr)
+            {
+                _method = &_this->_methods[*_name];
+            }
+
             *_method = std::forward<Callable>(callable);
             return *this;
         }
 
         const Method& method() const
         {
-            return *_method;
+            return current();
         }
 
+        /**
+         * \brief Returns the method. If the method comes from a shared method
+         * table, it's copied to the object first, so the shared table is never
+         * modified through the object
+         */
         Method& method()
         {
+            if(_method == nullptr)
+            {
+                _method = &(_this->_methods[*_name] = *_shared);
+            }
+
             return *_method;
         }
 
     private:
         Method* _method;
+        const Method* _shared;
         Any* _this;
+        const std::string* _name;
+
+        const Method& current() const
+        {
+            return (_method != nullptr) ? *_method : *_shared;
+        }
     };
 
     class ConstMethodProxy
@@ -236,6 +276,23 @@ public:
      */
     MethodProxy operator()(const std::string& name)
     {
+        if(_sharedMethods != nullptr)
+        {
+            auto it = _methods.find(name);
+
+            if(it != _methods.end() && !it->second.empty())
+            {
+                return {it->second, this};
+            }
+
+            auto shared = _sharedMethods->find(name);
+
+            if(shared != _sharedMethods->end())
+            {
+                return {shared->second, this, shared->first};
+            }
+        }
+
         return {_methods[name], this};
     }
 
@@ -251,7 +308,7 @@ public:
     ConstMethodProxy operator()(const std::string& name) const
     {
         SIPLASPLAS_ASSERT(hasMethod(name))("Class {} has no method named '{}'", Base::typeInfo().typeName(), name);
-        return {_methods[name], this};
+        return {*findMethod(name), this};
     }
 
     AttributeProxy operator[](const std::string& name)
@@ -274,16 +331,30 @@ public:
      */
     bool hasMethod(const std::string& name) const
     {
-        auto it = _methods.find(name);
+        const Method* method = findMethod(name);
+        return method != nullptr && !method->empty();
+    }
 
-        if(it != _methods.end())
-        {
-            return !it->second.empty();
-        }
-        else
-        {
-            return false;
-        }
+    /**
+     * \brief Shares a method table with the object
+     *
+     * The methods of the table are available through operator()(const std::string&) as if
+     * they were assigned to the object, but the table is not copied. Methods assigned to the
+     * object afterwards take precedence over the shared ones, and never modify the table.
+     *
+     * \param methods Method table. Can be null, to stop sharing a table
+     */
+    void setMethods(std::shared_ptr<const Methods> methods)
+    {
+        _sharedMethods = std::move(methods);
+    }
+
+    /**
+     * \brief Returns the method table shared by the object, if any (See setMethods())
+     */
+    const std::shared_ptr<const Methods>& sharedMethods() const
+    {
+        return _sharedMethods;
     }
 
     /**
@@ -324,8 +395,32 @@ public:
     }
 
 private:
-    cpp::HashTable<std::string, Method> _methods;
+    Methods _methods;
+    std::shared_ptr<const Methods> _sharedMethods;
     cpp::HashTable<std::string, Attribute> _attributes;
+
+    // Methods assigned to the object first, then the shared ones
+    const Method* findMethod(const std::string& name) const
+    {
+        auto it = _methods.find(name);
+
+        if(it != _methods.end() && !it->second.empty())
+        {
+            return &it->second;
+        }
+
+        if(_sharedMethods != nullptr)
+        {
+            auto shared = _sharedMethods->find(name);
+
+            if(shared != _sharedMethods->end())
+            {
+                return &shared->second;
+            }
+        }
+
+        return nullptr;
+    }
 };
 
 /**
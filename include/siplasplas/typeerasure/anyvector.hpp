@@ -0,0 +1,406 @@
+#ifndef SIPLASPLAS_TYPEERASURE_ANYVECTOR_HPP
+#define SIPLASPLAS_TYPEERASURE_ANYVECTOR_HPP
+
+#include "simpleany.hpp"
+#include <siplasplas/utility/assert.hpp>
+#include <siplasplas/utility/memory_manip.hpp>
+#include <siplasplas/typeerasure/export.hpp>
+#include <algorithm>
+#include <type_traits>
+
+namespace cpp
+{
+
+namespace detail
+{
+
+template<typename T>
+class IsSimpleAny : public std::false_type {};
+
+template<typename Storage>
+class IsSimpleAny<::cpp::SimpleAny<Storage>> : public std::true_type {};
+
+}
+
+/**
+ * \ingroup type-erasure
+ * \brief Implements a type-erased contiguous container of values of
+ * the same type
+ *
+ * AnyVector is the homogeneous counterpart of `std::vector<cpp::SimpleAny32>`:
+ * Instead of storing a type-erased value (with its own TypeInfo and storage)
+ * per element, the AnyVector stores a single cpp::typeerasure::TypeInfo with
+ * the type of the elements and a tightly packed buffer aligned to the type
+ * boundary. Elements are laid out exactly as in a `T[]` array.
+ *
+ * Construction, copy, relocation, and destruction of elements are done in bulk through the
+ * TypeInfo value semantics operations. Trivially copyable types are copied and relocated
+ * with `std::memcpy()`, and trivially destructible types skip the destruction loop.
+ *
+ * ``` cpp
+ * auto vector = cpp::AnyVector::create<std::string>();
+ * vector.push_back("hello"s);
+ * vector.push_back(cpp::SimpleAny32{"world"s}); // Copied from the any storage
+ *
+ * for(std::size_t i = 0; i < vector.size(); ++i)
+ * {
+ *     cpp::ReferenceSimpleAny element = vector[i]; // Type-erased view of the i-th element
+ *     std::cout << element.get<std::string>() << std::endl;
+ * }
+ *
+ * std::string* strings = vector.data<std::string>(); // Typed access to the packed buffer
+ * ```
+ *
+ * Accessing the elements with a type different from the type of the vector has
+ * undefined behavior.
+ */
+class SIPLASPLAS_TYPEERASURE_EXPORT AnyVector
+{
+public:
+    /**
+     * \brief Creates an empty vector of elements of the given type
+     *
+     * \param typeInfo Type of the elements
+     */
+    AnyVector(const cpp::typeerasure::TypeInfo& typeInfo);
+
+    /**
+     * \brief Creates a vector with \p count default constructed elements
+     * of the given type
+     *
+     * The behavior is undefined if the type is not default constructible
+     *
+     * \param typeInfo Type of the elements
+     * \param count Number of elements
+     */
+    AnyVector(const cpp::typeerasure::TypeInfo& typeInfo, std::size_t count);
+
+    /**
+     * \brief Creates a vector of elements of type T
+     *
+     * \tparam T Type of the elements
+     * \param count Number of default constructed elements. Zero by default
+     */
+    template<typename T>
+    static AnyVector create(std::size_t count = 0)
+    {
+        return AnyVector{cpp::typeerasure::TypeInfo::get<T>(), count};
+    }
+
+    AnyVector(const AnyVector& other);
+    AnyVector(AnyVector&& other);
+    AnyVector& operator=(const AnyVector& other);
+    AnyVector& operator=(AnyVector&& other);
+    ~AnyVector();
+
+    /**
+     * \brief Returns the type information of the elements
+     */
+    cpp::typeerasure::TypeInfo typeInfo() const
+    {
+        return _typeInfo;
+    }
+
+    /**
+     * \brief Checks if the elements are of type T
+     *
+     * \returns True if the type of the elements is **exactly** T, false otherwise
+     */
+    template<typename T>
+    bool hasType() const
+    {
+        return cpp::typeerasure::TypeInfo::get<T>() == _typeInfo;
+    }
+
+    /**
+     * \brief Returns the number of elements in the vector
+     */
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * \brief Returns the number of elements that can be held without
+     * reallocating the buffer
+     */
+    std::size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+     * \brief Checks whether the vector has no elements
+     */
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * \brief Returns the distance in bytes between two consecutive elements
+     */
+    std::size_t stride() const
+    {
+        return _typeInfo.sizeOf();
+    }
+
+    /**
+     * \brief Returns a pointer to the beginning of the buffer
+     */
+    void* data()
+    {
+        return _data;
+    }
+
+    /**
+     * \brief Returns a pointer to the beginning of the buffer
+     */
+    const void* data() const
+    {
+        return _data;
+    }
+
+    /**
+     * \brief Returns a typed pointer to the beginning of the buffer
+     *
+     * \tparam T Type of the elements. The behavior is undefined if T
+     * is not the type of the elements
+     */
+    template<typename T>
+    T* data()
+    {
+        SIPLASPLAS_ASSERT(hasType<T>())("AnyVector has elements of type {}, requested {} instead",
+            _typeInfo.typeName(), ctti::type_id<T>().name());
+        return reinterpret_cast<T*>(_data);
+    }
+
+    /**
+     * \brief Returns a typed pointer to the beginning of the buffer
+     *
+     * \tparam T Type of the elements. The behavior is undefined if T
+     * is not the type of the elements
+     */
+    template<typename T>
+    const T* data() const
+    {
+        SIPLASPLAS_ASSERT(hasType<T>())("AnyVector has elements of type {}, requested {} instead",
+            _typeInfo.typeName(), ctti::type_id<T>().name());
+        return reinterpret_cast<const T*>(_data);
+    }
+
+    /**
+     * \brief Returns the address of the i-th element
+     */
+    void* at(std::size_t i)
+    {
+        SIPLASPLAS_ASSERT_LT(i, _size);
+        return _data + i*stride();
+    }
+
+    /**
+     * \brief Returns the address of the i-th element
+     */
+    const void* at(std::size_t i) const
+    {
+        SIPLASPLAS_ASSERT_LT(i, _size);
+        return _data + i*stride();
+    }
+
+    /**
+     * \brief Returns a type-erased reference to the i-th element
+     */
+    cpp::ReferenceSimpleAny operator[](std::size_t i)
+    {
+        return {at(i), _typeInfo};
+    }
+
+    /**
+     * \brief Returns a type-erased const reference to the i-th element
+     */
+    cpp::ConstReferenceSimpleAny operator[](std::size_t i) const
+    {
+        return {at(i), _typeInfo};
+    }
+
+    /**
+     * \brief Returns a reference to the i-th element
+     *
+     * \tparam T Type of the elements. The behavior is undefined if T
+     * is not the type of the elements
+     */
+    template<typename T>
+    T& get(std::size_t i)
+    {
+        SIPLASPLAS_ASSERT_LT(i, _size);
+        return data<T>()[i];
+    }
+
+    /**
+     * \brief Returns a const reference to the i-th element
+     *
+     * \tparam T Type of the elements. The behavior is undefined if T
+     * is not the type of the elements
+     */
+    template<typename T>
+    const T& get(std::size_t i) const
+    {
+        SIPLASPLAS_ASSERT_LT(i, _size);
+        return data<T>()[i];
+    }
+
+    /**
+     * \brief Constructs a new element in-place at the end of the vector
+     *
+     * \tparam T Type of the elements. The behavior is undefined if T
+     * is not the type of the elements
+     * \param args Element constructor arguments
+     */
+    template<typename T, typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        SIPLASPLAS_ASSERT(hasType<T>())("AnyVector has elements of type {}, cannot insert a {}",
+            _typeInfo.typeName(), ctti::type_id<T>().name());
+        constructBack([&](void* where)
+        {
+            features::Constructible::apply<T>(where, std::forward<Args>(args)...);
+        });
+    }
+
+    /**
+     * \brief Inserts a value at the end of the vector
+     *
+     * The value is copied or moved into the vector depending on its value category.
+     * Arrays (Such as string literals) are rejected, since they would be stored as
+     * the decayed pointer. Pass an `std::string` to store strings
+     *
+     * \param value Value to insert. The behavior is undefined if the type of the value
+     * is not the type of the elements
+     */
+    template<typename T, typename = std::enable_if_t<
+        !detail::IsSimpleAny<std::decay_t<T>>::value
+    >>
+    void push_back(T&& value)
+    {
+        static_assert(!std::is_array<std::remove_reference_t<T>>::value,
+            "AnyVector::push_back() does not take arrays, the vector would store a pointer "
+            "to the first element. Use std::string for string literals");
+        emplace_back<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    /**
+     * \brief Inserts a copy of a type-erased value at the end of the vector
+     *
+     * \param value Value to insert. The behavior is undefined if the type of the value
+     * is not the type of the elements
+     */
+    void push_back(const cpp::ConstReferenceSimpleAny& value);
+
+    /**
+     * \brief Inserts a copy of a type-erased value at the end of the vector
+     *
+     * \param value Value to insert. The behavior is undefined if the type of the value
+     * is not the type of the elements
+     */
+    void push_back(const cpp::ReferenceSimpleAny& value);
+
+    /**
+     * \brief Inserts a copy of a type-erased value at the end of the vector
+     *
+     * \param value Value to insert. The behavior is undefined if the type of the value
+     * is not the type of the elements
+     */
+    template<typename Storage>
+    void push_back(const cpp::SimpleAny<Storage>& value)
+    {
+        push_back(value.getReference());
+    }
+
+    /**
+     * \brief Default constructs a new element at the end of the vector
+     *
+     * \returns A type-erased reference to the new element
+     */
+    cpp::ReferenceSimpleAny emplace_back();
+
+    /**
+     * \brief Destroys the last element of the vector
+     */
+    void pop_back();
+
+    /**
+     * \brief Resizes the vector, destroying the elements past the new size or
+     * default constructing the new ones
+     *
+     * \param count New number of elements
+     */
+    void resize(std::size_t count);
+
+    /**
+     * \brief Ensures the buffer has space for at least \p count elements
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * \brief Destroys all the elements. The capacity of the vector is not changed
+     */
+    void clear();
+
+    /**
+     * \brief Swaps the contents (elements and type) of two vectors
+     */
+    void swap(AnyVector& other);
+
+private:
+    cpp::typeerasure::TypeInfo _typeInfo;
+    char* _data;
+    std::size_t _size;
+    std::size_t _capacity;
+
+    bool triviallyCopyable() const;
+    bool triviallyDestructible() const;
+
+    // Constructs the next element with construct(address). If there's no space
+    // left, the element is constructed in the new buffer before the current
+    // elements are moved there, so it can be constructed from one of them
+    template<typename Construct>
+    void constructBack(const Construct& construct)
+    {
+        if(_size < _capacity)
+        {
+            construct(_data + _size*stride());
+        }
+        else
+        {
+            const std::size_t capacity = std::max<std::size_t>(2*_capacity, 1);
+            char* data = allocate(capacity);
+
+            try
+            {
+                construct(data + _size*stride());
+            }
+            catch(...)
+            {
+                cpp::detail::aligned_free(data);
+                throw;
+            }
+
+            adopt(data, capacity);
+        }
+
+        ++_size;
+    }
+
+    char* allocate(std::size_t capacity) const;
+    // Moves the elements to the given buffer, and frees the current one
+    void adopt(char* data, std::size_t capacity);
+    void reallocate(std::size_t capacity);
+
+    void copyConstruct(char* where, const char* other, std::size_t count) const;
+    void relocate(char* where, char* other, std::size_t count) const;
+    void destroy(char* where, std::size_t count) const;
+};
+
+}
+
+#endif // SIPLASPLAS_TYPEERASURE_ANYVECTOR_HPP
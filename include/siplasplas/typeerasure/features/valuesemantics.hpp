@@ -225,9 +225,9 @@ class Assignable
 {
 public:
     template<typename T, typename U>
-    static decltype(auto) apply(T& lvalue, U&& value) noexcept(concepts::Assignable<T, std::decay_t<U>>::no_except)
+    static decltype(auto) apply(T& lvalue, U&& value) noexcept(concepts::Assignable<T&, U&&>::no_except)
     {
-        return cpp::staticIf<concepts::Assignable<T, std::decay_t<U>>::value>([](auto identity, T& lvalue, auto&& value)
+        return cpp::staticIf<concepts::Assignable<T&, U&&>::value>([](auto identity, T& lvalue, auto&& value)
         {
             return identity(lvalue) = std::forward<decltype(value)>(value);
         }, lvalue, std::forward<U>(value)).Else([](auto) -> T&
@@ -241,13 +241,13 @@ public:
     }
 
     template<typename T, typename U>
-    static decltype(auto) apply(T* where, U&& value) noexcept(concepts::Assignable<T, std::decay_t<U>>::no_except)
+    static decltype(auto) apply(T* where, U&& value) noexcept(concepts::Assignable<T&, U&&>::no_except)
     {
         return apply<T>(*where, std::forward<U>(value));
     }
 
     template<typename T, typename U>
-    static decltype(auto) apply(void* where, U&& value) noexcept(concepts::Assignable<T, std::decay_t<U>>::no_except)
+    static decltype(auto) apply(void* where, U&& value) noexcept(concepts::Assignable<T&, U&&>::no_except)
     {
         return apply<T>(reinterpret_cast<T*>(where), std::forward<U>(value));
     }
@@ -164,6 +164,20 @@ public:
         return _invoke(object.getReference());
     }
 
+    /**
+     * \brief Returns the value of the member object of a given
+     * type-erased reference to an object
+     *
+     * The behavior is undefined if the referenced object is not of the same class
+     * the stored member object pointer belongs to, or if the Field object is empty.
+     *
+     * \returns A type-erased reference to the member object in the referenced object
+     */
+    decltype(auto) get(const cpp::ReferenceSimpleAny& object) const
+    {
+        return _invoke(object);
+    }
+
     /**
      * \brief Returns the value of the member object of a given
      * type erased object
@@ -3,6 +3,7 @@
 
 #include "simpleany.hpp"
 #include "anyarg.hpp"
+#include "anyvector.hpp"
 #include "invoke.hpp"
 #include "anystorage/deadpool.hpp"
 #include "anystorage/fixedsize.hpp"
@@ -10,6 +11,8 @@
 #include <siplasplas/utility/staticif.hpp>
 #include <siplasplas/utility/compiles.hpp>
 #include <siplasplas/utility/exception.hpp>
+#include <siplasplas/utility/memory_manip.hpp>
+#include <vector>
 
 namespace cpp
 {
@@ -17,6 +20,25 @@ namespace cpp
 namespace typeerasure
 {
 
+namespace detail
+{
+
+/**
+ * \ingroup type-erasure
+ * \brief Returns the number of bytes a cpp::typeerasure::Function with the given
+ * storage policy hosts inline. Callables that don't fit are dynamically allocated
+ */
+template<typename Storage>
+class FunctionInlineCapacity : public std::integral_constant<std::size_t, sizeof(Storage)> {};
+
+template<std::size_t Size, std::size_t Alignment>
+class FunctionInlineCapacity<DeadPoolStorage<Size, Alignment>> : public std::integral_constant<std::size_t, Size> {};
+
+template<std::size_t Size, std::size_t Alignment>
+class FunctionInlineCapacity<FixedSizeStorage<Size, Alignment>> : public std::integral_constant<std::size_t, Size> {};
+
+}
+
 /**
  * \ingroup type-erasure
  * \brief Stores a type-erased callable of any signature and kind
@@ -50,6 +72,13 @@ namespace typeerasure
  *
  * Invoking a Function objects with the wrong arguments has undefined behavior
  *
+ * Like `std::function`, the callable is hosted in a small inline buffer (With the capacity
+ * of the `Storage` policy, see detail::FunctionInlineCapacity) and falls back to dynamic
+ * allocation if it doesn't fit. Calls go through a thunk function pointer stored in the
+ * Function object, which unpacks the arguments and invokes the concrete callable directly.
+ * Less frequent operations (Copy, move, invocation with vectors of arguments, etc) are
+ * dispatched through a static per-callable table.
+ *
  * \tparam Storage Storage for the hosted callable
  * \tparam ArgsStorage Storage for type-erased call arguments
  * \tparam ReturnStorage Storage for the return value
@@ -58,8 +87,23 @@ template<typename Storage, typename ArgsStorage = Storage, typename ReturnStorag
 class Function
 {
 public:
-    Function() = default;
-    Function(const Function&) = default;
+    Function() :
+        _invoke{nullptr},
+        _invokeConst{nullptr},
+        _thunks{nullptr}
+    {}
+
+    Function(const Function& other) :
+        Function{}
+    {
+        copy(other);
+    }
+
+    Function(Function&& other) :
+        Function{}
+    {
+        move(other);
+    }
 
     /**
      * \brief Constructs a Function from a Callable object
@@ -75,15 +119,20 @@ public:
         !std::is_same<std::decay_t<Callable>, Function>::value
     >>
     Function(Callable&& callable) :
-        _invoke{Invoke<std::decay_t<Callable>>{std::forward<Callable>(callable)}}
+        Function{meta::identity<std::decay_t<Callable>>(), std::forward<Callable>(callable)}
     {}
 
+    ~Function()
+    {
+        reset();
+    }
+
     /**
      * \brief Checks if the object is empty (No callable assigned)
      */
     bool empty() const
     {
-        return _invoke.empty();
+        return _thunks == nullptr;
     }
 
     /**
@@ -116,7 +165,7 @@ public:
         SIPLASPLAS_ASSERT_FALSE(empty());
 
         AnyArg argsArray[] = {std::forward<Args>(args)..., AnyArg(nullptr)};
-        return _invoke.template get<InvokeInterface>().invoke(std::begin(argsArray));
+        return _invoke(&_callable, std::begin(argsArray));
     }
 
     /**
@@ -135,7 +184,7 @@ public:
         SIPLASPLAS_ASSERT_FALSE(empty());
 
         AnyArg argsArray[] = {std::forward<Args>(args)..., AnyArg(nullptr)};
-        return _invoke.template get<InvokeInterface>().invoke(std::begin(argsArray));
+        return _invokeConst(&_callable, std::begin(argsArray));
     }
 
     /**
@@ -151,7 +200,7 @@ public:
     {
         SIPLASPLAS_ASSERT_FALSE(empty());
 
-        return _invoke.template get<InvokeInterface>().invoke(std::forward<ArgsVector>(args));
+        return invokeWith(std::forward<ArgsVector>(args));
     }
 
     /**
@@ -167,7 +216,7 @@ public:
     {
         SIPLASPLAS_ASSERT_FALSE(empty());
 
-        return _invoke.template get<InvokeInterface>().invoke(std::forward<ArgsVector>(args));
+        return invokeWith(std::forward<ArgsVector>(args));
     }
 
     /**
@@ -182,7 +231,7 @@ public:
     {
         SIPLASPLAS_ASSERT_FALSE(empty());
 
-        return _invoke.template get<InvokeInterface>().invoke(args);
+        return _invoke(&_callable, args);
     }
 
     /**
@@ -197,11 +246,169 @@ public:
     {
         SIPLASPLAS_ASSERT_FALSE(empty());
 
-        return _invoke.template get<InvokeInterface>().invoke(args);
+        return _invokeConst(&_callable, args);
+    }
+
+    /**
+     * \brief Invokes the callable constructing the return value directly
+     * in caller provided storage
+     *
+     * Unlike invoke(), no intermediary SimpleAny is created, so callers
+     * that store the result elsewhere (or call the function in a loop
+     * reusing the same storage) avoid any allocation of the return value.
+     *
+     * \param result Pointer to uninitialized storage suitable for an object
+     * of the return type. The caller is responsible of destroying the
+     * constructed object. Ignored if the callable returns void
+     * \param resultType Type of the object to construct. Must be the decayed
+     * return type of the callable (See returnType())
+     * \param args Pointer to the sequence of arguments
+     */
+    void invokeInto(void* result, const cpp::typeerasure::TypeInfo& resultType, AnyArg* args)
+    {
+        checkResultType(resultType);
+        _thunks->constructInto(&_callable, result, args);
+    }
+
+    /**
+     * \brief Invokes the callable constructing the return value directly
+     * in caller provided storage
+     *
+     * See invokeInto(void*, const cpp::typeerasure::TypeInfo&, AnyArg*)
+     */
+    void invokeInto(void* result, const cpp::typeerasure::TypeInfo& resultType, AnyArg* args) const
+    {
+        checkResultType(resultType);
+        _thunks->constructIntoConst(&_callable, result, args);
+    }
+
+    /**
+     * \brief Invokes the callable assigning the return value to an
+     * existing object
+     *
+     * \param result Reference to the object that will be assigned the
+     * return value. Its type must be the decayed return type of the callable
+     * (See returnType()). Ignored if the callable returns void
+     * \param args Pointer to the sequence of arguments
+     */
+    void invokeInto(const cpp::ReferenceSimpleAny& result, AnyArg* args)
+    {
+        checkResultType(result.typeInfo());
+        _thunks->assignInto(&_callable, result.getStorage().storage(result.typeInfo()), args);
+    }
+
+    /**
+     * \brief Invokes the callable assigning the return value to an
+     * existing object
+     *
+     * See invokeInto(const cpp::ReferenceSimpleAny&, AnyArg*)
+     */
+    void invokeInto(const cpp::ReferenceSimpleAny& result, AnyArg* args) const
+    {
+        checkResultType(result.typeInfo());
+        _thunks->assignIntoConst(&_callable, result.getStorage().storage(result.typeInfo()), args);
+    }
+
+    /**
+     * \brief Checks whether the callable returns void
+     */
+    bool returnsVoid() const
+    {
+        SIPLASPLAS_ASSERT_FALSE(empty());
+        return _thunks->returnsVoid;
+    }
+
+    /**
+     * \brief Returns the type information of the (decayed) return type
+     * of the callable. The callable must not return void
+     */
+    cpp::typeerasure::TypeInfo returnType() const
+    {
+        SIPLASPLAS_ASSERT_FALSE(returnsVoid());
+        return _thunks->returnType;
+    }
+
+    /**
+     * \brief Invokes the callable once per element of the given argument columns
+     *
+     * Each argument column is an AnyVector with the values of one parameter of
+     * the callable, with elements of the decayed parameter type (For pointers to
+     * member functions the first column stores the caller objects). The i-th
+     * invocation takes the i-th element of each column. Argument types are checked
+     * once per column and the rows are processed in a statically typed loop, so the
+     * per-call cost is close to calling the callable directly.
+     *
+     * Parameters taken by non-const reference get a reference to the column element,
+     * rvalue reference parameters move from the element. The behavior is undefined
+     * if the columns don't have the same size.
+     *
+     * \param columns Pointer to the sequence of argument columns, one per parameter
+     * \param results Optional vector to append the return values to. Its element type
+     * must be the decayed return type of the callable (See returnType()).
+     */
+    void invokeBatch(cpp::AnyVector* columns, cpp::AnyVector* results = nullptr)
+    {
+        checkBatch(columns, results);
+        _thunks->invokeBatch(&_callable, columns, results);
+    }
+
+    /**
+     * \brief Invokes the callable once per element of the given argument columns
+     *
+     * See invokeBatch(cpp::AnyVector*, cpp::AnyVector*)
+     */
+    void invokeBatch(cpp::AnyVector* columns, cpp::AnyVector* results = nullptr) const
+    {
+        checkBatch(columns, results);
+        _thunks->invokeBatchConst(&_callable, columns, results);
+    }
+
+    /**
+     * \brief Invokes the callable once per element of the given argument columns
+     *
+     * See invokeBatch(cpp::AnyVector*, cpp::AnyVector*)
+     */
+    void invokeBatch(std::vector<cpp::AnyVector>& columns, cpp::AnyVector* results = nullptr)
+    {
+        SIPLASPLAS_ASSERT_FALSE(empty());
+        SIPLASPLAS_ASSERT_EQ(columns.size(), _thunks->arity);
+        invokeBatch(columns.data(), results);
+    }
+
+    /**
+     * \brief Invokes the callable once per element of the given argument columns
+     *
+     * See invokeBatch(cpp::AnyVector*, cpp::AnyVector*)
+     */
+    void invokeBatch(std::vector<cpp::AnyVector>& columns, cpp::AnyVector* results = nullptr) const
+    {
+        SIPLASPLAS_ASSERT_FALSE(empty());
+        SIPLASPLAS_ASSERT_EQ(columns.size(), _thunks->arity);
+        invokeBatch(columns.data(), results);
+    }
+
+    Function& operator=(const Function& other)
+    {
+        if(this != &other)
+        {
+            Function copy{other};
+            reset();
+            move(copy);
+        }
+
+        return *this;
     }
 
-    Function& operator=(const Function&) = default;
-    Function& operator=(Function&&) = default;
+    Function& operator=(Function&& other)
+    {
+        if(this != &other)
+        {
+            reset();
+            move(other);
+        }
+
+        return *this;
+    }
 
     /**
      * \brief Assigns a new callable to the function
@@ -211,7 +418,8 @@ public:
     >>
     Function& operator=(Callable&& callable)
     {
-        _invoke = Invoke<std::decay_t<Callable>>{std::forward<Callable>(callable)};
+        reset();
+        construct<std::decay_t<Callable>>(std::forward<Callable>(callable));
         return *this;
     }
 
@@ -221,7 +429,7 @@ public:
      */
     cpp::FunctionKind kind() const
     {
-        return _invoke.template get<InvokeInterface>().kind();
+        return _thunks->typeInfo.kind();
     }
 
     /**
@@ -234,7 +442,13 @@ public:
     template<typename T>
     const T& get() const
     {
-        return _invoke.template get<InvokeInterface>().template get<T>();
+        SIPLASPLAS_ASSERT(_thunks->typeInfo == cpp::typeerasure::TypeInfo::get<std::decay_t<T>>())(
+            "Callable is of type {}, not {}",
+            _thunks->typeInfo.typeName(),
+            ctti::type_id<std::decay_t<T>>().name()
+        );
+
+        return *reinterpret_cast<const T*>(object());
     }
 
     /**
@@ -247,201 +461,483 @@ public:
     template<typename T>
     T& get()
     {
-        return _invoke.template get<InvokeInterface>().template get<T>();
+        SIPLASPLAS_ASSERT(_thunks->typeInfo == cpp::typeerasure::TypeInfo::get<std::decay_t<T>>())(
+            "Callable is of type {}, not {}",
+            _thunks->typeInfo.typeName(),
+            ctti::type_id<std::decay_t<T>>().name()
+        );
+
+        return *reinterpret_cast<T*>(object());
     }
 
 private:
-    template<typename Callable, typename... Args>
-    Function(meta::identity<Callable>, Args&&... args) :
-        _invoke{Invoke<Callable>{std::forward<Args>(args)...}}
-    {}
+    using CallableStorage = std::aligned_storage_t<
+        (detail::FunctionInlineCapacity<Storage>::value > sizeof(void*) ?
+            detail::FunctionInlineCapacity<Storage>::value : sizeof(void*)),
+        alignof(std::max_align_t)
+    >;
+
+    using InvokeThunk = SimpleAny<ReturnStorage>(*)(void* storage, AnyArg* args);
+    using ConstInvokeThunk = SimpleAny<ReturnStorage>(*)(const void* storage, AnyArg* args);
+
+    // Cold operations of a callable type. Value semantics are
+    // implemented through the callable TypeInfo
+    struct Thunks
+    {
+        cpp::typeerasure::TypeInfo typeInfo;
+        bool inlineStorage;
+
+        SimpleAny<ReturnStorage>(*invokeMovedArgs)(void*, const AnyArg*);
+        SimpleAny<ReturnStorage>(*invokeMovedArgsConst)(const void*, const AnyArg*);
+        SimpleAny<ReturnStorage>(*invokeAnys)(void*, SimpleAny<ArgsStorage>*);
+        SimpleAny<ReturnStorage>(*invokeAnysConst)(const void*, SimpleAny<ArgsStorage>*);
+        SimpleAny<ReturnStorage>(*invokeMovedAnys)(void*, const SimpleAny<ArgsStorage>*);
+        SimpleAny<ReturnStorage>(*invokeMovedAnysConst)(const void*, const SimpleAny<ArgsStorage>*);
+
+        // Return value written to caller storage, see invokeInto()
+        bool returnsVoid;
+        cpp::typeerasure::TypeInfo returnType;
+        void(*constructInto)(void*, void*, AnyArg*);
+        void(*constructIntoConst)(const void*, void*, AnyArg*);
+        void(*assignInto)(void*, void*, AnyArg*);
+        void(*assignIntoConst)(const void*, void*, AnyArg*);
+
+        // Batched invocation, see invokeBatch()
+        std::size_t arity;
+        void(*invokeBatch)(void*, cpp::AnyVector*, cpp::AnyVector*);
+        void(*invokeBatchConst)(const void*, cpp::AnyVector*, cpp::AnyVector*);
+    };
 
-    class InvokeInterface
+    template<typename Callable>
+    class Invoke
     {
+        template<typename ArgsPolicy>
+        using Invoker = ::cpp::typeerasure::detail::Invoke<
+            ::cpp::meta::make_index_sequence<::cpp::function_arguments<Callable>::size>,
+            ArgsPolicy
+        >;
+
+        using Result = decltype(Invoker<cpp::Identity>::apply_sequence(
+            std::declval<Callable&>(), std::declval<AnyArg*>()
+        ));
+
+        // Batch arguments are passed as lvalues to the elements
+        // of the columns, except for rvalue reference parameters
+        // which are moved from the column
+        template<typename Param>
+        using BatchArg = std::conditional_t<
+            std::is_rvalue_reference<Param>::value,
+            Param,
+            std::decay_t<Param>&
+        >;
+
     public:
-        virtual ~InvokeInterface() = default;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>&& args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>&& args) const = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>& args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>& args) const = 0;
-        virtual SimpleAny<ReturnStorage> invoke(AnyArg* args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(AnyArg* args) const = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>&& args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>&& args) const = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>& args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>& args) const = 0;
-        virtual SimpleAny<ReturnStorage> invoke(SimpleAny<ArgsStorage>* args) = 0;
-        virtual SimpleAny<ReturnStorage> invoke(SimpleAny<ArgsStorage>* args) const = 0;
-
-        virtual void* getObject() = 0;
-        virtual const void* getObject() const = 0;
-        virtual cpp::FunctionKind kind() const = 0;
-        virtual cpp::typeerasure::TypeInfo typeInfo() const = 0;
-
-        template<typename T>
-        const T& get() const
-        {
-            SIPLASPLAS_ASSERT(typeInfo() == cpp::typeerasure::TypeInfo::get<std::decay_t<T>>())(
-                "Callable is of type {}, not {}",
-                typeInfo().typeName(),
-                ctti::type_id<std::decay_t<T>>().name()
-            );
+        using ReturnsVoid = std::is_void<Result>;
+        using ReturnType = std::decay_t<Result>;
+        static constexpr std::size_t Arity = ::cpp::function_arguments<Callable>::size;
+
+        static constexpr bool InlineStorage =
+            sizeof(Callable) <= sizeof(CallableStorage) &&
+            alignof(Callable) <= alignof(CallableStorage) &&
+            std::is_nothrow_move_constructible<Callable>::value;
 
-            return *reinterpret_cast<const T*>(getObject());
+        static Callable& callable(void* storage)
+        {
+            return *reinterpret_cast<Callable*>(
+                InlineStorage ? storage : cpp::detail::read_at<void*>(storage)
+            );
         }
 
-        template<typename T>
-        T& get()
+        static const Callable& callable(const void* storage)
         {
-            SIPLASPLAS_ASSERT(typeInfo() == cpp::typeerasure::TypeInfo::get<std::decay_t<T>>())(
-                "Callable is of type {}, not {}",
-                typeInfo().typeName(),
-                ctti::type_id<std::decay_t<T>>().name()
+            return *reinterpret_cast<const Callable*>(
+                InlineStorage ? storage : cpp::detail::read_at<const void*>(storage)
             );
+        }
 
-            return *reinterpret_cast<T*>(getObject());
+        template<typename... Args>
+        static void construct(void* storage, Args&&... args)
+        {
+            if(InlineStorage)
+            {
+                features::Constructible::apply<Callable>(storage, std::forward<Args>(args)...);
+            }
+            else
+            {
+                void* object = cpp::detail::aligned_malloc(sizeof(Callable), alignof(Callable));
+
+                try
+                {
+                    features::Constructible::apply<Callable>(object, std::forward<Args>(args)...);
+                }
+                catch(...)
+                {
+                    cpp::detail::aligned_free(object);
+                    throw;
+                }
+
+                cpp::detail::write_at(storage, object);
+            }
         }
-    };
 
-    template<typename Callable>
-    class Invoke : public InvokeInterface
-    {
-    public:
-        // Mark it explicitly non default constructible to make std::is_default_constructible
-        // and our concept classes work. Else, Callable construction expression should be evaluated,
-        // yielding a "default constructible" Invoke class, but giving a compilation error when a non-default
-        // constructible callable ctor is invoked
-        Invoke() = delete;
+        template<typename ArgsPolicy, typename Iterator>
+        static SimpleAny<ReturnStorage> invoke(void* storage, Iterator args)
+        {
+            return doInvoke<ArgsPolicy>(callable(storage), args);
+        }
 
-        template<typename... Args>
-        Invoke(Args&&... args) :
-            _callable{std::forward<Args>(args)...}
-        {}
+        template<typename ArgsPolicy, typename Iterator>
+        static SimpleAny<ReturnStorage> invokeConst(const void* storage, Iterator args)
+        {
+            return doInvoke<ArgsPolicy>(callable(storage), args);
+        }
+
+        static const Thunks* thunks()
+        {
+            static const Thunks thunks = {
+                cpp::typeerasure::TypeInfo::get<Callable>(),
+                InlineStorage,
+                &Invoke::invoke<detail::RemoveConst, const AnyArg*>,
+                &Invoke::invokeConst<detail::RemoveConst, const AnyArg*>,
+                &Invoke::invoke<cpp::Identity, SimpleAny<ArgsStorage>*>,
+                &Invoke::invokeConst<cpp::Identity, SimpleAny<ArgsStorage>*>,
+                &Invoke::invoke<detail::RemoveConst, const SimpleAny<ArgsStorage>*>,
+                &Invoke::invokeConst<detail::RemoveConst, const SimpleAny<ArgsStorage>*>,
+                ReturnsVoid::value,
+                // void returns are flagged by returnsVoid, the TypeInfo is a placeholder
+                cpp::typeerasure::TypeInfo::get<std::conditional_t<ReturnsVoid::value, std::nullptr_t, ReturnType>>(),
+                &Invoke::constructInto,
+                &Invoke::constructIntoConst,
+                &Invoke::assignInto,
+                &Invoke::assignIntoConst,
+                Arity,
+                &Invoke::invokeBatch,
+                &Invoke::invokeBatchConst
+            };
+
+            return &thunks;
+        }
+
+        static void constructInto(void* storage, void* result, AnyArg* args)
+        {
+            doConstructInto(callable(storage), result, args, ReturnsVoid());
+        }
+
+        static void constructIntoConst(const void* storage, void* result, AnyArg* args)
+        {
+            doConstructInto(callable(storage), result, args, ReturnsVoid());
+        }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>&& args) override
+        static void assignInto(void* storage, void* result, AnyArg* args)
         {
-            return doInvoke(std::move(args));
+            doAssignInto(callable(storage), result, args, ReturnsVoid());
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>&& args) const override
+        static void assignIntoConst(const void* storage, void* result, AnyArg* args)
         {
-            return doInvoke(std::move(args));
+            doAssignInto(callable(storage), result, args, ReturnsVoid());
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>& args) override
+        static void invokeBatch(void* storage, cpp::AnyVector* columns, cpp::AnyVector* results)
         {
-            return doInvoke(args);
+            doInvokeBatch(callable(storage), columns, results, ::cpp::meta::make_index_sequence<Arity>(),
+                std::integral_constant<bool, Arity == 0>());
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<AnyArg>& args) const override
+        static void invokeBatchConst(const void* storage, cpp::AnyVector* columns, cpp::AnyVector* results)
         {
-            return doInvoke(args);
+            doInvokeBatch(callable(storage), columns, results, ::cpp::meta::make_index_sequence<Arity>(),
+                std::integral_constant<bool, Arity == 0>());
+        }
+
+    private:
+        // Without parameters there are no columns to take the number of calls from
+        template<typename Callable_>
+        static void doInvokeBatch(Callable_&, cpp::AnyVector*, cpp::AnyVector*,
+                                  ::cpp::meta::index_sequence<>, std::true_type)
+        {
+            throw cpp::exception<std::runtime_error>(
+                "invokeBatch() requires a callable with at least one parameter"
+            );
+        }
+
+        template<typename Callable_, std::size_t... Is>
+        static void doInvokeBatch(Callable_& callable, cpp::AnyVector* columns, cpp::AnyVector* results,
+                                  ::cpp::meta::index_sequence<Is...>, std::false_type)
+        {
+            // Argument types are checked once per column, the loop
+            // below works with the typed column buffers only
+            auto begins = std::make_tuple(
+                columns[Is].template data<std::decay_t<::cpp::function_argument<Is, Callable>>>()...
+            );
+            (void)begins;
+            const std::size_t count = columns[0].size();
+
+            if(results != nullptr)
+            {
+                results->reserve(results->size() + count);
+            }
+
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                doInvokeBatchRow(callable, results, ReturnsVoid(),
+                    static_cast<BatchArg<::cpp::function_argument<Is, Callable>>>(std::get<Is>(begins)[i])...
+                );
+            }
         }
 
-        SimpleAny<ReturnStorage> invoke(AnyArg* args) override
+        template<typename Callable_, typename... Args>
+        static void doInvokeBatchRow(Callable_& callable, cpp::AnyVector*, std::true_type, Args&&... args)
         {
-            return doInvoke(args);
+            ::cpp::invoke(callable, std::forward<Args>(args)...);
         }
 
-        SimpleAny<ReturnStorage> invoke(AnyArg* args) const override
+        template<typename Callable_, typename... Args>
+        static void doInvokeBatchRow(Callable_& callable, cpp::AnyVector* results, std::false_type, Args&&... args)
         {
-            return doInvoke(args);
+            if(results != nullptr)
+            {
+                results->template emplace_back<ReturnType>(::cpp::invoke(callable, std::forward<Args>(args)...));
+            }
+            else
+            {
+                ::cpp::invoke(callable, std::forward<Args>(args)...);
+            }
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>&& args) override
+        template<typename ArgsPolicy, typename Callable_, typename Iterator>
+        static SimpleAny<ReturnStorage> doInvoke(Callable_& callable, Iterator args)
         {
-            return doInvoke(std::move(args));
+            return doInvoke<Invoker<ArgsPolicy>>(callable, args, std::is_void<decltype(Invoker<ArgsPolicy>::apply_sequence(callable, args))>());
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>&& args) const override
+        template<typename Invoker_, typename Callable_, typename Iterator>
+        static SimpleAny<ReturnStorage> doInvoke(Callable_& callable, Iterator args, std::true_type)
         {
-            return doInvoke(std::move(args));
+            Invoker_::apply_sequence(callable, args);
+            return cpp::SimpleAny<ReturnStorage>();
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>& args) override
+        template<typename Invoker_, typename Callable_, typename Iterator>
+        static SimpleAny<ReturnStorage> doInvoke(Callable_& callable, Iterator args, std::false_type)
         {
-            return doInvoke(args);
+            return Invoker_::apply_sequence(callable, args);
         }
 
-        SimpleAny<ReturnStorage> invoke(std::vector<SimpleAny<ArgsStorage>>& args) const override
+        template<typename Callable_>
+        static void doConstructInto(Callable_& callable, void*, AnyArg* args, std::true_type)
         {
-            return doInvoke(args);
+            Invoker<cpp::Identity>::apply_sequence(callable, args);
         }
 
-        SimpleAny<ReturnStorage> invoke(SimpleAny<ArgsStorage>* args) override
+        template<typename Callable_>
+        static void doConstructInto(Callable_& callable, void* result, AnyArg* args, std::false_type)
         {
-            return doInvoke(args);
+            features::Constructible::apply<ReturnType>(result, Invoker<cpp::Identity>::apply_sequence(callable, args));
         }
 
-        SimpleAny<ReturnStorage> invoke(SimpleAny<ArgsStorage>* args) const override
+        template<typename Callable_>
+        static void doAssignInto(Callable_& callable, void*, AnyArg* args, std::true_type)
         {
-            return doInvoke(args);
+            Invoker<cpp::Identity>::apply_sequence(callable, args);
         }
 
-        template<typename Args>
-        SimpleAny<ReturnStorage> doInvoke(Args&& args)
+        template<typename Callable_>
+        static void doAssignInto(Callable_& callable, void* result, AnyArg* args, std::false_type)
         {
-            return doInvoke(_callable, std::forward<Args>(args));
+            features::Assignable::apply<ReturnType>(result, Invoker<cpp::Identity>::apply_sequence(callable, args));
         }
+    };
+
+    mutable CallableStorage _callable;
+    InvokeThunk _invoke;
+    ConstInvokeThunk _invokeConst;
+    const Thunks* _thunks;
+
+    template<typename Callable, typename... Args>
+    Function(meta::identity<Callable>, Args&&... args) :
+        Function{}
+    {
+        construct<Callable>(std::forward<Args>(args)...);
+    }
+
+    template<typename Callable, typename... Args>
+    void construct(Args&&... args)
+    {
+        Invoke<Callable>::construct(&_callable, std::forward<Args>(args)...);
+
+        _invoke = &Invoke<Callable>::template invoke<cpp::Identity, AnyArg*>;
+        _invokeConst = &Invoke<Callable>::template invokeConst<cpp::Identity, AnyArg*>;
+        _thunks = Invoke<Callable>::thunks();
+    }
+
+    void checkResultType(const cpp::typeerasure::TypeInfo& resultType) const
+    {
+        SIPLASPLAS_ASSERT_FALSE(empty());
+        SIPLASPLAS_ASSERT(_thunks->returnsVoid || _thunks->returnType == resultType)(
+            "Callable returns {}, cannot write the result into a {}",
+            _thunks->returnType.typeName(),
+            resultType.typeName()
+        );
+    }
 
-        template<typename Args>
-        SimpleAny<ReturnStorage> doInvoke(Args&& args) const
+    void checkBatch(const cpp::AnyVector* columns, const cpp::AnyVector* results) const
+    {
+        SIPLASPLAS_ASSERT_FALSE(empty());
+        SIPLASPLAS_ASSERT(_thunks->arity > 0)("invokeBatch() requires a callable with at least one parameter");
+
+        for(std::size_t i = 1; i < _thunks->arity; ++i)
         {
-            return doInvoke(_callable, std::forward<Args>(args));
+            SIPLASPLAS_ASSERT_EQ(columns[i].size(), columns[0].size());
         }
 
-#define SIPLASPLAS_FUNCTION_INVOKE_EXPRESSION cpp::typeerasure::invoke(identity(std::forward<Callable_>(callable)), identity(std::forward<Args>(args)))
+        if(results != nullptr)
+        {
+            checkResultType(results->typeInfo());
+        }
+    }
 
-        template<typename Callable_, typename Args>
-        static SimpleAny<ReturnStorage> doInvoke(Callable_&& callable, Args&& args)
+    void* object() const
+    {
+        if(_thunks->inlineStorage)
         {
-            return cpp::staticIf<!(cpp::function_kind<Callable>() == cpp::FunctionKind::MEMBER_FUNCTION && std::is_const<std::remove_reference_t<Args>>::value)>([&](auto identity) -> SimpleAny<ReturnStorage>
+            return &_callable;
+        }
+        else
+        {
+            return cpp::detail::read_at<void*>(&_callable);
+        }
+    }
+
+    void copy(const Function& other)
+    {
+        if(other.empty())
+        {
+            return;
+        }
+
+        const cpp::typeerasure::TypeInfo& typeInfo = other._thunks->typeInfo;
+
+        if(other._thunks->inlineStorage)
+        {
+            typeInfo.copyConstruct(&_callable, other.object());
+        }
+        else
+        {
+            void* object = cpp::detail::aligned_malloc(typeInfo.sizeOf(), typeInfo.alignment());
+
+            try
             {
-                return cpp::staticIf<std::is_void<decltype(SIPLASPLAS_FUNCTION_INVOKE_EXPRESSION)>::value>([&](auto identity) -> SimpleAny<ReturnStorage>
-                {
-                    SIPLASPLAS_FUNCTION_INVOKE_EXPRESSION;
-                    return cpp::SimpleAny<ReturnStorage>();
-                }).Else([&](auto identity) -> SimpleAny<ReturnStorage>
-                {
-                    return SIPLASPLAS_FUNCTION_INVOKE_EXPRESSION;
-                });
-            })
-            .Else([](auto) -> SimpleAny<ReturnStorage>
+                typeInfo.copyConstruct(object, other.object());
+            }
+            catch(...)
             {
-                throw cpp::exception<std::runtime_error>(
-                    "Cannot invoke a non-const member function with a const vector of arguments"
-                );
-            });
+                cpp::detail::aligned_free(object);
+                throw;
+            }
 
+            cpp::detail::write_at(&_callable, object);
         }
 
-#undef SIPLASPLAS_FUNCTION_INVOKE_EXPRESSION
+        _invoke = other._invoke;
+        _invokeConst = other._invokeConst;
+        _thunks = other._thunks;
+    }
 
-        void* getObject() override
+    void move(Function& other)
+    {
+        if(other.empty())
         {
-            return &_callable;
+            return;
         }
 
-        const void* getObject() const override
+        if(other._thunks->inlineStorage)
         {
-            return &_callable;
+            other._thunks->typeInfo.moveConstruct(&_callable, other.object());
+            other._thunks->typeInfo.destroy(other.object());
+        }
+        else
+        {
+            cpp::detail::write_at(&_callable, other.object());
         }
 
-        cpp::FunctionKind kind() const override
+        _invoke = other._invoke;
+        _invokeConst = other._invokeConst;
+        _thunks = other._thunks;
+        other._invoke = nullptr;
+        other._invokeConst = nullptr;
+        other._thunks = nullptr;
+    }
+
+    void reset()
+    {
+        if(empty())
         {
-            return cpp::function_kind<Callable>();
+            return;
         }
 
-        cpp::typeerasure::TypeInfo typeInfo() const override
+        void* callable = object();
+        _thunks->typeInfo.destroy(callable);
+
+        if(!_thunks->inlineStorage)
         {
-            return cpp::typeerasure::TypeInfo::get<Callable>();
+            cpp::detail::aligned_free(callable);
         }
 
-    private:
-        Callable _callable;
-    };
+        _invoke = nullptr;
+        _invokeConst = nullptr;
+        _thunks = nullptr;
+    }
 
-    SimpleAny32 _invoke;
+    SimpleAny<ReturnStorage> invokeWith(std::vector<AnyArg>& args)
+    {
+        return _invoke(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<AnyArg>& args) const
+    {
+        return _invokeConst(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<AnyArg>&& args)
+    {
+        return _thunks->invokeMovedArgs(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<AnyArg>&& args) const
+    {
+        return _thunks->invokeMovedArgsConst(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<SimpleAny<ArgsStorage>>& args)
+    {
+        return _thunks->invokeAnys(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<SimpleAny<ArgsStorage>>& args) const
+    {
+        return _thunks->invokeAnysConst(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<SimpleAny<ArgsStorage>>&& args)
+    {
+        return _thunks->invokeMovedAnys(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(std::vector<SimpleAny<ArgsStorage>>&& args) const
+    {
+        return _thunks->invokeMovedAnysConst(&_callable, args.data());
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(SimpleAny<ArgsStorage>* args)
+    {
+        return _thunks->invokeAnys(&_callable, args);
+    }
+
+    SimpleAny<ReturnStorage> invokeWith(SimpleAny<ArgsStorage>* args) const
+    {
+        return _thunks->invokeAnysConst(&_callable, args);
+    }
 };
 
 
@@ -8,6 +8,8 @@
 #include <unordered_set>
 #include <tuple>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 
 /**
@@ -25,6 +27,9 @@
  *  cpp::hash() functionallity. The extended functionallity of cpp::Hash over `std::hash`
  *  includes hashing of enum types, pairs, and tuples out of the box.
  *  - **Hashing of function pointers**: Because we love undefined behavior!
+ *  - **String hashing**: A constexpr FNV-1a hash of character sequences (See cpp::fnv1a()),
+ *  stable across runs and platforms, for hash tables built at compile time or keyed by
+ *  names that are not `std::string`s.
  */
 
 namespace cpp
@@ -182,6 +187,43 @@ constexpr std::size_t hash(const T& value)
     return HashDispatch<T>::apply(value);
 }
 
+/**
+ * \ingroup hash
+ * \brief Returns the 64 bit FNV-1a hash of a sequence of characters
+ *
+ * \param str Pointer to the first character.
+ * \param length Number of characters.
+ * \param seed Value combined with the FNV offset basis. Hashing the same characters with
+ * different seeds gives unrelated hashes, which allows keying tables with (value, string) pairs.
+ */
+constexpr std::uint64_t fnv1a(const char* str, std::size_t length, std::uint64_t seed = 0)
+{
+    std::uint64_t result = 0xcbf29ce484222325ull ^ seed;
+
+    for(std::size_t i = 0; i < length; ++i)
+    {
+        result = (result ^ static_cast<unsigned char>(str[i])) * 0x100000001b3ull;
+    }
+
+    return result;
+}
+
+/**
+ * \ingroup hash
+ * \brief Returns the 64 bit FNV-1a hash of a null terminated string
+ */
+constexpr std::uint64_t fnv1a(const char* str)
+{
+    std::uint64_t result = 0xcbf29ce484222325ull;
+
+    for(; *str != '\0'; ++str)
+    {
+        result = (result ^ static_cast<unsigned char>(*str)) * 0x100000001b3ull;
+    }
+
+    return result;
+}
+
 template<typename T, typename U, typename... Args>
 constexpr std::size_t hash(const T& first, const U& second, const Args&... tail)
 {
@@ -0,0 +1,252 @@
+#ifndef SIPLASPLAS_UTILITY_TYPENAMEINDEX_HPP
+#define SIPLASPLAS_UTILITY_TYPENAMEINDEX_HPP
+
+#include "exception.hpp"
+#include "hash.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace cpp
+{
+
+/**
+ * \ingroup utility
+ * \brief Maps type names to values of type T
+ *
+ * Names are normalized on registration and lookup: the `class `, `struct `,
+ * `enum ` and `union ` prefixes some compilers add to type names are ignored,
+ * so `"class Foo"`, `"struct Foo"` and `"Foo"` are the same key. Lookups take
+ * a pointer and length (or anything convertible to them) and never allocate.
+ *
+ * Each normalized name gets a 64 bit id (Its FNV-1a hash, see TypeNameIndex::id())
+ * which does not depend on the registration order nor the compiler, so it can
+ * be stored in serialized data and looked up later with find(Id).
+ */
+template<typename T>
+class TypeNameIndex
+{
+public:
+    using Id = std::uint64_t;
+
+    struct Entry
+    {
+        Id id;
+        std::string name;
+        T value;
+    };
+
+    /**
+     * \brief Returns the id of the given type name
+     */
+    static constexpr Id id(const char* name, std::size_t length)
+    {
+        return hash(name + prefixLength(name, length), length - prefixLength(name, length));
+    }
+
+    /**
+     * \brief Returns the id of the given type name
+     */
+    static Id id(const std::string& name)
+    {
+        return id(name.c_str(), name.size());
+    }
+
+    /**
+     * \brief Registers a value for the given type name
+     *
+     * \returns A reference to the value registered with that name and true if the
+     * value was inserted, or false if the name was already registered (In that case
+     * the registered value is kept).
+     * \throws std::runtime_error if the name id collides with the id of a different name
+     */
+    std::pair<T&, bool> insert(const char* name, std::size_t length, T value)
+    {
+        const Id nameId = id(name, length);
+        auto it = _byId.find(nameId);
+
+        if(it != _byId.end())
+        {
+            Entry& entry = _entries[it->second];
+
+            if(!sameName(entry, name, length))
+            {
+                cpp::Throw<std::runtime_error>(
+                    "Type name '{}' collides with registered type name '{}'",
+                    std::string{name, length}, entry.name
+                );
+            }
+
+            return {entry.value, false};
+        }
+
+        const std::size_t prefix = prefixLength(name, length);
+        _entries.push_back(Entry{nameId, std::string{name + prefix, length - prefix}, std::move(value)});
+        _byId[nameId] = _entries.size() - 1;
+
+        return {_entries.back().value, true};
+    }
+
+    /**
+     * \brief Registers a value for the given type name
+     */
+    std::pair<T&, bool> insert(const std::string& name, T value)
+    {
+        return insert(name.c_str(), name.size(), std::move(value));
+    }
+
+    /**
+     * \brief Returns the value registered for the given type name, nullptr if
+     * there's no such type
+     */
+    T* find(const char* name, std::size_t length)
+    {
+        auto it = _byId.find(id(name, length));
+
+        if(it != _byId.end() && sameName(_entries[it->second], name, length))
+        {
+            return &_entries[it->second].value;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    /**
+     * \brief Returns the value registered for the given type name, nullptr if
+     * there's no such type
+     */
+    const T* find(const char* name, std::size_t length) const
+    {
+        return const_cast<TypeNameIndex*>(this)->find(name, length);
+    }
+
+    /**
+     * \brief Returns the value registered for the given null terminated type name,
+     * nullptr if there's no such type
+     */
+    T* find(const char* name)
+    {
+        return find(name, std::strlen(name));
+    }
+
+    /**
+     * \brief Returns the value registered for the given null terminated type name,
+     * nullptr if there's no such type
+     */
+    const T* find(const char* name) const
+    {
+        return find(name, std::strlen(name));
+    }
+
+    /**
+     * \brief Returns the value registered for the given type name, nullptr if
+     * there's no such type
+     */
+    T* find(const std::string& name)
+    {
+        return find(name.c_str(), name.size());
+    }
+
+    /**
+     * \brief Returns the value registered for the given type name, nullptr if
+     * there's no such type
+     */
+    const T* find(const std::string& name) const
+    {
+        return find(name.c_str(), name.size());
+    }
+
+    /**
+     * \brief Returns the value registered with the given id, nullptr if
+     * there's no such type
+     */
+    T* find(Id id)
+    {
+        auto it = _byId.find(id);
+
+        if(it != _byId.end())
+        {
+            return &_entries[it->second].value;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    /**
+     * \brief Returns the value registered with the given id, nullptr if
+     * there's no such type
+     */
+    const T* find(Id id) const
+    {
+        return const_cast<TypeNameIndex*>(this)->find(id);
+    }
+
+    /**
+     * \brief Returns the number of registered names
+     */
+    std::size_t size() const
+    {
+        return _entries.size();
+    }
+
+    /**
+     * \brief Returns the registered entries, in registration order. References
+     * to the entries are never invalidated by insertions
+     */
+    const std::deque<Entry>& entries() const
+    {
+        return _entries;
+    }
+
+private:
+    std::deque<Entry> _entries;
+    std::unordered_map<Id, std::size_t> _byId;
+
+    static constexpr bool startsWith(const char* name, std::size_t length, const char* prefix)
+    {
+        std::size_t i = 0;
+
+        for(; prefix[i] != '\0'; ++i)
+        {
+            if(i >= length || name[i] != prefix[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static constexpr std::size_t prefixLength(const char* name, std::size_t length)
+    {
+        return startsWith(name, length, "class ")  ? 6 :
+               startsWith(name, length, "struct ") ? 7 :
+               startsWith(name, length, "enum ")   ? 5 :
+               startsWith(name, length, "union ")  ? 6 : 0;
+    }
+
+    static constexpr Id hash(const char* name, std::size_t length)
+    {
+        return ::cpp::fnv1a(name, length);
+    }
+
+    static bool sameName(const Entry& entry, const char* name, std::size_t length)
+    {
+        const std::size_t prefix = prefixLength(name, length);
+
+        return entry.name.size() == length - prefix &&
+               std::memcmp(entry.name.data(), name + prefix, entry.name.size()) == 0;
+    }
+};
+
+}
+
+#endif // SIPLASPLAS_UTILITY_TYPENAMEINDEX_HPP
@@ -0,0 +1,481 @@
+#ifndef SIPLASPLAS_VARIANT_MESSAGEBUS_HPP
+#define SIPLASPLAS_VARIANT_MESSAGEBUS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "variant.hpp"
+#include "multi_visitor.hpp"
+
+namespace cpp
+{
+    namespace detail
+    {
+        template<typename Variant, typename... Ts>
+        struct MessageArgsConstructible;
+
+        template<typename Variant>
+        struct MessageArgsConstructible<Variant> : public std::true_type
+        {};
+
+        template<typename Variant, typename Head, typename... Tail>
+        struct MessageArgsConstructible<Variant, Head, Tail...> : public std::integral_constant<bool,
+                std::is_constructible<Variant, Head>::value &&
+                MessageArgsConstructible<Variant, Tail...>::value
+            >
+        {};
+    }
+
+    /**
+     * \brief A message with a fixed number of arguments, each one
+     * being any of the types Args...
+     *
+     * Messages are processed by visiting all their arguments at once,
+     * so the visitor is called with the active values of the arguments.
+     */
+    template<std::size_t Arity, typename... Args>
+    class Message
+    {
+    public:
+        using variant_t = ::cpp::Variant<Args...>;
+        static constexpr std::size_t arity = Arity;
+
+        /**
+         * \brief Creates a message with all its arguments empty
+         */
+        Message() = default;
+
+        template<typename... Ts, typename = std::enable_if_t<
+            sizeof...(Ts) == Arity && ::cpp::detail::MessageArgsConstructible<::cpp::Variant<Args...>, Ts&&...>::value
+        >>
+        Message(Ts&&... args) :
+            _args{{variant_t(std::forward<Ts>(args))...}}
+        {}
+
+        /**
+         * \brief Returns the I-th argument of the message
+         */
+        template<std::size_t I>
+        const variant_t& arg() const
+        {
+            return std::get<I>(_args);
+        }
+
+        /**
+         * \brief Calls the visitor with the values of the message arguments
+         */
+        template<typename Visitor>
+        void process(Visitor&& visitor) const
+        {
+            process(std::forward<Visitor>(visitor), std::make_index_sequence<Arity>{});
+        }
+
+    private:
+        std::array<variant_t, Arity> _args;
+
+        template<typename Visitor, std::size_t... Is>
+        void process(Visitor&& visitor, std::index_sequence<Is...>) const
+        {
+            return ::cpp::multi_visitor<void>(
+                std::forward<Visitor>(visitor)
+            )(_args[Is]...);
+        }
+    };
+
+    namespace detail
+    {
+        template<typename...> struct MessageArgs {};
+        template<typename...> using message_void_t = void;
+
+        // Calls Class::process() with the message values if there's
+        // an overload for them, ignores the message otherwise
+        template<typename Class, typename Args, typename = void>
+        struct MessageProcess
+        {
+            template<typename... Ts>
+            static void apply(Class*, Ts&&...)
+            {}
+        };
+
+        template<typename Class, typename... Args>
+        struct MessageProcess<Class, MessageArgs<Args...>, message_void_t<
+            decltype(std::declval<Class&>().process(std::declval<Args>()...))
+        >>
+        {
+            template<typename... Ts>
+            static void apply(Class* object, Ts&&... args)
+            {
+                object->process(std::forward<Ts>(args)...);
+            }
+        };
+    }
+
+    /**
+     * \brief CRTP base of classes handling messages of type `Message<Arity, Args...>`
+     *
+     * receive() routes the message to the `process()` overload of T matching
+     * the values of the message arguments. Messages with no matching overload
+     * are ignored.
+     */
+    template<typename T, std::size_t Arity, typename... Args>
+    class MessageHandler
+    {
+    public:
+        using message_t = Message<Arity, Args...>;
+
+        void receive(const message_t& message)
+        {
+            message.process([this](const auto&... args)
+            {
+                using Process = ::cpp::detail::MessageProcess<T, ::cpp::detail::MessageArgs<decltype(args)...>>;
+                Process::apply(static_cast<T*>(this), args...);
+            });
+        }
+
+        void receive(const message_t& message) const
+        {
+            message.process([this](const auto&... args)
+            {
+                using Process = ::cpp::detail::MessageProcess<const T, ::cpp::detail::MessageArgs<decltype(args)...>>;
+                Process::apply(static_cast<const T*>(this), args...);
+            });
+        }
+    };
+
+    namespace detail
+    {
+        template<typename Class, typename Message>
+        struct HandlerFor;
+
+        template<typename Class, std::size_t Arity, typename... Args>
+        struct HandlerFor<Class, Message<Arity, Args...>>
+        {
+            using type = MessageHandler<Class, Arity, Args...>;
+        };
+    }
+
+    /**
+     * \brief MessageHandler base for the given message type
+     */
+    template<typename Class, typename Message>
+    using HandlerFor = typename detail::HandlerFor<Class, Message>::type;
+
+    /**
+     * \brief Lock-free bounded queue of messages
+     *
+     * The queue preallocates storage for Capacity messages, so pushing and
+     * consuming messages never allocates (Beyond what copying the message values
+     * could allocate). It's designed for a single producer thread and a single
+     * consumer thread.
+     *
+     * Consumed messages are not destroyed but overwritten by later pushes.
+     *
+     * \tparam T Message type. Must be default constructible and assignable
+     * \tparam Capacity Maximum number of messages in the queue. Must be a power of two
+     */
+    template<typename T, std::size_t Capacity>
+    class MessageQueue
+    {
+    public:
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "MessageQueue capacity must be a power of two");
+
+        MessageQueue() = default;
+        MessageQueue(const MessageQueue&) = delete;
+        MessageQueue& operator=(const MessageQueue&) = delete;
+
+        /**
+         * \brief Enqueues a message. Must be called from the producer thread only
+         *
+         * \returns True if the message was enqueued, false if the queue is full
+         */
+        template<typename U>
+        bool push(U&& message)
+        {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+            if(tail - _head.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+
+            _messages[tail & (Capacity - 1)] = std::forward<U>(message);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * \brief Calls f with each queued message, up to \p max messages.
+         * Must be called from the consumer thread only
+         *
+         * All the messages available when the function is called are processed
+         * as a batch, synchronizing with the producer only once.
+         *
+         * \returns Number of processed messages
+         */
+        template<typename F>
+        std::size_t consume(F&& f, std::size_t max = Capacity)
+        {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            const std::size_t count = std::min(_tail.load(std::memory_order_acquire) - head, max);
+
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                f(_messages[(head + i) & (Capacity - 1)]);
+            }
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * \brief Dequeues a message. Must be called from the consumer thread only
+         *
+         * \returns True if a message was dequeued, false if the queue is empty
+         */
+        bool pop(T& message)
+        {
+            return consume([&message](T& next)
+            {
+                message = std::move(next);
+            }, 1) == 1;
+        }
+
+        /**
+         * \brief Returns the number of queued messages
+         */
+        std::size_t size() const
+        {
+            const std::size_t head = _head.load(std::memory_order_acquire);
+            return _tail.load(std::memory_order_acquire) - head;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return Capacity;
+        }
+
+    private:
+        // Head and tail are padded to different cache lines so producer
+        // and consumer do not invalidate each other's line on every operation
+        static constexpr std::size_t cacheLineSize = 64;
+
+        std::array<T, Capacity> _messages;
+        std::atomic<std::size_t> _head{0};
+        char _headPadding[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> _tail{0};
+        char _tailPadding[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+    };
+
+    /**
+     * \brief Queue of messages waiting to be received by a handler
+     *
+     * Mailboxes deliver messages across threads: Messages are posted to the mailbox
+     * from one thread (Usually by a MessageBus), and the handler receives them when
+     * the owner thread of the handler calls dispatch().
+     */
+    template<typename Handler, typename Message, std::size_t Capacity = 1024>
+    class Mailbox
+    {
+    public:
+        Mailbox(Handler& handler) :
+            _handler(handler)
+        {}
+
+        /**
+         * \brief Posts a message to the mailbox. Must be called from the
+         * producer thread only
+         *
+         * \returns True if the message was posted, false if the mailbox is full
+         */
+        template<typename U>
+        bool post(U&& message)
+        {
+            return _queue.push(std::forward<U>(message));
+        }
+
+        /**
+         * \brief Delivers the pending messages to the handler, up to \p max messages.
+         * Must be called from the handler thread only
+         *
+         * \returns Number of delivered messages
+         */
+        std::size_t dispatch(std::size_t max = Capacity)
+        {
+            return _queue.consume([this](const Message& message)
+            {
+                _handler.receive(message);
+            }, max);
+        }
+
+        std::size_t pending() const
+        {
+            return _queue.size();
+        }
+
+        Handler& handler() const
+        {
+            return _handler;
+        }
+
+    private:
+        Handler& _handler;
+        MessageQueue<Message, Capacity> _queue;
+    };
+
+    /**
+     * \brief Routes messages of a fixed schema to a set of handlers
+     *
+     * Messages are published to a preallocated lock-free queue and delivered
+     * in batches when dispatch() is called. Each message is delivered to all connected
+     * handlers in connection order, where:
+     *
+     *  - **Handlers** (Any object with a `receive(const Message&)` function, such as
+     *    MessageHandler) receive the message directly in the dispatching thread.
+     *  - **Mailboxes** get the message posted, so the handler receives it later in the
+     *    thread calling Mailbox::dispatch().
+     *
+     * Publishing and dispatching do not allocate. As MessageQueue, the bus supports one
+     * publisher thread and one dispatcher thread. Compared to cpp::SignalEmitter, a bus
+     * is restricted to one message type but has no type-erased arguments nor dynamic
+     * allocations per emission.
+     *
+     * ``` cpp
+     * using Event = cpp::Message<1, int, std::string>;
+     *
+     * struct Logger : public cpp::HandlerFor<Logger, Event>
+     * {
+     *     void process(const std::string& str) { std::cout << str << std::endl; }
+     * };
+     *
+     * Logger logger;
+     * cpp::MessageBus<Event> bus;
+     * bus.connect(logger);
+     *
+     * bus.publish(Event{"hello"s});
+     * bus.publish(Event{42}); // Ignored by logger
+     * bus.dispatch();
+     * ```
+     */
+    template<typename Message, std::size_t Capacity = 1024>
+    class MessageBus
+    {
+    public:
+        /**
+         * \brief Connects a handler. The handler receives messages in the
+         * dispatching thread
+         */
+        template<typename Handler>
+        void connect(Handler& handler)
+        {
+            _subscribers.push_back({&handler, &MessageBus::deliver<Handler>});
+        }
+
+        /**
+         * \brief Connects a mailbox. The messages are posted to the mailbox in the
+         * dispatching thread
+         */
+        template<typename Handler, std::size_t MailboxCapacity>
+        void connect(Mailbox<Handler, Message, MailboxCapacity>& mailbox)
+        {
+            _subscribers.push_back({&mailbox, &MessageBus::post<Handler, MailboxCapacity>});
+        }
+
+        /**
+         * \brief Disconnects a handler or mailbox
+         */
+        template<typename Subscriber>
+        void disconnect(Subscriber& subscriber)
+        {
+            _subscribers.erase(std::remove_if(_subscribers.begin(), _subscribers.end(),
+                [&subscriber](const Subscription& subscription)
+                {
+                    return subscription.object == &subscriber;
+                }
+            ), _subscribers.end());
+        }
+
+        /**
+         * \brief Enqueues a message for dispatching. Must be called
+         * from the publisher thread only
+         *
+         * \returns True if the message was enqueued, false if the bus queue is full
+         */
+        template<typename U>
+        bool publish(U&& message)
+        {
+            return _queue.push(std::forward<U>(message));
+        }
+
+        /**
+         * \brief Delivers the published messages to the connected handlers, up to
+         * \p max messages. Must be called from the dispatcher thread only
+         *
+         * \returns Number of dispatched messages
+         */
+        std::size_t dispatch(std::size_t max = Capacity)
+        {
+            return _queue.consume([this](const Message& message)
+            {
+                for(const Subscription& subscription : _subscribers)
+                {
+                    if(!subscription.deliver(subscription.object, message))
+                    {
+                        ++_dropped;
+                    }
+                }
+            }, max);
+        }
+
+        /**
+         * \brief Returns the number of messages waiting to be dispatched
+         */
+        std::size_t pending() const
+        {
+            return _queue.size();
+        }
+
+        /**
+         * \brief Returns the number of deliveries dropped because the
+         * destination mailbox was full
+         */
+        std::size_t dropped() const
+        {
+            return _dropped;
+        }
+
+    private:
+        struct Subscription
+        {
+            void* object;
+            bool (*deliver)(void*, const Message&);
+        };
+
+        template<typename Handler>
+        static bool deliver(void* handler, const Message& message)
+        {
+            static_cast<Handler*>(handler)->receive(message);
+            return true;
+        }
+
+        template<typename Handler, std::size_t MailboxCapacity>
+        static bool post(void* mailbox, const Message& message)
+        {
+            return static_cast<Mailbox<Handler, Message, MailboxCapacity>*>(mailbox)->post(message);
+        }
+
+        MessageQueue<Message, Capacity> _queue;
+        std::vector<Subscription> _subscribers;
+        std::size_t _dropped = 0;
+    };
+}
+
+#endif // SIPLASPLAS_VARIANT_MESSAGEBUS_HPP
@@ -2,149 +2,195 @@
 #ifndef SIPLASPLAS_VARIANT_MULTI_VISITOR_HPP
 #define SIPLASPLAS_VARIANT_MULTI_VISITOR_HPP
 
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <utility>
 
+#include "variant.hpp"
 #include "visitor.hpp"
 
 namespace cpp
 {
     namespace detail
     {
-        template<typename Head, typename... Tail, std::size_t... Is>
-        auto tuple_tail(const std::tuple<Head, Tail...>& tuple, std::index_sequence<Is...>)
-        {
-            return std::make_tuple(std::forward<std::tuple_element_t<Is+1, std::tuple<Head, Tail>>>(std::get<Is+1>(tuple))...);
-        }
+        template<typename Variant>
+        struct VariantAlternatives;
 
-        template<typename Head, typename... Tail>
-        auto tuple_tail(const std::tuple<Head, Tail...>& tuple)
-        {
-            return tuple_tail(tuple, std::index_sequence_for<Tail...>{});
-        }
-
-        template<
-            typename Visitor,
-            typename MatchedValues,
-            typename Variants
-        > class MultiVisitorProcessor;
-
-        template<
-            typename Visitor,
-            typename MatchedValues,
-            typename Variants
-        > MultiVisitorProcessor<Visitor,
-                                MatchedValues,
-                                Variants>
-        make_visitor_processor(Visitor&& visitor, 
-                               MatchedValues&& matchedValues,
-                               Variants&& variants)
+        template<typename... Ts>
+        struct VariantAlternatives<::cpp::Variant<Ts...>>
         {
-            return { std::forward<Visitor>(visitor),
-                     std::forward<MatchedValues>(matchedValues),
-                     std::forward<Variants>(variants) };
-        }
-
-        template<
-            typename Visitor,
-            typename MatchedValues,
-            typename Variant,
-            typename...  Tail
-        > class MultiVisitorProcessor<Visitor, MatchedValues, std::tuple<Variant, Tail...>>
+            static constexpr std::size_t size = sizeof...(Ts);
+
+            template<std::size_t Index>
+            using type = std::tuple_element_t<Index, std::tuple<Ts...>>;
+        };
+
+        /*
+         * Visits N variants at once through a single table with one entry
+         * per combination of alternatives. The entry is selected by the
+         * flattened index of the active alternatives:
+         *
+         *   index = index(v0)*stride(0) + index(v1)*stride(1) + ... + index(vN-1)
+         *
+         * where stride(k) is the product of the number of alternatives of the
+         * variants following the k-th variant. As in Variant::visit(), the
+         * empty state is handled as an extra alternative (index() of an empty
+         * variant is its number of alternatives) whose entries throw, so
+         * dispatching needs no per variant checks.
+         */
+        template<typename Visitor, typename... Variants>
+        class MultiVisitTable
         {
         public:
-            MultiVisitorProcessor(Visitor&& visitor, 
-                                  MatchedValues&& matchedValues,
-                                  std::tuple<Variant, Tail...>&& variants) :
-               _visitor{visitor},
-                _matchedValues{matchedValues},
-                _variants{variants}
-            {}
-            
             using ResultType = typename std::decay_t<Visitor>::ResultType;
 
-            template<typename T>
-            auto next_visitor(T&& value)
+            static ResultType visit(Visitor& visitor, Variants&... variants)
             {
-                return make_visitor_processor(
-                    std::forward<Visitor>(_visitor),
-                    std::tuple_cat(_matchedValues, std::forward_as_tuple(std::forward<T>(value))),
-                    tuple_tail(_variants)
+                return visit(visitor, std::integral_constant<bool, (sizeof...(Variants) == 1)>(), variants...);
+            }
+
+        private:
+            template<typename Variant>
+            static ResultType visit(Visitor& visitor, std::true_type, Variant& variant)
+            {
+                // A single variant is already visited through its own table
+                return variant.visit(visitor);
+            }
+
+            static ResultType visit(Visitor& visitor, std::false_type, Variants&... variants)
+            {
+                const std::size_t indices[] = {static_cast<std::size_t>(variants.index())...};
+                std::size_t index = 0;
+
+                for(std::size_t k = 0; k < sizeof...(Variants); ++k)
+                {
+                    index += indices[k] * stride(k);
+                }
+
+                return dispatch(
+                    visitor,
+                    index,
+                    std::make_index_sequence<sizeof...(Variants)>(),
+                    std::make_index_sequence<combinations()>(),
+                    variants...
                 );
             }
 
-            template<typename T>
-            ResultType operator()(T&& value)
+            template<typename Variant>
+            using Alternatives = VariantAlternatives<std::remove_const_t<Variant>>;
+
+            // Number of table entries per variant, including the empty state
+            static constexpr std::size_t slots(std::size_t k)
             {
-                return std::forward<Variant>(std::get<0>(_variants)).template visit<ResultType>(next_visitor(std::forward<T>(value)));
+                const std::size_t sizes[] = {(Alternatives<Variants>::size + 1)...};
+                return sizes[k];
             }
-        private:
-            // Note parameters were not decayed, they conserve rl-qualifiers
-            Visitor _visitor; 
-            MatchedValues _matchedValues;
-            std::tuple<Variant, Tail...> _variants; 
-        };
 
-        template<
-            typename Visitor,
-            typename MatchedValues
-        > class MultiVisitorProcessor<Visitor, MatchedValues, std::tuple<>>
-        {
-        public:
-            MultiVisitorProcessor(Visitor&& visitor, 
-                                  MatchedValues&& matchedValues,
-                                  std::tuple<>&& variant) :
-               _visitor{visitor},
-               _matchedValues{matchedValues}
-            {}
-            
-            using ResultType = typename std::decay_t<Visitor>::ResultType;
+            static constexpr std::size_t stride(std::size_t k)
+            {
+                std::size_t result = 1;
+
+                for(std::size_t i = k + 1; i < sizeof...(Variants); ++i)
+                {
+                    result *= slots(i);
+                }
+
+                return result;
+            }
 
-            template<typename T>
-            ResultType operator()(T&& value)
+            static constexpr std::size_t combinations()
             {
-                return call_multivisitor(std::forward<T>(value), 
-                                         std::make_index_sequence<
-                                             std::tuple_size<MatchedValues>::value
-                                         >{}
-                );
+                return stride(0) * slots(0);
+            }
+
+            static constexpr bool has_empty(std::size_t index)
+            {
+                for(std::size_t k = 0; k < sizeof...(Variants); ++k)
+                {
+                    if((index / stride(k)) % slots(k) == slots(k) - 1)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
             }
 
-            template<typename T, std::size_t... Is>
-            ResultType call_multivisitor(T&& value, std::index_sequence<Is...>)
+            template<std::size_t Index, std::size_t K, typename Variant>
+            static decltype(auto) alternative(Variant& variant)
             {
-                return std::forward<Visitor>(_visitor)(
-                    std::forward<std::tuple_element_t<Is, MatchedValues>>(std::get<Is>(_matchedValues))...,
-                    std::forward<T>(value)
+                using Type = typename Alternatives<Variant>::template type<
+                    (Index / stride(K)) % slots(K)
+                >;
+
+                return variant.template get<Type>();
+            }
+
+            template<std::size_t Index, std::size_t... Ks>
+            static ResultType dispatch(std::false_type, Visitor& visitor, Variants&... variants)
+            {
+                return visitor(alternative<Index, Ks>(variants)...);
+            }
+
+            template<std::size_t Index, std::size_t... Ks>
+            static ResultType dispatch(std::true_type, Visitor&, Variants&... variants)
+            {
+                const bool empty[] = {variants.empty()...};
+                const std::string strings[] = {variants.to_string()...};
+
+                for(std::size_t k = 0; k < sizeof...(Variants); ++k)
+                {
+                    if(empty[k])
+                    {
+                        throw std::runtime_error{"Cannot visit " + strings[k]};
+                    }
+                }
+
+                throw std::runtime_error{"Cannot visit empty variant"};
+            }
+
+            template<std::size_t Index, std::size_t... Ks>
+            static ResultType dispatch(Visitor& visitor, Variants&... variants)
+            {
+                return dispatch<Index, Ks...>(
+                    std::integral_constant<bool, has_empty(Index)>(),
+                    visitor,
+                    variants...
                 );
             }
-        private:
-            // Note parameters were not decayed, they conserve rl-qualifiers
-            Visitor _visitor; 
-            MatchedValues _matchedValues;
+
+            template<std::size_t... Ks, std::size_t... Is>
+            static ResultType dispatch(Visitor& visitor, std::size_t index, std::index_sequence<Ks...>, std::index_sequence<Is...>, Variants&... variants)
+            {
+                using dispatch_t = ResultType(*)(Visitor&, Variants&...);
+                static constexpr dispatch_t table[] = {
+                    &MultiVisitTable::dispatch<Is, Ks...>...
+                };
+
+                return table[index](visitor, variants...);
+            }
         };
     }
 
+    /**
+     * \brief Returns a function that visits all its variant arguments at once,
+     * calling the visitor with the active values of the variants
+     *
+     * The combination of alternatives is resolved with a single table lookup.
+     */
     template<typename T, typename... Visitors>
     auto multi_visitor(Visitors&&... visitors)
     {
-        return [&visitors...](auto&& variant, auto&&... variants)
+        auto visitor = cpp::visitor<T>(std::forward<Visitors>(visitors)...);
+
+        return [visitor](auto&& variant, auto&&... variants) mutable -> T
         {
-#if defined(_MSC_VER) && _MSC_VER == 1900 
-			auto processor = ::cpp::detail::make_visitor_processor(
-				cpp::visitor<T>(visitors...), // VS2015 compiler bug when perfect-forwarding here: ERROR "'Visitors' should be expanded in this context"
-				std::make_tuple(),
-				std::forward_as_tuple(std::forward<decltype(variants)>(variants)...)
-			);
-#else
-			auto processor = ::cpp::detail::make_visitor_processor(
-				cpp::visitor<T>(std::forward<Visitors>(visitors)...),
-				std::make_tuple(),
-				std::forward_as_tuple(std::forward<decltype(variants)>(variants)...)
-			);
-#endif
-            
-
-            return std::forward<decltype(variant)>(variant).template visit<T>(processor);
+            return ::cpp::detail::MultiVisitTable<
+                decltype(visitor),
+                std::remove_reference_t<decltype(variant)>,
+                std::remove_reference_t<decltype(variants)>...
+            >::visit(visitor, variant, variants...);
         };
     }
 }
@@ -6,31 +6,58 @@
 namespace cpp
 {
 
+template<typename T>
+class Optional;
+
+namespace detail
+{
+
+template<typename T>
+class IsOptional : public std::false_type {};
+
+template<typename T>
+class IsOptional<::cpp::Optional<T>> : public std::true_type {};
+
+}
+
 template<typename T>
 class Optional
 {
 public:
     Optional() = default;
 
-    template<typename Arg, typename... Args>
-    Optional(Arg&& arg, Args&&... args) :
-        _variant{T{std::forward<Arg>(arg), std::forward<Args>(args)...}}
-    {}
+    template<typename Arg, typename... Args, typename = std::enable_if_t<
+        (sizeof...(Args) > 0) || !detail::IsOptional<std::decay_t<Arg>>::value
+    >>
+    Optional(Arg&& arg, Args&&... args)
+    {
+        emplace(std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
 
     template<typename U>
-    Optional(const Optional<U>& other) :
-        Optional{other.empty() ? Optional() : other.get()}
-    {}
+    Optional(const Optional<U>& other)
+    {
+        if(!other.empty())
+        {
+            emplace(other.get());
+        }
+    }
 
     template<typename U>
-    Optional(Optional<U>&& other) :
-        Optional{other.empty() ? Optional() : std::move(std::move(other).get())}
-    {}
+    Optional(Optional<U>&& other)
+    {
+        if(!other.empty())
+        {
+            emplace(std::move(other.get()));
+        }
+    }
 
-    template<typename U>
+    template<typename U, typename = std::enable_if_t<
+        !detail::IsOptional<std::decay_t<U>>::value
+    >>
     Optional& operator=(U&& value)
     {
-        _variant = T{std::forward<U>(value)};
+        assign(std::forward<U>(value));
         return *this;
     }
 
@@ -43,7 +70,7 @@ public:
         }
         else
         {
-            _variant = other.get();
+            assign(other.get());
         }
 
         return *this;
@@ -58,12 +85,25 @@ public:
         }
         else
         {
-            _variant = std::move(std::move(other).get());
+            assign(std::move(other.get()));
         }
 
         return *this;
     }
 
+    /**
+     * \brief Destroys the current value (if any) and constructs a new
+     * one in place
+     *
+     * \param args Constructor arguments
+     * \returns A reference to the new value
+     */
+    template<typename... Args>
+    T& emplace(Args&&... args)
+    {
+        return _variant.template emplace<T>(std::forward<Args>(args)...);
+    }
+
     const T& get() const
     {
         return _variant.template get<T>();
@@ -101,6 +141,33 @@ public:
 
 private:
     cpp::Variant<T> _variant;
+
+    // Assigns to the current value if there's one, constructs
+    // the value in place otherwise
+    template<typename U>
+    void assign(U&& value)
+    {
+        assign(std::is_assignable<T&, U&&>(), std::forward<U>(value));
+    }
+
+    template<typename U>
+    void assign(std::true_type, U&& value)
+    {
+        if(empty())
+        {
+            emplace(std::forward<U>(value));
+        }
+        else
+        {
+            get() = std::forward<U>(value);
+        }
+    }
+
+    template<typename U>
+    void assign(std::false_type, U&& value)
+    {
+        emplace(std::forward<U>(value));
+    }
 };
 
 class Nothing
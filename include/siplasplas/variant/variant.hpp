@@ -3,322 +3,468 @@
 
 #include <type_traits>
 #include <ctti/type_id.hpp>
+#include <cstdint>
+#include <limits>
+#include <new>
 #include <ostream>
 #include <sstream>
+#include <stdexcept>
 
 #include "visitor.hpp"
 
 namespace cpp
 {
-    template<typename... Ts>
-    class Variant
+    namespace detail
     {
-    private:
-        std::string print_variant(const ctti::unnamed_type_id_t& id) const
-        {
-            std::ostringstream os;
-            
-            if(id != ctti::unnamed_type_id<void>())
-                os << "Variant{" << id.hash() << "}";
-            else
-                os << "Variant{[Empty]}";
+        template<typename T, typename... Ts>
+        struct VariantIndexOf;
 
-            return os.str();
-        }
-        void Throw(const std::string& operation, const ctti::unnamed_type_id_t& tag)
-        {   
-            throw std::runtime_error{print_variant(this->tag()) + 
-                ": Cannot " + operation + " " + print_variant(tag)};
-        }
-        
-        template<typename...>
-        struct typelist {};
+        template<typename T, typename... Tail>
+        struct VariantIndexOf<T, T, Tail...> : public std::integral_constant<std::size_t, 0>
+        {};
 
-        template<typename>
-        struct VariantExecutorImpl;
+        template<typename T, typename Head, typename... Tail>
+        struct VariantIndexOf<T, Head, Tail...> : public std::integral_constant<std::size_t,
+                1 + VariantIndexOf<T, Tail...>::value
+            >
+        {};
 
-        template<typename... Args>
-        using VariantExecutor = VariantExecutorImpl<typelist<Args...>>;
+        template<typename T>
+        struct VariantIndexOf<T> : public std::integral_constant<std::size_t, 0>
+        {};
+
+        template<typename T, typename... Ts>
+        struct VariantHasType : public std::integral_constant<bool,
+                (VariantIndexOf<T, Ts...>::value < sizeof...(Ts))
+            >
+        {};
+
+        // Smallest unsigned integer able to store the indices of Count alternatives
+        // plus the empty state
+        template<std::size_t Count>
+        using VariantIndex = std::conditional_t<
+            (Count < std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+            std::conditional_t<
+                (Count < std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+                std::uint32_t
+            >
+        >;
+
+        // Variant tag storing the index of the current alternative.
+        // The empty state is represented by the index sizeof...(Ts)
+        template<typename... Ts>
+        class VariantIndexTag
+        {
+        public:
+            using tag_t = VariantIndex<sizeof...(Ts)>;
 
-        template<typename Head, typename... Tail>
-        using NextVariantExecutor = VariantExecutorImpl<typelist<Tail...>>;
+            constexpr VariantIndexTag() :
+                _tag{static_cast<tag_t>(sizeof...(Ts))}
+            {}
 
-        template<typename Head>
-        struct VariantExecutorImpl<typelist<Head>>
-        {
-            template<typename T>
-            struct has_type_static : public std::is_same<T, Head>
-            {};
-            
-            static constexpr bool has_type(ctti::unnamed_type_id_t id)
+            constexpr tag_t tag() const
             {
-                return id == ctti::unnamed_type_id<Head>();
+                return _tag;
             }
-            
-            template<typename... Args>
-            static bool construct(Variant& v, Args&&... args)
+
+            constexpr std::size_t index() const
             {
-                if(v.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    new (v.rawStorage()) Head(std::forward<Args>(args)...);
-                    return !v.empty();
-                }
-                else
-                {
-                    return false;
-                }
+                return _tag;
             }
 
-            static bool destroy(Variant& v)
+            void setIndex(std::size_t index)
             {
-                // Take care of empty variants, destroying them is fine
-                // (Actually a nop)
-                if(v.empty())
-                    return true;
-
-                if(v.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    destructor_call<Head>::apply(v.storageAs<Head>());
-                    return true;
-                }
-                else
-                {
-                    return false;
-                }
+                _tag = static_cast<tag_t>(index);
             }
 
-            template<typename T, bool isClass = std::is_class<T>::value>
-            struct destructor_call
+        private:
+            tag_t _tag;
+        };
+
+        // Variant tag storing the type id of the current alternative, so the
+        // tag identifies the type across binaries. Indices are found by searching
+        // the tag in the sequence of alternative ids
+        template<typename... Ts>
+        class VariantHashTag
+        {
+        public:
+            using tag_t = ctti::unnamed_type_id_t;
+
+            constexpr VariantHashTag() :
+                _tag{ctti::unnamed_type_id<void>()}
+            {}
+
+            constexpr tag_t tag() const
             {
-                static void apply(T* obj){}
-            };
+                return _tag;
+            }
 
-            template<typename T>
-            struct destructor_call<T, true>
+            std::size_t index() const
             {
-                static void apply(T* obj)
+                static constexpr tag_t ids[] = {ctti::unnamed_type_id<Ts>()...};
+
+                for(std::size_t i = 0; i < sizeof...(Ts); ++i)
                 {
-                    obj->~T();
+                    if(ids[i] == _tag)
+                    {
+                        return i;
+                    }
                 }
-            };
-            
-            static bool move(Variant& v, Variant&& other)
+
+                return sizeof...(Ts);
+            }
+
+            void setIndex(std::size_t index)
             {
-                if(other.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    new(v.rawStorage()) Head(std::move(other.get<Head>()));
+                static constexpr tag_t ids[] = {ctti::unnamed_type_id<Ts>()..., ctti::unnamed_type_id<void>()};
+                _tag = ids[index];
+            }
 
-                    v.tag() = other.tag();
-                    other.tag() = ctti::unnamed_type_id<void>();
+        private:
+            tag_t _tag;
+        };
 
-                    return !v.empty() && other.empty();
-                }
-                else
-                {
-                    return false;
-                }
+#ifdef SIPLASPLAS_VARIANT_HASH_TAG
+        template<typename... Ts>
+        using VariantTag = VariantHashTag<Ts...>;
+#else
+        template<typename... Ts>
+        using VariantTag = VariantIndexTag<Ts...>;
+#endif
+
+        // Constructs a T in place, using brace initialization for
+        // aggregates with no matching constructor
+        template<typename T, typename... Args>
+        void variant_construct(std::true_type, void* where, Args&&... args)
+        {
+            new (where) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T, typename... Args>
+        void variant_construct(std::false_type, void* where, Args&&... args)
+        {
+            new (where) T{std::forward<Args>(args)...};
+        }
+
+        template<typename T, typename... Args>
+        void variant_construct(void* where, Args&&... args)
+        {
+            variant_construct<T>(std::is_constructible<T, Args...>(), where, std::forward<Args>(args)...);
+        }
+
+        template<typename... Ts>
+        struct VariantIsTrivial;
+
+        template<>
+        struct VariantIsTrivial<> : public std::true_type
+        {};
+
+        template<typename Head, typename... Tail>
+        struct VariantIsTrivial<Head, Tail...> : public std::integral_constant<bool,
+                std::is_trivially_copyable<Head>::value &&
+                std::is_trivially_destructible<Head>::value &&
+                VariantIsTrivial<Tail...>::value
+            >
+        {};
+
+        // Storage and tag of a variant, with the table based operations
+        // on the active alternative
+        template<typename... Ts>
+        class VariantStorage
+        {
+        public:
+            std::size_t index() const
+            {
+                return _tag.index();
             }
 
-            static bool copy(Variant& v, const Variant& other)
+        protected:
+            using Tag = VariantTag<Ts...>;
+            using storage_t = typename std::aligned_union<0, Ts...>::type;
+
+            storage_t _storage;
+            Tag _tag;
+
+            void* rawStorage()
             {
-                if(other.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    new(v.rawStorage()) Head(other.get<Head>());
-                    v.tag() = other.tag();
-             
-                    return !v.empty();
-                }
-                else
-                {
-                    return false;
-                }
+                return std::addressof(_storage);
             }
 
-            static bool move_assign(Variant& v, Variant&& other)
+            const void* rawStorage() const
             {
-                if(other.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    if(v.tag() == other.tag())
-                    {
-                        v.get<Head>() = std::move(other.get<Head>());
-                        return true;
-                    }
-                    else
-                    {
-                        if(VariantExecutor<Ts...>::destroy(v))
-                        {
-                            new (v.rawStorage()) Head( std::move(other.get<Head>()) );
-                            v.tag() = ctti::unnamed_type_id<Head>();
-                            other.tag() = ctti::unnamed_type_id<void>();
-
-                            return !v.empty() && other.empty();
-                        }
-                        else
-                        {
-                            return false;
-                        }
-                    }
-                }
-                else
-                {
-                    return false;
-                }
+                return std::addressof(_storage);
             }
 
-            static bool copy_assign(Variant& v, const Variant& other)
+            void destroy()
             {
-                if(other.tag() == ctti::unnamed_type_id<Head>())
+                if(VariantIsTrivial<Ts...>::value)
                 {
-                    if(v.tag() == other.tag())
-                    {
-                        v.get<Head>() = other.get<Head>();
-                        return true;
-                    }
-                    else
-                    {   
-                        if(VariantExecutor<Ts...>::destroy(v))
-                        {
-                            return VariantExecutor<Ts...>::copy(v, other);
-                        }
-                        else
-                        {
-                            return false;
-                        }
-                    }
-                }
-                else
-                {
-                    return false;            
+                    return;
                 }
+
+                using operation_t = void(*)(void*);
+                static constexpr operation_t operations[] = {
+                    &VariantStorage::destroy_alternative<Ts>..., &VariantStorage::empty_operation
+                };
+
+                operations[index()](rawStorage());
             }
 
-            template<typename F>
-            static typename F::ResultType const_visit(const Variant& v, F f)
+            void copy(const VariantStorage& other)
             {
-                if(v.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    return f(v.get<Head>());
-                }
-                else
-                {
-                    throw std::runtime_error{"Cannot visit " + v.print_variant(v.tag())};
-                }
+                using operation_t = void(*)(void*, const void*);
+                static constexpr operation_t operations[] = {
+                    &VariantStorage::copy_alternative<Ts>..., &VariantStorage::empty_operation
+                };
+
+                operations[other.index()](rawStorage(), other.rawStorage());
+                _tag.setIndex(other.index());
             }
-            
-            template<typename F>
-            static typename F::ResultType visit(Variant& v, F f)
+
+            void move(VariantStorage& other)
             {
-                if(v.tag() == ctti::unnamed_type_id<Head>())
-                {
-                    return f(v.get<Head>());
-                }
-                else
-                {
-                    throw std::runtime_error{ "Cannot visit " + v.print_variant(v.tag())};
-                }
+                using operation_t = void(*)(void*, void*);
+                static constexpr operation_t operations[] = {
+                    &VariantStorage::move_alternative<Ts>..., &VariantStorage::empty_operation
+                };
+
+                operations[other.index()](rawStorage(), other.rawStorage());
+                _tag.setIndex(other.index());
+                other.destroy();
+                other._tag.setIndex(sizeof...(Ts));
             }
-        };
 
-        template<typename Head, typename Second, typename... Tail>
-        struct VariantExecutorImpl<typelist<Head, Second, Tail...>>
-        {
+            void copy_assign(const VariantStorage& other)
+            {
+                using operation_t = void(*)(void*, const void*);
+                static constexpr operation_t operations[] = {
+                    &VariantStorage::copy_assign_alternative<Ts>..., &VariantStorage::empty_operation
+                };
+
+                operations[index()](rawStorage(), other.rawStorage());
+            }
+
+            void move_assign(VariantStorage& other)
+            {
+                using operation_t = void(*)(void*, void*);
+                static constexpr operation_t operations[] = {
+                    &VariantStorage::move_assign_alternative<Ts>..., &VariantStorage::empty_operation
+                };
+
+                operations[index()](rawStorage(), other.rawStorage());
+            }
+
+        private:
             template<typename T>
-            struct has_type_static : public std::integral_constant<bool, 
-                    std::is_same<T, Head>::value || VariantExecutor<Second, Tail...>::template has_type_static<T>::value
-                >
-            {};
-            
-            static constexpr bool has_type(ctti::unnamed_type_id_t id)
+            static void destroy_alternative(void* storage)
             {
-                return VariantExecutor<Head>::has_type(id) && VariantExecutor<Second, Tail...>::has_type(id); 
+                reinterpret_cast<T*>(storage)->~T();
             }
-            
-            template<typename... Args>
-            static bool construct(Variant& v, Args&&... args)
+
+            template<typename T>
+            static void copy_alternative(void* storage, const void* other)
             {
-                return VariantExecutor<Head>::construct(v, std::forward<Args>(args)...) ||
-                       VariantExecutor<Second, Tail...>::construct(v, std::forward<Args>(args)...);
+                new (storage) T(*reinterpret_cast<const T*>(other));
             }
 
-            static bool destroy(Variant& v)
+            template<typename T>
+            static void move_alternative(void* storage, void* other)
             {
-                return VariantExecutor<Head>::destroy(v) || VariantExecutor<Second, Tail...>::destroy(v);
+                new (storage) T(std::move(*reinterpret_cast<T*>(other)));
             }
 
-            static bool move(Variant& v, Variant&& other)
+            template<typename T>
+            static void copy_assign_alternative(void* storage, const void* other)
             {
-                return VariantExecutor<Head>::move(v, std::move(other)) || 
-                       VariantExecutor<Second, Tail...>::move(v, std::move(other));
+                *reinterpret_cast<T*>(storage) = *reinterpret_cast<const T*>(other);
             }
 
-            static bool copy(Variant& v, const Variant& other)
+            template<typename T>
+            static void move_assign_alternative(void* storage, void* other)
             {
-                return VariantExecutor<Head>::copy(v, other) ||
-                       VariantExecutor<Second, Tail...>::copy(v, other);
+                *reinterpret_cast<T*>(storage) = std::move(*reinterpret_cast<T*>(other));
             }
 
-            static bool move_assign(Variant& v, Variant&& other)
+            // Empty variants have nothing to destroy, copy, nor move
+            static void empty_operation(void*) {}
+            static void empty_operation(void*, const void*) {}
+            static void empty_operation(void*, void*) {}
+        };
+
+        // Variant special member functions. If all the alternatives are
+        // trivially copyable and destructible the defaulted ones are used,
+        // so the variant is trivially copyable and destructible too
+        template<bool Trivial, typename... Ts>
+        class VariantBase;
+
+        template<typename... Ts>
+        class VariantBase<true, Ts...> : public VariantStorage<Ts...>
+        {};
+
+        template<typename... Ts>
+        class VariantBase<false, Ts...> : public VariantStorage<Ts...>
+        {
+        public:
+            VariantBase() = default;
+
+            VariantBase(const VariantBase& other)
             {
-                return VariantExecutor<Head>::move_assign(v, std::move(other)) ||
-                       VariantExecutor<Second, Tail...>::move_assign(v, std::move(other));
+                this->copy(other);
             }
 
-            static bool copy_assign(Variant& v, const Variant& other)
+            VariantBase(VariantBase&& other)
             {
-                return VariantExecutor<Head>::copy_assign(v, other) ||
-                       VariantExecutor<Second, Tail...>::copy_assign(v, other);
+                this->move(other);
             }
 
-            template<typename F>
-            static typename F::ResultType const_visit(const Variant& v, F f)
+            VariantBase& operator=(const VariantBase& other)
             {
-                if(v.tag() == ctti::unnamed_type_id<Head>())
+                if(this->index() == other.index())
                 {
-                    return f(v.get<Head>());
+                    this->copy_assign(other);
                 }
                 else
                 {
-                    return NextVariantExecutor<Head, Second, Tail...>::const_visit(v, f);
+                    this->destroy();
+                    this->copy(other);
                 }
+
+                return *this;
             }
-            
-            template<typename F>
-            static typename F::ResultType visit(Variant& v, F f)
+
+            VariantBase& operator=(VariantBase&& other)
             {
-                if(v.tag() == ctti::unnamed_type_id<Head>())
+                if(this->index() == other.index())
                 {
-                    return f(v.get<Head>());
+                    this->move_assign(other);
                 }
                 else
                 {
-                    return NextVariantExecutor<Head, Second, Tail...>::visit(v, f);
+                    this->destroy();
+                    this->move(other);
                 }
+
+                return *this;
+            }
+
+            ~VariantBase()
+            {
+                this->destroy();
             }
         };
+    }
+
+    /**
+     * \brief A discriminated union of the types Ts...
+     *
+     * The active alternative is identified by a tag storing its index, using the
+     * smallest unsigned integer type able to hold `sizeof...(Ts) + 1` values. Visitation
+     * and the special member functions dispatch in constant time through per-alternative
+     * function pointer tables.
+     *
+     * If all the alternatives are trivially copyable and trivially destructible the
+     * variant is trivially copyable and trivially destructible too, so arrays of variants
+     * can be copied with `std::memcpy()`. Note moving from such variant copies the value and
+     * leaves the source untouched, while moving from a non-trivial variant leaves it empty.
+     *
+     * Define `SIPLASPLAS_VARIANT_HASH_TAG` to store the `ctti::unnamed_type_id_t` of the
+     * active alternative as tag instead, so the tag identifies the type across binaries.
+     */
+    template<typename... Ts>
+    class Variant : public ::cpp::detail::VariantBase<::cpp::detail::VariantIsTrivial<Ts...>::value, Ts...>
+    {
+    private:
+        using Tag = ::cpp::detail::VariantTag<Ts...>;
+
+        std::string print_variant(const ctti::unnamed_type_id_t& id) const
+        {
+            std::ostringstream os;
+
+            if(id != ctti::unnamed_type_id<void>())
+                os << "Variant{" << id.hash() << "}";
+            else
+                os << "Variant{[Empty]}";
+
+            return os.str();
+        }
+
+        template<typename F, typename T>
+        static typename F::ResultType visit_alternative(Variant& v, F& f)
+        {
+            return f(v.get<T>());
+        }
+
+        template<typename F, typename T>
+        static typename F::ResultType const_visit_alternative(const Variant& v, F& f)
+        {
+            return f(v.get<T>());
+        }
+
+        template<typename F, typename V>
+        static typename F::ResultType visit_empty(V& v, F&)
+        {
+            throw std::runtime_error{"Cannot visit " + v.to_string()};
+        }
 
     public:
-        using tag_t = ctti::unnamed_type_id_t;
+        using tag_t = typename Tag::tag_t;
+
+        /**
+         * \brief Returns the index of the alternative T in the variant
+         * alternatives list
+         */
+        template<typename T>
+        static constexpr std::size_t index_of()
+        {
+            return ::cpp::detail::VariantIndexOf<T, Ts...>::value;
+        }
 
-        const tag_t& tag() const
+        /**
+         * \brief Checks whether T is one of the variant alternatives
+         */
+        template<typename T>
+        static constexpr bool has_type()
         {
-            return _tag;
+            return ::cpp::detail::VariantHasType<T, Ts...>::value;
         }
 
-        tag_t& tag()
+        tag_t tag() const
         {
-            return _tag;
+            return this->_tag.tag();
+        }
+
+        /**
+         * \brief Returns the index of the active alternative, `sizeof...(Ts)`
+         * if the variant is empty
+         */
+        std::size_t index() const
+        {
+            return this->_tag.index();
+        }
+
+        /**
+         * \brief Returns the type id of the active alternative,
+         * `ctti::unnamed_type_id<void>()` if the variant is empty
+         */
+        ctti::unnamed_type_id_t type_id() const
+        {
+            static constexpr ctti::unnamed_type_id_t ids[] = {
+                ctti::unnamed_type_id<Ts>()..., ctti::unnamed_type_id<void>()
+            };
+
+            return ids[index()];
         }
 
         std::string to_string() const
         {
-            return print_variant(tag());
+            return print_variant(type_id());
         }
 
         bool empty() const
         {
-            return _tag == ctti::unnamed_type_id<void>();
+            return index() == sizeof...(Ts);
         }
-        
+
         explicit operator bool() const
         {
             return !empty();
@@ -326,8 +472,8 @@ namespace cpp
 
         void clear()
         {
-            VariantExecutor<Ts...>::destroy(*this);
-            _tag = ctti::unnamed_type_id<void>();
+            this->destroy();
+            this->_tag.setIndex(sizeof...(Ts));
         }
 
         template<typename T>
@@ -344,109 +490,88 @@ namespace cpp
 
         Variant() = default;
 
-        Variant(const Variant& other)
+        template<typename T, typename = std::enable_if_t<::cpp::detail::VariantHasType<std::decay_t<T>, Ts...>::value>>
+        Variant(T&& value)
         {
-            auto tag = other.tag();
-
-            if(!other.empty())
-            {
-                if(!VariantExecutor<Ts...>::copy(*this, other))
-                    Throw("copy construct from", tag);
-            }
+            new (this->rawStorage()) std::decay_t<T>(std::forward<T>(value));
+            this->_tag.setIndex(index_of<std::decay_t<T>>());
         }
 
-        Variant(Variant&& other) :
-            _tag{other.tag()}
+        /**
+         * \brief Assigns a value to the variant
+         *
+         * If the active alternative is the type of the value, the value is
+         * assigned to it. Else the current alternative is destroyed and the value
+         * is copied or moved in place
+         */
+        template<typename T, typename = std::enable_if_t<::cpp::detail::VariantHasType<std::decay_t<T>, Ts...>::value>>
+        Variant& operator=(T&& value)
         {
-            auto tag = other.tag();
-
-            if(!other.empty())
+            if(index() == index_of<std::decay_t<T>>())
             {
-                if(!VariantExecutor<Ts...>::move(*this, std::move(other)))
-                    Throw("move-construct from", tag);
+                get<std::decay_t<T>>() = std::forward<T>(value);
             }
-        }
-
-        template<typename T, typename = std::enable_if_t<VariantExecutor<Ts...>::template has_type_static<std::decay_t<T>>::value>>
-        Variant(T&& value) :
-            _tag{ctti::unnamed_type_id<typename std::decay<T>::type>()}
-        {
-            if(VariantExecutor<Ts...>::template has_type_static<std::decay_t<T>>::value)
-                new (rawStorage()) std::decay_t<T>{std::forward<T>(value)};
             else
-                Throw("construct from", _tag);
-        }
-
-        ~Variant()
-        {
-            auto tag = this->tag();
-
-            if(!empty())
             {
-                if(!VariantExecutor<Ts...>::destroy(*this))
-                    Throw("destroy", tag);
+                emplace<std::decay_t<T>>(std::forward<T>(value));
             }
-        }
 
-        template<typename T, typename = std::enable_if_t<VariantExecutor<Ts...>::template has_type_static<std::decay_t<T>>::value>>
-        Variant& operator=(T&& value)
-        {
-            Variant variant{std::forward<T>(value)};
-            return (*this) = std::move(variant);
-        }
-
-        Variant& operator=(const Variant& other)
-        {
-            auto tag = other.tag();
-
-            if(other.empty())
-                clear();
-            else
-                if(!VariantExecutor<Ts...>::copy_assign(*this, other))
-                    Throw("copy-assign from", tag);
-            
             return *this;
         }
 
-        Variant& operator=(Variant&& other)
+        /**
+         * \brief Destroys the active alternative and constructs a T in place
+         *
+         * If the construction throws the variant is left empty
+         *
+         * \tparam T Alternative to construct. Must be one of Ts...
+         * \param args Constructor arguments
+         * \returns A reference to the new value
+         */
+        template<typename T, typename... Args>
+        T& emplace(Args&&... args)
         {
-            auto tag = other.tag();
+            static_assert(has_type<T>(), "T is not one of the variant alternatives");
 
-            if(other.empty())
-            {
-                clear();       
-            }
-            else
-            {
-                if(!VariantExecutor<Ts...>::move_assign(*this, std::move(other)))
-                    Throw("move-assign from", tag);
-            }
-             
-            return *this;
+            clear();
+            ::cpp::detail::variant_construct<T>(this->rawStorage(), std::forward<Args>(args)...);
+            this->_tag.setIndex(index_of<T>());
+
+            return get<T>();
         }
 
         template<typename Result, typename... Fs>
         Result visit(Fs... fs)
         {
-            return VariantExecutor<Ts...>::visit(*this, ::cpp::visitor<Result>(fs...));
+            return visit(::cpp::visitor<Result>(fs...));
         }
 
         template<typename Result, typename... Fs>
         Result visit(Fs... fs) const
         {
-            return VariantExecutor<Ts...>::const_visit(*this, ::cpp::visitor<Result>(fs...));
+            return visit(::cpp::visitor<Result>(fs...));
         }
 
         template<typename F>
         typename F::ResultType visit(F f)
         {
-            return VariantExecutor<Ts...>::visit(*this, f);
+            using visit_t = typename F::ResultType(*)(Variant&, F&);
+            static constexpr visit_t visitors[] = {
+                &Variant::visit_alternative<F, Ts>..., &Variant::visit_empty<F, Variant>
+            };
+
+            return visitors[index()](*this, f);
         }
 
         template<typename F>
         typename F::ResultType visit(F f) const
         {
-            return VariantExecutor<Ts...>::const_visit(*this, f);
+            using visit_t = typename F::ResultType(*)(const Variant&, F&);
+            static constexpr visit_t visitors[] = {
+                &Variant::const_visit_alternative<F, Ts>..., &Variant::visit_empty<F, const Variant>
+            };
+
+            return visitors[index()](*this, f);
         }
 
         friend bool operator!=(const Variant& lhs, const Variant& rhs)
@@ -463,33 +588,18 @@ namespace cpp
 				}
 			);
 		}
- 
-    private:
-        using storage_t = typename std::aligned_union<0, Ts...>::type;
-        
-        tag_t _tag = ctti::unnamed_type_id<void>();
-        storage_t _storage;
-
-        void* rawStorage()
-        {
-            return std::addressof(_storage);
-        }
-
-        const void* rawStorage() const
-        {
-            return std::addressof(_storage);
-        }
 
+    private:
         template<typename T>
         T* storageAs()
         {
-            return reinterpret_cast<T*>(rawStorage());
+            return reinterpret_cast<T*>(this->rawStorage());
         }
 
         template<typename T>
         const T* storageAs() const
         {
-            return reinterpret_cast<const T*>(rawStorage());
+            return reinterpret_cast<const T*>(this->rawStorage());
         }
     };
 }
@@ -0,0 +1,289 @@
+#ifndef SIPLASPLAS_VARIANT_VARIANTVECTOR_HPP
+#define SIPLASPLAS_VARIANT_VARIANTVECTOR_HPP
+
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "variant.hpp"
+
+namespace cpp
+{
+    /**
+     * \brief A sequence of values of types Ts... partitioned by type
+     *
+     * Instead of storing a `cpp::Variant<Ts...>` per element (one tag plus storage
+     * padded to the largest alternative), each alternative is stored in its own
+     * contiguous array. Insertion order is kept in a separate array with the index
+     * of the alternative of each element, using the same compact index type than
+     * `cpp::Variant<Ts...>`.
+     *
+     * Elements can be visited in insertion order (one table dispatch per element, as
+     * visiting a variant) or in bulk, one alternative at a time, with plain loops over the
+     * partitions:
+     *
+     * ``` cpp
+     * cpp::VariantVector<int, float, std::string> vector;
+     * vector.push_back(1);
+     * vector.push_back("hello"s);
+     * vector.push_back(2.0f);
+     *
+     * vector.visit([](const auto& value) { std::cout << value; });             // 1hello2
+     * vector.visit_type<int>([](int& value) { value *= 2; });                 // Tight loop over ints
+     * vector.visit_partitions([](const auto& value) { std::cout << value; }); // 22hello
+     * ```
+     *
+     * Elements are not randomly accessible by position, since locating the i-th element
+     * in its partition requires counting the previous elements of the same alternative.
+     */
+    template<typename... Ts>
+    class VariantVector
+    {
+    public:
+        using index_t = ::cpp::detail::VariantIndex<sizeof...(Ts)>;
+
+        /**
+         * \brief Returns the number of elements
+         */
+        std::size_t size() const
+        {
+            return _order.size();
+        }
+
+        /**
+         * \brief Checks whether the vector has no elements
+         */
+        bool empty() const
+        {
+            return _order.empty();
+        }
+
+        /**
+         * \brief Returns the index of the alternative of the i-th element
+         */
+        std::size_t index(std::size_t i) const
+        {
+            return _order[i];
+        }
+
+        /**
+         * \brief Returns the number of elements of type T
+         */
+        template<typename T>
+        std::size_t count() const
+        {
+            return partition<T>().size();
+        }
+
+        /**
+         * \brief Returns a pointer to the contiguous array of elements of type T,
+         * in insertion order
+         */
+        template<typename T>
+        T* data()
+        {
+            return partition<T>().data();
+        }
+
+        /**
+         * \brief Returns a pointer to the contiguous array of elements of type T,
+         * in insertion order
+         */
+        template<typename T>
+        const T* data() const
+        {
+            return partition<T>().data();
+        }
+
+        /**
+         * \brief Constructs a T in place at the end of the sequence
+         *
+         * \returns A reference to the new element
+         */
+        template<typename T, typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            auto& values = partition<T>();
+            values.emplace_back(std::forward<Args>(args)...);
+            _order.push_back(static_cast<index_t>(index_of<T>()));
+
+            return values.back();
+        }
+
+        /**
+         * \brief Inserts a value at the end of the sequence
+         */
+        template<typename T, typename = std::enable_if_t<::cpp::detail::VariantHasType<std::decay_t<T>, Ts...>::value>>
+        void push_back(T&& value)
+        {
+            emplace_back<std::decay_t<T>>(std::forward<T>(value));
+        }
+
+        /**
+         * \brief Inserts the active value of a variant at the end of the sequence.
+         * Empty variants are ignored
+         */
+        void push_back(const ::cpp::Variant<Ts...>& variant)
+        {
+            if(!variant.empty())
+            {
+                variant.template visit<void>([this](const auto& value)
+                {
+                    this->push_back(value);
+                });
+            }
+        }
+
+        /**
+         * \brief Reserves space for \p count elements of type T
+         */
+        template<typename T>
+        void reserve(std::size_t count)
+        {
+            partition<T>().reserve(count);
+        }
+
+        /**
+         * \brief Reserves space for \p count elements in the insertion order index
+         */
+        void reserve(std::size_t count)
+        {
+            _order.reserve(count);
+        }
+
+        /**
+         * \brief Destroys all the elements
+         */
+        void clear()
+        {
+            clear(std::index_sequence_for<Ts...>());
+        }
+
+        /**
+         * \brief Visits all the elements in insertion order
+         */
+        template<typename... Fs>
+        void visit(Fs... fs)
+        {
+            visit_ordered(*this, ::cpp::visitor<void>(fs...), std::index_sequence_for<Ts...>());
+        }
+
+        /**
+         * \brief Visits all the elements in insertion order
+         */
+        template<typename... Fs>
+        void visit(Fs... fs) const
+        {
+            visit_ordered(*this, ::cpp::visitor<void>(fs...), std::index_sequence_for<Ts...>());
+        }
+
+        /**
+         * \brief Visits all the elements of type T, in insertion order
+         */
+        template<typename T, typename F>
+        void visit_type(F f)
+        {
+            for(T& value : partition<T>())
+            {
+                f(value);
+            }
+        }
+
+        /**
+         * \brief Visits all the elements of type T, in insertion order
+         */
+        template<typename T, typename F>
+        void visit_type(F f) const
+        {
+            for(const T& value : partition<T>())
+            {
+                f(value);
+            }
+        }
+
+        /**
+         * \brief Visits all the elements grouped by type, in the order of the
+         * alternatives. Relative insertion order is kept within each type
+         */
+        template<typename... Fs>
+        void visit_partitions(Fs... fs)
+        {
+            visit_grouped(*this, ::cpp::visitor<void>(fs...), std::index_sequence_for<Ts...>());
+        }
+
+        /**
+         * \brief Visits all the elements grouped by type, in the order of the
+         * alternatives. Relative insertion order is kept within each type
+         */
+        template<typename... Fs>
+        void visit_partitions(Fs... fs) const
+        {
+            visit_grouped(*this, ::cpp::visitor<void>(fs...), std::index_sequence_for<Ts...>());
+        }
+
+    private:
+        std::tuple<std::vector<Ts>...> _partitions;
+        std::vector<index_t> _order;
+
+        template<typename T>
+        static constexpr std::size_t index_of()
+        {
+            static_assert(::cpp::detail::VariantHasType<T, Ts...>::value, "T is not one of the vector alternatives");
+            return ::cpp::detail::VariantIndexOf<T, Ts...>::value;
+        }
+
+        template<typename T>
+        std::vector<T>& partition()
+        {
+            return std::get<index_of<T>()>(_partitions);
+        }
+
+        template<typename T>
+        const std::vector<T>& partition() const
+        {
+            return std::get<index_of<T>()>(_partitions);
+        }
+
+        template<std::size_t... Is>
+        void clear(std::index_sequence<Is...>)
+        {
+            const int dummy[] = {(std::get<Is>(_partitions).clear(), 0)..., 0};
+            (void)dummy;
+            _order.clear();
+        }
+
+        template<typename Vector, typename F, std::size_t... Is>
+        static void visit_grouped(Vector& vector, F f, std::index_sequence<Is...>)
+        {
+            const int dummy[] = {(vector.template visit_type<Ts>(std::ref(f)), 0)..., 0};
+            (void)dummy;
+        }
+
+        // Visits the next element of the I-th partition. Positions[I] is
+        // the number of elements of that partition already visited
+        template<std::size_t I, typename Vector, typename F>
+        static void visit_next(Vector& vector, F& f, std::size_t* positions)
+        {
+            f(std::get<I>(vector._partitions)[positions[I]++]);
+        }
+
+        template<typename Vector, typename F, std::size_t... Is>
+        static void visit_ordered(Vector& vector, F f, std::index_sequence<Is...>)
+        {
+            using visit_t = void(*)(Vector&, F&, std::size_t*);
+            static constexpr visit_t visitors[] = {
+                &VariantVector::visit_next<Is, Vector, F>...
+            };
+
+            std::size_t positions[sizeof...(Ts)] = {};
+
+            for(index_t index : vector._order)
+            {
+                visitors[index](vector, f, positions);
+            }
+        }
+    };
+}
+
+#endif // SIPLASPLAS_VARIANT_VARIANTVECTOR_HPP
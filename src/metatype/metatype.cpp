@@ -7,26 +7,22 @@ using namespace cpp;
 
 MetaTypeSystem::MetaTypeRegistry MetaTypeSystem::registry;
 
-void* MetaTypeSystem::create(const std::string& typeName)
+void* MetaTypeSystem::create(const char* typeName, std::size_t length)
 {
-	// MSVC mangling adds struct/class qualifiers to type names
-    std::string className = "class " + typeName;
-    std::string structName = "struct " + typeName;
-
-    void* result = nullptr;
+    // The registry ignores the struct/class qualifiers added by MSVC
+    auto* metaType = registry.find(typeName, length);
 
-    if (!(result = try_create(typeName)))
+    if(metaType == nullptr)
     {
-        if (!(result = try_create(className)))
-        {
-            if (!(result = try_create(structName)))
-            {
-                throw std::runtime_error{"No type found"};
-            }
-        }
+        throw std::runtime_error{"No type found"};
     }
 
-    return result;
+    return (*metaType)->create();
+}
+
+void* MetaTypeSystem::create(const std::string& typeName)
+{
+    return create(typeName.c_str(), typeName.size());
 }
 
 std::string MetaTypeSystem::dump()
@@ -35,28 +31,10 @@ std::string MetaTypeSystem::dump()
 
     os << "[METATYPE_SYSTEM] REGISTRY DUMP:" << std::endl;
 
-    for(const auto& keyValue : registry)
+    for(const auto& entry : registry.entries())
     {
-        const auto& id = keyValue.first;
-
-        os << " - Hash: " << id.hash() << std::endl;
+        os << " - Hash: " << entry.id << " (" << entry.name << ")" << std::endl;
     }
 
     return os.str();
 }
-
-void* MetaTypeSystem::try_create(const std::string& typeName)
-{
-    auto id = ctti::id_from_name(typeName);
-
-    auto it = registry.find(id);
-
-    if (it != registry.end())
-    {
-        return it->second->create();
-    }
-    else
-    {
-        return nullptr;
-    }
-}
@@ -1,4 +1,5 @@
 #include "class.hpp"
+#include "runtime.hpp"
 #include <siplasplas/utility/exception.hpp>
 
 using namespace cpp;
@@ -6,7 +7,8 @@ using namespace cpp::dynamic_reflection;
 
 Class::Class(const SourceInfo& sourceInfo, const cpp::typeerasure::TypeInfo& typeInfo) :
     Entity{sourceInfo},
-    _typeInfo{typeInfo}
+    _typeInfo{typeInfo},
+    _methodsChildrenCount{0}
 {}
 
 std::shared_ptr<Class> Class::create(const SourceInfo& sourceInfo, const cpp::typeerasure::TypeInfo& typeInfo)
@@ -14,6 +16,11 @@ std::shared_ptr<Class> Class::create(const SourceInfo& sourceInfo, const cpp::ty
     return std::shared_ptr<Class>{ new Class{sourceInfo, typeInfo} };
 }
 
+std::shared_ptr<Entity> Class::clone() const
+{
+    return std::shared_ptr<Class>{ new Class{*this} };
+}
+
 Class& Class::fromEntity(const std::shared_ptr<Entity>& entity)
 {
     if(entity->sourceInfo().kind() == SourceInfo::Kind::CLASS)
@@ -54,15 +61,35 @@ const cpp::typeerasure::TypeInfo& Class::typeInfo() const
     return _typeInfo;
 }
 
-cpp::Any32 Class::create()
+const std::shared_ptr<const cpp::Any32::Methods>& Class::methods()
 {
-    cpp::Any32 any{typeInfo()};
-
-    for(const auto& method : getChildrenNamesByKind(cpp::static_reflection::Kind::FUNCTION))
+    // Children are only appended, so a different count means
+    // new members since the table was built
+    if(_methods == nullptr || _methodsChildrenCount != children().size())
     {
-        auto& entity = getChildByFullName(method);
-        any(entity.name()) = Function::fromEntity(entity.pointer()).getFunction();
+        auto methods = std::make_shared<cpp::Any32::Methods>();
+
+        for(Entity::Id id : children())
+        {
+            auto& entity = runtime().getEntity(id);
+
+            if(entity.kind() == cpp::static_reflection::Kind::FUNCTION)
+            {
+                (*methods)[entity.name()] = Function::fromEntity(entity.pointer()).getFunction();
+            }
+        }
+
+        _methods = std::move(methods);
+        _methodsChildrenCount = children().size();
     }
 
+    return _methods;
+}
+
+cpp::Any32 Class::create()
+{
+    cpp::Any32 any{typeInfo()};
+    any.setMethods(methods());
+
     return any;
 }
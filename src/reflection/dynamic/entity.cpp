@@ -5,15 +5,23 @@
 using namespace cpp;
 using namespace dynamic_reflection;
 
+constexpr Entity::Id Entity::InvalidId;
+
 Entity::Entity(const SourceInfo& sourceInfo) :
-    _parent{},
     _runtime{nullptr},
+    _id{InvalidId},
+    _parent{InvalidId},
     _sourceInfo{sourceInfo}
 {}
 
+Entity::Id Entity::id() const
+{
+    return _id;
+}
+
 Entity& Entity::parent()
 {
-    return *_parent.lock();
+    return runtime().getEntity(_parent);
 }
 
 Runtime& Entity::runtime()
@@ -48,7 +56,7 @@ bool Entity::detached() const
 
 bool Entity::orphan() const
 {
-    return _parent.expired();
+    return _parent == InvalidId;
 }
 
 std::shared_ptr<Entity> Entity::pointer()
@@ -74,7 +82,13 @@ void Entity::attach(const std::weak_ptr<Entity>& parent)
 
     if(orphan())
     {
-        _parent = parent;
+        if(sharedParent->id() == InvalidId)
+        {
+            throw cpp::exception<std::runtime_error>(
+                "Cannot attach entity '{}' to parent entity '{}', the parent is not registered in a runtime",
+                fullName(), sharedParent->fullName()
+            );
+        }
 
         if(detached())
         {
@@ -92,6 +106,8 @@ void Entity::attach(const std::weak_ptr<Entity>& parent)
                 );
             }
         }
+
+        _parent = sharedParent->id();
     }
     else
     {
@@ -106,49 +122,92 @@ void Entity::attach(const std::weak_ptr<Entity>& parent)
 
 Entity& Entity::getChildByFullName(const std::string& fullName)
 {
-    auto it = _children.find(fullName);
+    if(!detached())
+    {
+        const Id id = runtime().lookup(fullName);
+
+        if(id != InvalidId && runtime().getEntity(id)._parent == _id)
+        {
+            return runtime().getEntity(id);
+        }
+    }
+
+    throw cpp::exception<std::runtime_error>(
+        "Entity '{}' has no child '{}'",
+        this->fullName(), fullName
+    );
+}
+
+Entity& Entity::getChildByName(const std::string& name)
+{
+    Entity* child = detached() ? nullptr : runtime().findChild(_id, name);
 
-    if(it != _children.end())
+    if(child != nullptr)
     {
-        return runtime().getEntity(fullName);
+        return *child;
     }
     else
     {
         throw cpp::exception<std::runtime_error>(
             "Entity '{}' has no child '{}'",
-            this->fullName(), fullName
+            fullName(), name
         );
     }
 }
 
-Entity& Entity::getChildByName(const std::string& name)
-{
-    return getChildByFullName(Scope::fromParentScope(sourceInfo().scope(), name).fullName());
-}
-
 std::vector<std::string> Entity::getChildrenNamesByKind(const SourceInfo::Kind& kind)
 {
     std::vector<std::string> childrenNames;
 
-    for(const auto& fullName : _children)
+    for(Id id : _children)
     {
-        const auto& entity = getChildByFullName(fullName);
+        const auto& entity = runtime().getEntity(id);
 
         if(entity.kind() == kind)
         {
-            childrenNames.push_back(fullName);
+            childrenNames.push_back(entity.fullName());
         }
     }
 
     return childrenNames;
 }
 
+const std::vector<Entity::Id>& Entity::children() const
+{
+    return _children;
+}
+
 void Entity::addChild(const std::shared_ptr<Entity>& entity)
 {
-    if(!isChild(entity))
+    // Only registered children are checked, entity loaders add
+    // entities through this function
+    const Id existing = detached() ? InvalidId : _runtime->getLoadedEntityId(entity->fullName());
+
+    if(existing == InvalidId || _runtime->getEntity(existing)._parent != _id)
     {
+        const bool wasDetached = entity->detached();
         entity->attach(pointer());
-        _children.insert(entity->fullName());
+
+        try
+        {
+            runtime().registerEntity(entity);
+        }
+        catch(...)
+        {
+            // Registration failed (Such as for a duplicate full name), leave
+            // the entity as it was so it's not linked to a parent it's not
+            // registered under
+            entity->_parent = InvalidId;
+
+            if(wasDetached)
+            {
+                entity->_runtime = nullptr;
+            }
+
+            throw;
+        }
+
+        _children.push_back(entity->id());
     }
     else
     {
@@ -161,12 +220,18 @@ void Entity::addChild(const std::shared_ptr<Entity>& entity)
 
 bool Entity::isChildByFullName(const std::string& fullName) const
 {
-    return _children.find(fullName) != _children.end();
+    if(detached())
+    {
+        return false;
+    }
+
+    const Id id = _runtime->lookup(fullName);
+    return id != InvalidId && _runtime->getEntity(id)._parent == _id;
 }
 
 bool Entity::isChildByName(const std::string& name) const
 {
-    return isChildByFullName(Scope::fromParentScope(sourceInfo().scope(), name).fullName());
+    return !detached() && _runtime->findChild(_id, name) != nullptr;
 }
 
 bool Entity::isChild(const std::shared_ptr<Entity>& entity) const
@@ -1,8 +1,14 @@
 #include "enum.hpp"
+#include <siplasplas/utility/hash.hpp>
+
+#include <algorithm>
+#include <cstring>
 
 using namespace cpp;
 using namespace cpp::dynamic_reflection;
 
+constexpr std::uint32_t Enum::InvalidIndex;
+
 Enum::Enum(
     const SourceInfo& sourceInfo,
     const cpp::typeerasure::TypeInfo& type,
@@ -19,6 +25,123 @@ Enum::Enum(
     SIPLASPLAS_ASSERT_FALSE(_names.empty());
     SIPLASPLAS_ASSERT_FALSE(_values.empty());
     SIPLASPLAS_ASSERT_EQ(_names.size(), _values.size());
+
+    buildIndices();
+}
+
+void Enum::buildIndices()
+{
+    // Names: keep the load factor at or below 1/2 so probe
+    // sequences stay short
+    std::size_t slots = 4;
+
+    while(slots < 2 * count())
+    {
+        slots *= 2;
+    }
+
+    _nameSlots.assign(slots, InvalidIndex);
+    _nameHashes.resize(count());
+
+    for(std::size_t i = 0; i < count(); ++i)
+    {
+        _nameHashes[i] = static_cast<std::size_t>(cpp::fnv1a(_names[i].data(), _names[i].size()));
+        std::size_t slot = _nameHashes[i] & (slots - 1);
+
+        while(_nameSlots[slot] != InvalidIndex)
+        {
+            slot = (slot + 1) & (slots - 1);
+        }
+
+        _nameSlots[slot] = static_cast<std::uint32_t>(i);
+    }
+
+    // Values: most enums are (almost) contiguous ranges, index
+    // them directly. Compute the range in unsigned arithmetic so
+    // it doesn't overflow with unsigned 64 bit underlying types
+    const auto minmax = std::minmax_element(_values.begin(), _values.end());
+    const std::uint64_t range = static_cast<std::uint64_t>(*minmax.second) -
+                                static_cast<std::uint64_t>(*minmax.first);
+
+    _minValue = *minmax.first;
+
+    if(range < 2 * count() + 16)
+    {
+        _denseValues.assign(static_cast<std::size_t>(range) + 1, InvalidIndex);
+
+        // Reverse order, so the first constant with a given value wins
+        for(std::size_t i = count(); i-- > 0;)
+        {
+            _denseValues[static_cast<std::uint64_t>(_values[i]) - static_cast<std::uint64_t>(_minValue)] =
+                static_cast<std::uint32_t>(i);
+        }
+    }
+    else
+    {
+        _sortedValues.reserve(count());
+
+        for(std::size_t i = 0; i < count(); ++i)
+        {
+            _sortedValues.emplace_back(_values[i], static_cast<std::uint32_t>(i));
+        }
+
+        // Stable, so the first constant with a given value comes first
+        std::stable_sort(_sortedValues.begin(), _sortedValues.end(),
+            [](const auto& lhs, const auto& rhs)
+            {
+                return lhs.first < rhs.first;
+            }
+        );
+    }
+}
+
+std::size_t Enum::findName(const char* name, std::size_t length) const
+{
+    const std::size_t hash = static_cast<std::size_t>(cpp::fnv1a(name, length));
+    const std::size_t mask = _nameSlots.size() - 1;
+
+    for(std::size_t slot = hash & mask; _nameSlots[slot] != InvalidIndex; slot = (slot + 1) & mask)
+    {
+        const std::size_t i = _nameSlots[slot];
+
+        if(_nameHashes[i] == hash && _names[i].size() == length &&
+           std::memcmp(_names[i].data(), name, length) == 0)
+        {
+            return i;
+        }
+    }
+
+    return count();
+}
+
+std::size_t Enum::findValue(std::int64_t value) const
+{
+    if(!_denseValues.empty())
+    {
+        const std::uint64_t offset = static_cast<std::uint64_t>(value) -
+                                     static_cast<std::uint64_t>(_minValue);
+
+        if(offset < _denseValues.size() && _denseValues[offset] != InvalidIndex)
+        {
+            return _denseValues[offset];
+        }
+    }
+    else
+    {
+        auto it = std::lower_bound(_sortedValues.begin(), _sortedValues.end(), value,
+            [](const std::pair<std::int64_t, std::uint32_t>& entry, std::int64_t value)
+            {
+                return entry.first < value;
+            }
+        );
+
+        if(it != _sortedValues.end() && it->first == value)
+        {
+            return it->second;
+        }
+    }
+
+    return count();
 }
 
 std::shared_ptr<Enum> Enum::create(
@@ -38,6 +161,11 @@ std::shared_ptr<Enum> Enum::create(
     }};
 }
 
+std::shared_ptr<Entity> Enum::clone() const
+{
+    return std::shared_ptr<Enum>{ new Enum{*this} };
+}
+
 Enum& Enum::fromEntity(const std::shared_ptr<Entity>& entity)
 {
     if(entity->kind() == SourceInfo::Kind::ENUM)
@@ -87,31 +215,34 @@ bool Enum::isUnsigned() const
     return _underlyingType(cpp::TypeTrait::is_unsigned);
 }
 
-std::int64_t Enum::fromString(const std::string& name) const
+std::int64_t Enum::fromString(const cpp::constexp::ConstStringView& name) const
 {
-    for(std::size_t i = 0; i < count(); ++i)
+    return fromString(name.begin(), name.length());
+}
+
+std::int64_t Enum::fromString(const char* name, std::size_t length) const
+{
+    const std::size_t i = findName(name, length);
+
+    if(i < count())
     {
-        if(name == _names[i])
-        {
-            return _values[i];
-        }
+        return _values[i];
     }
 
     throw cpp::exception<std::domain_error>(
         "Enum '{}' has no constant named '{}'",
         fullName(),
-        name
+        std::string{name, length}
     );
 }
 
 const std::string& Enum::toString(std::int64_t value) const
 {
-    for(std::size_t i = 0; i < count(); ++i)
+    const std::size_t i = findValue(value);
+
+    if(i < count())
     {
-        if(value == _values[i])
-        {
-            return _names[i];
-        }
+        return _names[i];
     }
 
     throw cpp::exception<std::domain_error>(
@@ -120,3 +251,13 @@ const std::string& Enum::toString(std::int64_t value) const
         value
     );
 }
+
+bool Enum::has(const cpp::constexp::ConstStringView& name) const
+{
+    return findName(name.begin(), name.length()) < count();
+}
+
+bool Enum::has(std::int64_t value) const
+{
+    return findValue(value) < count();
+}
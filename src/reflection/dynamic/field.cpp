@@ -1,17 +1,39 @@
 #include "field.hpp"
 #include <siplasplas/utility/exception.hpp>
 
+#include <cstring>
+
 using namespace cpp;
 using namespace cpp::dynamic_reflection;
 
-std::shared_ptr<Field> Field::create(const SourceInfo& sourceInfo, const cpp::typeerasure::Field32& field)
+constexpr std::size_t Field::NoOffset;
+
+std::shared_ptr<Field> Field::create(
+    const SourceInfo& sourceInfo,
+    const cpp::typeerasure::Field32& field,
+    const cpp::typeerasure::TypeInfo& classTypeInfo,
+    const cpp::typeerasure::TypeInfo& typeInfo,
+    std::size_t offset)
+{
+    return std::shared_ptr<Field>{ new Field{sourceInfo, field, classTypeInfo, typeInfo, offset} };
+}
+
+std::shared_ptr<Entity> Field::clone() const
 {
-    return std::shared_ptr<Field>{ new Field{sourceInfo, field} };
+    return std::shared_ptr<Field>{ new Field{*this} };
 }
 
-Field::Field(const SourceInfo& sourceInfo, const cpp::typeerasure::Field32& field) :
+Field::Field(
+    const SourceInfo& sourceInfo,
+    const cpp::typeerasure::Field32& field,
+    const cpp::typeerasure::TypeInfo& classTypeInfo,
+    const cpp::typeerasure::TypeInfo& typeInfo,
+    std::size_t offset) :
     Entity{sourceInfo},
-    _field{field}
+    _field{field},
+    _classTypeInfo{classTypeInfo},
+    _typeInfo{typeInfo},
+    _offset{offset}
 {}
 
 const cpp::typeerasure::Field32& Field::getField() const
@@ -19,6 +41,72 @@ const cpp::typeerasure::Field32& Field::getField() const
     return _field;
 }
 
+bool Field::hasOffset() const
+{
+    return _offset != NoOffset;
+}
+
+std::size_t Field::offset() const
+{
+    return _offset;
+}
+
+const cpp::typeerasure::TypeInfo& Field::typeInfo() const
+{
+    return _typeInfo;
+}
+
+const cpp::typeerasure::TypeInfo& Field::classTypeInfo() const
+{
+    return _classTypeInfo;
+}
+
+void* Field::address(void* object) const
+{
+    if(hasOffset())
+    {
+        return static_cast<char*>(object) + _offset;
+    }
+    else
+    {
+        return _field.get(cpp::ReferenceSimpleAny{object, _classTypeInfo}).storage(_typeInfo);
+    }
+}
+
+const void* Field::address(const void* object) const
+{
+    return address(const_cast<void*>(object));
+}
+
+void Field::set(void* object, const void* value) const
+{
+    _typeInfo.copyAssign(address(object), value);
+}
+
+void Field::gather(const void* objects, std::size_t count, std::size_t stride, void* out) const
+{
+    const auto* object = static_cast<const char*>(objects);
+    auto* value = static_cast<char*>(out);
+    const std::size_t size = _typeInfo.sizeOf();
+
+    if(hasOffset() && _typeInfo(cpp::TypeInfo::TypeTraitIndex::is_trivially_copyable))
+    {
+        object += _offset;
+
+        for(std::size_t i = 0; i < count; ++i, object += stride, value += size)
+        {
+            std::memcpy(value, object, size);
+        }
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i, object += stride, value += size)
+        {
+            _typeInfo.copyConstruct(value, address(static_cast<const void*>(object)));
+        }
+    }
+}
+
 Field& Field::fromEntity(const std::shared_ptr<Entity>& entity)
 {
     if(entity->sourceInfo().kind() == SourceInfo::Kind::FIELD)
@@ -30,6 +30,16 @@ std::shared_ptr<Function> Function::create(const cpp::dynamic_reflection::Source
     return std::shared_ptr<Function>{ new Function{sourceInfo, function} };
 }
 
+std::shared_ptr<Entity> Function::clone() const
+{
+    return std::shared_ptr<Function>{ new Function{*this} };
+}
+
+void Function::invokeBatch(std::vector<cpp::AnyVector>& columns, cpp::AnyVector* results) const
+{
+    _functionPointer.invokeBatch(columns, results);
+}
+
 const cpp::typeerasure::Function32& Function::getFunction() const
 {
     return _functionPointer;
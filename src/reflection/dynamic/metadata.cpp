@@ -0,0 +1,302 @@
+#include "metadata.hpp"
+#include <siplasplas/utility/exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+using namespace cpp;
+using namespace cpp::dynamic_reflection;
+using namespace cpp::dynamic_reflection::detail;
+
+constexpr Metadata::Index Metadata::InvalidIndex;
+constexpr std::uint32_t Metadata::Magic;
+constexpr std::uint32_t Metadata::Version;
+
+namespace
+{
+
+constexpr std::size_t words(std::size_t bytes)
+{
+    return (bytes + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+}
+
+int compare(const char* lhs, std::size_t lhsLength, const char* rhs, std::size_t rhsLength)
+{
+    const int result = std::memcmp(lhs, rhs, std::min(lhsLength, rhsLength));
+
+    if(result != 0)
+    {
+        return result;
+    }
+    else
+    {
+        return (lhsLength < rhsLength) ? -1 : (lhsLength > rhsLength);
+    }
+}
+
+}
+
+Metadata::Metadata() :
+    _header{nullptr},
+    _records{nullptr},
+    _byName{nullptr},
+    _strings{nullptr}
+{}
+
+Metadata::Metadata(const void* blob, std::size_t size) :
+    Metadata{}
+{
+    const auto* header = static_cast<const MetadataHeader*>(blob);
+
+    if(blob == nullptr || size < sizeof(MetadataHeader))
+    {
+        throw cpp::exception<std::runtime_error>(
+            "Invalid dynamic reflection metadata: {} bytes is too small for the header",
+            size
+        );
+    }
+
+    if(header->magic != Magic || header->version != Version)
+    {
+        throw cpp::exception<std::runtime_error>(
+            "Invalid dynamic reflection metadata: unknown magic number or version ({:#x}, {})",
+            header->magic, header->version
+        );
+    }
+
+    const std::size_t count = header->entityCount;
+    const std::size_t expectedSize = sizeof(MetadataHeader) +
+                                     count * sizeof(MetadataRecord) +
+                                     count * sizeof(Index) +
+                                     header->stringPoolSize;
+
+    if(size < expectedSize)
+    {
+        throw cpp::exception<std::runtime_error>(
+            "Invalid dynamic reflection metadata: expected {} bytes, got {}",
+            expectedSize, size
+        );
+    }
+
+    const auto* bytes = static_cast<const char*>(blob);
+    const auto* records = reinterpret_cast<const MetadataRecord*>(bytes + sizeof(MetadataHeader));
+    const auto* byName = reinterpret_cast<const Index*>(records + count);
+
+    // Validate all the offsets once, so accessors can trust them
+    // even if the blob comes from a file
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const auto& record = records[i];
+
+        if(static_cast<std::size_t>(record.fullName) + record.fullNameLength > header->stringPoolSize ||
+           (record.parent != InvalidIndex && record.parent >= count) ||
+           static_cast<std::size_t>(record.firstChild) + record.childCount > count ||
+           record.kind > static_cast<std::uint32_t>(Kind::UNKNOWN) ||
+           byName[i] >= count)
+        {
+            throw cpp::exception<std::runtime_error>(
+                "Invalid dynamic reflection metadata: entity record {} is out of bounds",
+                i
+            );
+        }
+    }
+
+    _header = header;
+    _records = records;
+    _byName = byName;
+    _strings = reinterpret_cast<const char*>(byName + count);
+}
+
+std::size_t Metadata::count() const
+{
+    return (_header != nullptr) ? _header->entityCount : 0;
+}
+
+bool Metadata::empty() const
+{
+    return count() == 0;
+}
+
+Metadata::Index Metadata::find(const char* fullName, std::size_t length) const
+{
+    const Index* begin = _byName;
+    const Index* end = _byName + count();
+
+    auto it = std::lower_bound(begin, end, 0, [&](Index index, int)
+    {
+        return compare(this->fullName(index), fullNameLength(index), fullName, length) < 0;
+    });
+
+    if(it != end && compare(this->fullName(*it), fullNameLength(*it), fullName, length) == 0)
+    {
+        return *it;
+    }
+    else
+    {
+        return InvalidIndex;
+    }
+}
+
+Metadata::Index Metadata::find(const std::string& fullName) const
+{
+    return find(fullName.c_str(), fullName.size());
+}
+
+const char* Metadata::fullName(Index index) const
+{
+    return _strings + record(index).fullName;
+}
+
+std::size_t Metadata::fullNameLength(Index index) const
+{
+    return record(index).fullNameLength;
+}
+
+Kind Metadata::kind(Index index) const
+{
+    return static_cast<Kind>(record(index).kind);
+}
+
+Metadata::Index Metadata::parent(Index index) const
+{
+    return record(index).parent;
+}
+
+Metadata::Index Metadata::firstChild(Index index) const
+{
+    return record(index).firstChild;
+}
+
+std::size_t Metadata::childCount(Index index) const
+{
+    return record(index).childCount;
+}
+
+const MetadataRecord& Metadata::record(Index index) const
+{
+    return _records[index];
+}
+
+void MetadataBuilder::add(const SourceInfo& sourceInfo, std::size_t key)
+{
+    _entries.push_back(Entry{
+        sourceInfo.fullName(),
+        sourceInfo.scope().isGlobalScope() ? "" : sourceInfo.scope().parent().fullName(),
+        sourceInfo.kind(),
+        key
+    });
+}
+
+std::vector<std::uint32_t> MetadataBuilder::build(std::vector<std::size_t>& keys) const
+{
+    using Index = Metadata::Index;
+
+    // Entities exported more than once (Such as a nested class also
+    // exported as a type) are kept once
+    std::unordered_map<std::string, std::size_t> entriesByName;
+    std::vector<std::size_t> entries;
+
+    for(std::size_t i = 0; i < _entries.size(); ++i)
+    {
+        if(entriesByName.emplace(_entries[i].fullName, entries.size()).second)
+        {
+            entries.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> children(entries.size());
+    std::vector<std::size_t> roots;
+
+    for(std::size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry& entry = _entries[entries[i]];
+
+        // Entities whose parent was not exported (Such as classes declared
+        // in a namespace) are kept as roots, the runtime decides what to do
+        // with them when they are loaded
+        auto parent = entriesByName.find(entry.parentFullName);
+
+        if(entry.parentFullName.empty() || parent == entriesByName.end())
+        {
+            roots.push_back(i);
+        }
+        else
+        {
+            children[parent->second].push_back(i);
+        }
+    }
+
+    // Tree order: records are assigned breadth first, so the
+    // children of each entity get consecutive indices
+    std::vector<std::size_t> order(roots);
+    std::vector<Index> recordIndex(entries.size());
+    std::vector<Index> parents(roots.size(), Metadata::InvalidIndex);
+
+    for(std::size_t i = 0; i < order.size(); ++i)
+    {
+        recordIndex[order[i]] = static_cast<Index>(i);
+
+        for(std::size_t child : children[order[i]])
+        {
+            order.push_back(child);
+            parents.push_back(static_cast<Index>(i));
+        }
+    }
+
+    const std::size_t count = order.size();
+    std::size_t stringPoolSize = 0;
+
+    for(std::size_t entry : entries)
+    {
+        stringPoolSize += _entries[entry].fullName.size();
+    }
+
+    std::vector<std::uint32_t> blob(
+        words(sizeof(MetadataHeader)) +
+        count * words(sizeof(MetadataRecord)) +
+        count +
+        words(stringPoolSize)
+    );
+
+    auto* header = reinterpret_cast<MetadataHeader*>(blob.data());
+    auto* records = reinterpret_cast<MetadataRecord*>(header + 1);
+    auto* byName = reinterpret_cast<Index*>(records + count);
+    auto* strings = reinterpret_cast<char*>(byName + count);
+
+    header->magic = Metadata::Magic;
+    header->version = Metadata::Version;
+    header->entityCount = static_cast<std::uint32_t>(count);
+    header->stringPoolSize = static_cast<std::uint32_t>(stringPoolSize);
+
+    keys.clear();
+    keys.reserve(count);
+    std::size_t stringOffset = 0;
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const Entry& entry = _entries[entries[order[i]]];
+        const auto& entryChildren = children[order[i]];
+        auto& record = records[i];
+
+        record.fullName = static_cast<std::uint32_t>(stringOffset);
+        record.fullNameLength = static_cast<std::uint32_t>(entry.fullName.size());
+        record.parent = parents[i];
+        record.firstChild = entryChildren.empty() ? 0 : recordIndex[entryChildren.front()];
+        record.childCount = static_cast<std::uint32_t>(entryChildren.size());
+        record.kind = static_cast<std::uint32_t>(entry.kind);
+
+        std::memcpy(strings + stringOffset, entry.fullName.data(), entry.fullName.size());
+        stringOffset += entry.fullName.size();
+
+        byName[i] = static_cast<Index>(i);
+        keys.push_back(entry.key);
+    }
+
+    std::sort(byName, byName + count, [&](Index lhs, Index rhs)
+    {
+        return _entries[entries[order[lhs]]].fullName < _entries[entries[order[rhs]]].fullName;
+    });
+
+    return blob;
+}
@@ -17,6 +17,11 @@ std::shared_ptr<Namespace> Namespace::create(const SourceInfo& sourceInfo)
     return std::shared_ptr<Namespace>{new Namespace(sourceInfo)};
 }
 
+std::shared_ptr<Entity> Namespace::clone() const
+{
+    return std::shared_ptr<Namespace>{new Namespace(*this)};
+}
+
 Namespace& Namespace::fromEntity(const std::shared_ptr<Entity>& entity)
 {
     if(entity->sourceInfo().kind() == SourceInfo::Kind::NAMESPACE)
@@ -12,25 +12,25 @@ Object::Object() :
 Object::Object(const cpp::dynamic_reflection::Type& type) :
     _type{type},
     _kind{Object::Kind::VALUE},
-    _object{_type.construct()}
+    _object{constructValue()}
 {}
 
 Object::Object(const cpp::dynamic_reflection::Type& type, void* fromRaw, bool isReference) :
     _type{type},
     _kind{isReference ? Object::Kind::REFERENCE : Object::Kind::VALUE},
-    _object{isReference ? fromRaw : _type.copy_construct(fromRaw)}
+    _object{isReference ? fromRaw : copyValue(fromRaw)}
 {}
 
 Object::Object(const Object& other) :
     _type{other._type},
     _kind{other._kind},
-    _object{other._kind != Object::Kind::VALUE ? other._object : _type.copy_construct(other._object)}
+    _object{other._kind != Object::Kind::VALUE ? other._object : copyValue(other._object)}
 {}
 
 Object::Object(Object&& other) :
     _type{other._type},
     _kind{other._kind},
-    _object{other._kind != Object::Kind::VALUE ? other._object : _type.move_construct(other._object)}
+    _object{other._kind != Object::Kind::VALUE ? other._object : moveValue(other._object)}
 {}
 
 Object& Object::operator=(const Object& other)
@@ -39,7 +39,7 @@ Object& Object::operator=(const Object& other)
     {
         destroy();
         _type = other._type;
-        _object = other._kind != Object::Kind::VALUE  ? other._object : _type.copy_construct(other._object);
+        _object = other._kind != Object::Kind::VALUE ? other._object : copyValue(other._object);
         _kind = other._kind;
     }
     else
@@ -56,7 +56,7 @@ Object& Object::operator=(Object&& other)
     {
         destroy();
         _type = other._type;
-        _object = other._kind != Object::Kind::VALUE ? other._object : _type.move_construct(other._object);
+        _object = other._kind != Object::Kind::VALUE ? other._object : moveValue(other._object);
         _kind = other._kind;
     }
     else
@@ -109,15 +109,89 @@ std::string Object::toString() const
 
 Object Object::fromString(const std::string& typeName, const std::string& value)
 {
-    auto type = cpp::dynamic_reflection::Type::get(typeName);
-    return Object{type, type.fromString(value)};
+    const auto& type = cpp::dynamic_reflection::Type::get(typeName);
+    Object object;
+
+    // Parse directly into the object storage, the type is
+    // set once the value has been successfully constructed
+    if(storedInline(type))
+    {
+        type.fromString_at(&object._storage, value);
+        object._object = &object._storage;
+    }
+    else
+    {
+        object._object = type.fromString(value);
+    }
+
+    object._type = type;
+    return object;
+}
+
+bool Object::storedInline(const cpp::dynamic_reflection::Type& type)
+{
+    const auto& typeInfo = type.typeInfo();
+
+    return typeInfo.sizeOf() <= InlineStorageSize &&
+           alignof(decltype(_storage)) % typeInfo.alignment() == 0 &&
+           typeInfo(cpp::TypeInfo::TypeTraitIndex::is_nothrow_move_constructible);
+}
+
+bool Object::isInline() const
+{
+    return _object == &_storage;
+}
+
+void* Object::inlineStorage()
+{
+    return storedInline(_type) ? &_storage : nullptr;
+}
+
+void* Object::constructValue()
+{
+    if(void* storage = inlineStorage())
+    {
+        _type.construct_at(storage);
+        return storage;
+    }
+
+    return _type.construct();
+}
+
+void* Object::copyValue(const void* value)
+{
+    if(void* storage = inlineStorage())
+    {
+        _type.copy_construct_at(storage, value);
+        return storage;
+    }
+
+    return _type.copy_construct(value);
+}
+
+void* Object::moveValue(void* value)
+{
+    if(void* storage = inlineStorage())
+    {
+        _type.move_construct_at(storage, value);
+        return storage;
+    }
+
+    return _type.move_construct(value);
 }
 
 void Object::destroy()
 {
     if(!empty() && _kind == Object::Kind::VALUE)
     {
-        _type.destroy(_object);
+        if(isInline())
+        {
+            _type.destroy_at(_object);
+        }
+        else
+        {
+            _type.destroy(_object);
+        }
     }
 
     _object = nullptr;
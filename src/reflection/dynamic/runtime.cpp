@@ -2,6 +2,8 @@
 #include "logger.hpp"
 
 #include <siplasplas/utility/exception.hpp>
+#include <siplasplas/utility/hash.hpp>
+#include <atomic>
 #include <stdexcept>
 
 using namespace cpp;
@@ -16,9 +18,29 @@ Runtime::Runtime(const std::string& name)
     reset(name);
 }
 
+namespace
+{
+
+// Key of the (parent, name) index. FNV-1a of the name seeded
+// with the parent id, collisions are resolved by comparing names
+std::uint64_t childKey(Entity::Id parent, const char* name, std::size_t length)
+{
+    return cpp::fnv1a(name, length, parent);
+}
+
+}
+
 void Runtime::clear()
 {
+    _entityLoader = nullptr;
     _entities.clear();
+    _ids.clear();
+    _childrenByName.clear();
+
+    for(auto& ids : _entitiesByKind)
+    {
+        ids.clear();
+    }
 
     // Add global namespace
     addEntity(
@@ -44,9 +66,14 @@ Namespace& Runtime::namespace_()
     return namespace_("");
 }
 
-bool Runtime::hasEntity(const std::string& fullName) const
+bool Runtime::hasEntity(const std::string& fullName)
 {
-    return _entities.find(fullName) != _entities.end();
+    return lookup(fullName) != Entity::InvalidId;
+}
+
+bool Runtime::hasLoadedEntity(const std::string& fullName) const
+{
+    return _ids.find(fullName) != _ids.end();
 }
 
 Namespace& Runtime::namespace_(const std::string& fullName)
@@ -56,11 +83,11 @@ Namespace& Runtime::namespace_(const std::string& fullName)
 
 Entity& Runtime::getEntity(const std::string& fullName)
 {
-    auto it = _entities.find(fullName);
+    const Entity::Id id = lookup(fullName);
 
-    if(it != _entities.end())
+    if(id != Entity::InvalidId)
     {
-        return *it->second;
+        return *_entities[id];
     }
     else
     {
@@ -71,21 +98,131 @@ Entity& Runtime::getEntity(const std::string& fullName)
     }
 }
 
+Entity& Runtime::getEntity(Entity::Id id)
+{
+    return *_entities[id];
+}
+
+Entity::Id Runtime::getEntityId(const std::string& fullName)
+{
+    return lookup(fullName);
+}
+
+Entity::Id Runtime::getLoadedEntityId(const std::string& fullName) const
+{
+    auto it = _ids.find(fullName);
+
+    if(it != _ids.end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return Entity::InvalidId;
+    }
+}
+
+Entity* Runtime::findChild(Entity::Id parent, const char* name, std::size_t length)
+{
+    auto range = _childrenByName.equal_range(childKey(parent, name, length));
+
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        Entity& child = *_entities[it->second];
+
+        if(child._parent == parent && child.name().size() == length &&
+           child.name().compare(0, length, name, length) == 0)
+        {
+            return &child;
+        }
+    }
+
+    if(_entityLoader)
+    {
+        const Entity::Id id = lookup(
+            Scope::fromParentScope(getEntity(parent).sourceInfo().scope(), std::string{name, length}).fullName()
+        );
+
+        if(id != Entity::InvalidId && _entities[id]->_parent == parent)
+        {
+            return _entities[id].get();
+        }
+    }
+
+    return nullptr;
+}
+
+Entity* Runtime::findChild(Entity::Id parent, const std::string& name)
+{
+    return findChild(parent, name.c_str(), name.size());
+}
+
+const std::vector<Entity::Id>& Runtime::getEntitiesByKind(const SourceInfo::Kind& kind) const
+{
+    return _entitiesByKind[static_cast<std::size_t>(kind)];
+}
+
+std::size_t Runtime::entityCount() const
+{
+    return _entities.size();
+}
+
+void Runtime::setEntityLoader(EntityLoader loader)
+{
+    _entityLoader = std::move(loader);
+}
+
+Entity::Id Runtime::lookup(const std::string& fullName)
+{
+    Entity::Id id = getLoadedEntityId(fullName);
+
+    if(id == Entity::InvalidId && _entityLoader && _entityLoader(fullName))
+    {
+        id = getLoadedEntityId(fullName);
+    }
+
+    return id;
+}
+
+void Runtime::registerEntity(const std::shared_ptr<Entity>& entity)
+{
+    if(hasLoadedEntity(entity->fullName()))
+    {
+        throw cpp::exception<std::runtime_error>(
+            "The runtime already has an entity named '{}'",
+            entity->fullName()
+        );
+    }
+
+    const auto id = static_cast<Entity::Id>(_entities.size());
+
+    _entities.push_back(entity);
+    _ids[entity->fullName()] = id;
+    _entitiesByKind[static_cast<std::size_t>(entity->kind())].push_back(id);
+    entity->_id = id;
+
+    if(!entity->orphan())
+    {
+        const auto& name = entity->name();
+        _childrenByName.emplace(childKey(entity->_parent, name.c_str(), name.size()), id);
+    }
+}
+
 void Runtime::addEntity(const std::shared_ptr<Entity>& entity)
 {
-    if(!hasEntity(entity->fullName()))
+    // Entity loaders register entities through addEntity(), so only the
+    // registered entities are checked here
+    if(!hasLoadedEntity(entity->fullName()))
     {
         if(!entity->sourceInfo().scope().isGlobalScope())
         {
             auto parentScope = entity->sourceInfo().scope().parent();
 
-            if(hasEntity(parentScope.fullName()))
+            if(hasLoadedEntity(parentScope.fullName()))
             {
                 auto& parent = getEntity(parentScope.fullName());
-                // Try to add entity to its parent
+                // Links the entity to its parent and registers it
                 parent.addChild(entity);
-                // Register the entity if succeeded
-                _entities[entity->fullName()] = entity;
                 reflection::dynamic::log().debug("[reflection runtime '{}'] Registered entity '{}'", name(), entity->fullName());
             }
             else
@@ -98,8 +235,8 @@ void Runtime::addEntity(const std::shared_ptr<Entity>& entity)
         }
         else
         {
-            _entities[entity->fullName()] = entity;
             entity->attach(*this);
+            registerEntity(entity);
         }
 
         SIPLASPLAS_ASSERT(!entity->detached() && entity->runtime() == *this)(
@@ -118,6 +255,112 @@ void Runtime::addEntity(const std::shared_ptr<Entity>& entity)
     }
 }
 
+std::shared_ptr<const RuntimeSnapshot> Runtime::freeze() const
+{
+    std::shared_ptr<RuntimeSnapshot> snapshot{new RuntimeSnapshot{}};
+
+    snapshot->_name = _name;
+    snapshot->_ids = _ids;
+    snapshot->_childrenByName = _childrenByName;
+    snapshot->_entitiesByKind = _entitiesByKind;
+    snapshot->_entities.reserve(_entities.size());
+
+    for(const auto& entity : _entities)
+    {
+        auto copy = entity->clone();
+        copy->_runtime = nullptr;
+        snapshot->_entities.push_back(std::move(copy));
+    }
+
+    return snapshot;
+}
+
+void Runtime::publish()
+{
+    std::atomic_store(&_snapshot, freeze());
+}
+
+std::shared_ptr<const RuntimeSnapshot> Runtime::snapshot() const
+{
+    return std::atomic_load(&_snapshot);
+}
+
+const std::string& RuntimeSnapshot::name() const
+{
+    return _name;
+}
+
+std::size_t RuntimeSnapshot::entityCount() const
+{
+    return _entities.size();
+}
+
+const Entity& RuntimeSnapshot::getEntity(Entity::Id id) const
+{
+    return *_entities[id];
+}
+
+Entity::Id RuntimeSnapshot::getEntityId(const std::string& fullName) const
+{
+    auto it = _ids.find(fullName);
+
+    if(it != _ids.end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return Entity::InvalidId;
+    }
+}
+
+const Entity* RuntimeSnapshot::findEntity(const std::string& fullName) const
+{
+    const Entity::Id id = getEntityId(fullName);
+
+    if(id != Entity::InvalidId)
+    {
+        return _entities[id].get();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+const Entity* RuntimeSnapshot::findChild(Entity::Id parent, const char* name, std::size_t length) const
+{
+    auto range = _childrenByName.equal_range(childKey(parent, name, length));
+
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        const Entity& child = *_entities[it->second];
+
+        if(child._parent == parent && child.name().size() == length &&
+           child.name().compare(0, length, name, length) == 0)
+        {
+            return &child;
+        }
+    }
+
+    return nullptr;
+}
+
+const Entity* RuntimeSnapshot::findChild(Entity::Id parent, const std::string& name) const
+{
+    return findChild(parent, name.c_str(), name.size());
+}
+
+const std::vector<Entity::Id>& RuntimeSnapshot::children(Entity::Id id) const
+{
+    return _entities[id]->_children;
+}
+
+const std::vector<Entity::Id>& RuntimeSnapshot::getEntitiesByKind(const SourceInfo::Kind& kind) const
+{
+    return _entitiesByKind[static_cast<std::size_t>(kind)];
+}
+
 namespace cpp
 {
 
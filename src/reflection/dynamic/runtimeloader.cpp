@@ -26,6 +26,9 @@ RuntimeLoader::RuntimeLoader(const DynamicLibrary& library)
     load(library);
 }
 
+namespace
+{
+
 struct Context
 {
     Runtime* runtime;
@@ -37,142 +40,242 @@ struct Context
     }
 };
 
+void loadClass(void* context, const void* sourceInfoPtr, const void* typeInfoPtr)
+{
+    auto loaderContext = Context::get(context);
+    auto sourceInfo = getSourceInfo(sourceInfoPtr);
+    auto typeInfo   = getTypeInfo(typeInfoPtr);
+
+    loaderContext.runtime->addEntity(
+        Class::create(
+            sourceInfo,
+            typeInfo
+        )
+    );
+
+    log().debug("Loaded class '{}' from library '{}'",
+        sourceInfo.fullName(),
+        loaderContext.library->path()
+    );
+}
+
+void loadEnum(
+    void* context,
+    const void* sourceInfoPtr,
+    const void* typeInfoPtr,
+    const void* underlyingTypeInfoPtr,
+    std::size_t count,
+    const char* names[],
+    const std::int64_t values[])
+{
+    auto loaderContext = Context::get(context);
+    auto sourceInfo = getSourceInfo(sourceInfoPtr);
+    auto typeInfo   = getTypeInfo(typeInfoPtr);
+    auto underlyingTypeInfo = getTypeInfo(underlyingTypeInfoPtr);
+
+    std::vector<std::string> namesCopy{names, names + count};
+    std::vector<std::int64_t> valuesCopy{values, values + count};
+
+    loaderContext.runtime->addEntity(
+        Enum::create(
+            sourceInfo,
+            typeInfo,
+            underlyingTypeInfo,
+            namesCopy,
+            valuesCopy
+        )
+    );
+
+    log().debug("Loaded enum '{}' ({} values) from library '{}'",
+        sourceInfo.fullName(),
+        count,
+        loaderContext.library->path()
+    );
+}
+
+void loadEnumValue(void* context, const void* sourceInfo, const char* name, std::int64_t value)
+{
+    auto loaderContext = Context::get(context);
+    log().warn("Enum value '{}::{}' ({}) from library {} ignored, enums are not supported",
+        getSourceInfo(sourceInfo).fullName(),
+        name,
+        value,
+        loaderContext.library->path()
+    );
+}
+
+void loadMethod(void* context, const void* sourceInfoRef, void* functionRef)
+{
+    auto loaderContext = Context::get(context);
+    auto sourceInfo = getSourceInfo(sourceInfoRef);
+    auto& function = *reinterpret_cast<cpp::dynamic_reflection::detail::MethodPointer*>(functionRef);
+
+    SIPLASPLAS_ASSERT(function.kind() == cpp::FunctionKind::MEMBER_FUNCTION || function.kind() == cpp::FunctionKind::CONST_MEMBER_FUNCTION);
+
+    loaderContext.runtime->addEntity(
+        cpp::dynamic_reflection::Function::create(
+            sourceInfo,
+            function
+        )
+    );
+
+    log().debug("Loaded method '{}' from library '{}'",
+        sourceInfo.fullName(),
+        loaderContext.library->path()
+    );
+}
+
+void loadField(void* context, const void* sourceInfoRef, void* fieldRef)
+{
+    auto loaderContext = Context::get(context);
+    auto sourceInfo = getSourceInfo(sourceInfoRef);
+    const auto& field = *reinterpret_cast<const cpp::dynamic_reflection::detail::FieldDescriptor*>(fieldRef);
+
+    SIPLASPLAS_ASSERT(field.field.kind() == cpp::FunctionKind::MEMBER_OBJECT);
+
+    loaderContext.runtime->addEntity(
+        cpp::dynamic_reflection::Field::create(
+            sourceInfo,
+            field.field,
+            getTypeInfo(field.classTypeInfo),
+            getTypeInfo(field.typeInfo),
+            field.offset
+        )
+    );
+
+    log().debug("Loaded field '{}' ({}) from library '{}'",
+        sourceInfo.fullName(),
+        (field.offset != cpp::dynamic_reflection::Field::NoOffset ? "by offset" : "by member pointer"),
+        loaderContext.library->path()
+    );
+}
+
+}
+
 void RuntimeLoader::load(const DynamicLibrary& library)
 {
     _library = library;
     _runtime.reset(library.path());
+    _metadata = Metadata{};
+    _loaded.clear();
 
-    auto loadClass = [](void* context, const void* sourceInfoPtr, const void* typeInfoPtr)
-    {
-        auto loaderContext = Context::get(context);
-        auto sourceInfo = getSourceInfo(sourceInfoPtr);
-        auto typeInfo   = getTypeInfo(typeInfoPtr);
+    const void* metadata = nullptr;
+    std::size_t metadataSize = 0;
 
-        log().debug("Loading class '{}' from library '{}'...",
-            sourceInfo.fullName(),
-            loaderContext.library->path()
-        );
+    try
+    {
+        auto getMetadata = _library->getSymbol("SIPLASPLAS_REFLECTION_DYNAMIC_METADATA").get<MetadataGetter>();
+        metadata = getMetadata(&metadataSize);
+    }
+    catch(const std::exception&)
+    {
+        log().debug("Library '{}' exports no reflection metadata, loading all its types", library.path());
+    }
 
-        loaderContext.runtime->addEntity(
-            Class::create(
-                sourceInfo,
-                typeInfo
-            )
-        );
+    if(metadata != nullptr)
+    {
+        _metadata = Metadata{metadata, metadataSize};
+        _loaded.assign(_metadata.count(), false);
+        _runtime.setEntityLoader([this](const std::string& fullName)
+        {
+            return loadEntity(fullName);
+        });
 
-        log().info("Loaded class '{}' from library '{}'",
-            sourceInfo.fullName(),
-            loaderContext.library->path()
+        log().info("Library '{}' exports {} entities, loading them on demand",
+            library.path(),
+            _metadata.count()
         );
-    };
-    auto loadEnum = [](
-        void* context,
-        const void* sourceInfoPtr,
-        const void* typeInfoPtr,
-        const void* underlyingTypeInfoPtr,
-        std::size_t count,
-        const char* names[],
-        const std::int64_t values[])
+    }
+    else
     {
-        auto loaderContext = Context::get(context);
-        auto sourceInfo = getSourceInfo(sourceInfoPtr);
-        auto typeInfo   = getTypeInfo(typeInfoPtr);
-        auto underlyingTypeInfo = getTypeInfo(underlyingTypeInfoPtr);
-
-        std::vector<std::string> namesCopy;
-        std::vector<std::int64_t> valuesCopy;
-        namesCopy.reserve(count);
-        valuesCopy.reserve(count);
-
-        log().debug("Loading enum '{}' from library '{}'...",
-            sourceInfo.fullName(),
-            loaderContext.library->path()
+        auto loader = getRuntimeLoader().get<TypeLoader>();
+        Context context;
+        context.runtime = &_runtime;
+        context.library = &_library.get();
+
+        loader(
+            &context,
+            loadClass,
+            loadEnum,
+            loadEnumValue,
+            loadMethod,
+            loadField
         );
+    }
+}
 
+void RuntimeLoader::loadAll()
+{
+    for(Metadata::Index i = 0; i < _metadata.count(); ++i)
+    {
+        loadEntity(i);
+    }
+}
 
-        for(std::size_t i = 0; i < count; ++i)
-        {
-            namesCopy.emplace_back(names[i]);
-            valuesCopy.emplace_back(values[i]);
-
-            log().debug(" - Loading {}::{} ({})",
-                sourceInfo.fullName(),
-                names[i],
-                values[i]
-            );
-        }
+const Metadata& RuntimeLoader::metadata() const
+{
+    return _metadata;
+}
 
-        loaderContext.runtime->addEntity(
-            Enum::create(
-                sourceInfo,
-                typeInfo,
-                underlyingTypeInfo,
-                namesCopy,
-                valuesCopy
-            )
-        );
+bool RuntimeLoader::loadEntity(const std::string& fullName)
+{
+    const Metadata::Index index = _metadata.find(fullName);
 
-        log().info("Loaded enum '{}' from library '{}'",
-            sourceInfo.fullName(),
-            loaderContext.library->path()
-        );
-    };
-    auto loadEnumValue = [](void* context, const void* sourceInfo, const char* name, std::int64_t value)
+    if(index != Metadata::InvalidIndex)
     {
-        auto loaderContext = Context::get(context);
-        log().warn("Enum value '{}::{}' ({}) from library {} ignored, enums are not supported",
-            getSourceInfo(sourceInfo).fullName(),
-            name,
-            value,
-            loaderContext.library->path()
-        );
-    };
-    auto loadMethod = [](void* context, const void* sourceInfoRef, void* functionRef)
+        loadEntity(index);
+        return _runtime.hasLoadedEntity(fullName);
+    }
+    else
     {
-        auto loaderContext = Context::get(context);
-        auto sourceInfo = getSourceInfo(sourceInfoRef);
-        auto& function = *reinterpret_cast<cpp::dynamic_reflection::detail::MethodPointer*>(functionRef);
+        return false;
+    }
+}
 
-        SIPLASPLAS_ASSERT(function.kind() == cpp::FunctionKind::MEMBER_FUNCTION || function.kind() == cpp::FunctionKind::CONST_MEMBER_FUNCTION);
+void RuntimeLoader::loadEntity(Metadata::Index index)
+{
+    const Metadata::Index parent = _metadata.parent(index);
 
-        log().info("loaded method '{}' from library '{}'",
-            sourceInfo.fullName(),
-            loaderContext.library->path()
-        );
+    // Parents are registered first. Loading a class loads its
+    // members, so the entity may be loaded after its parent
+    if(parent != Metadata::InvalidIndex)
+    {
+        loadEntity(parent);
+    }
 
-        loaderContext.runtime->addEntity(
-            Function::create(
-                sourceInfo,
-                function
-            )
-        );
-    };
-    auto loadField = [](void* context, const void* sourceInfo, void* functionRef)
+    if(_loaded[index])
     {
-        auto loaderContext = Context::get(context);
-        auto function = *reinterpret_cast<cpp::dynamic_reflection::detail::FieldPointer*>(functionRef);
+        return;
+    }
 
-        SIPLASPLAS_ASSERT(function.kind() == cpp::FunctionKind::MEMBER_OBJECT);
+    auto loader = _library->getSymbol("SIPLASPLAS_REFLECTION_DYNAMIC_LOADENTITY").get<EntityLoader>();
+    Context context;
+    context.runtime = &_runtime;
+    context.library = &_library.get();
 
-        log().warn("Field '{}' from library {} ignored, fields not supported",
-            getSourceInfo(sourceInfo).fullName(),
-            loaderContext.library->path()
-        );
+    auto load = [&](Metadata::Index index)
+    {
+        _loaded[index] = true;
+        loader(index, &context, loadClass, loadEnum, loadEnumValue, loadMethod, loadField);
     };
 
-    auto loader = getRuntimeLoader().get<TypeLoader>();
-    Context context;
-    context.runtime = &_runtime;
-    context.library = &library;
-
-    loader(
-        &context,
-        loadClass,
-        loadEnum,
-        loadEnumValue,
-        loadMethod,
-        loadField
-    );
+    load(index);
+
+    if(_metadata.kind(index) == Kind::CLASS)
+    {
+        const Metadata::Index begin = _metadata.firstChild(index);
+        const Metadata::Index end = begin + static_cast<Metadata::Index>(_metadata.childCount(index));
+
+        for(Metadata::Index child = begin; child < end; ++child)
+        {
+            const Kind kind = _metadata.kind(child);
+
+            if(!_loaded[child] && (kind == Kind::FUNCTION || kind == Kind::FIELD))
+            {
+                load(child);
+            }
+        }
+    }
 }
 
 Runtime& RuntimeLoader::runtime()
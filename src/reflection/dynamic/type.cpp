@@ -4,6 +4,7 @@ using namespace cpp::dynamic_reflection;
 
 Type::Types& Type::types()
 {
-    static Type::Types types;
-    return types;
+    // Never destroyed, so type handles stay valid during static destruction
+    static Type::Types* types = new Type::Types;
+    return *types;
 }
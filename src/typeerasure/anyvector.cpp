@@ -0,0 +1,238 @@
+#include "anyvector.hpp"
+#include <siplasplas/utility/memory_manip.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace cpp;
+
+AnyVector::AnyVector(const cpp::typeerasure::TypeInfo& typeInfo) :
+    _typeInfo{typeInfo},
+    _data{nullptr},
+    _size{0},
+    _capacity{0}
+{}
+
+AnyVector::AnyVector(const cpp::typeerasure::TypeInfo& typeInfo, std::size_t count) :
+    AnyVector{typeInfo}
+{
+    resize(count);
+}
+
+AnyVector::AnyVector(const AnyVector& other) :
+    AnyVector{other._typeInfo}
+{
+    reallocate(other._size);
+    copyConstruct(_data, other._data, other._size);
+    _size = other._size;
+}
+
+AnyVector::AnyVector(AnyVector&& other) :
+    _typeInfo{other._typeInfo},
+    _data{other._data},
+    _size{other._size},
+    _capacity{other._capacity}
+{
+    other._data = nullptr;
+    other._size = 0;
+    other._capacity = 0;
+}
+
+AnyVector& AnyVector::operator=(const AnyVector& other)
+{
+    AnyVector copy{other};
+    swap(copy);
+    return *this;
+}
+
+AnyVector& AnyVector::operator=(AnyVector&& other)
+{
+    AnyVector moved{std::move(other)};
+    swap(moved);
+    return *this;
+}
+
+AnyVector::~AnyVector()
+{
+    clear();
+
+    if(_data != nullptr)
+    {
+        cpp::detail::aligned_free(_data);
+    }
+}
+
+void AnyVector::push_back(const cpp::ConstReferenceSimpleAny& value)
+{
+    SIPLASPLAS_ASSERT(value.typeInfo() == _typeInfo)("AnyVector has elements of type {}, cannot insert a {}",
+        _typeInfo.typeName(), value.typeInfo().typeName());
+
+    constructBack([&](void* where)
+    {
+        _typeInfo.copyConstruct(where, value.getStorage().storage(value.typeInfo()));
+    });
+}
+
+void AnyVector::push_back(const cpp::ReferenceSimpleAny& value)
+{
+    SIPLASPLAS_ASSERT(value.typeInfo() == _typeInfo)("AnyVector has elements of type {}, cannot insert a {}",
+        _typeInfo.typeName(), value.typeInfo().typeName());
+
+    constructBack([&](void* where)
+    {
+        _typeInfo.copyConstruct(where, value.getStorage().storage(value.typeInfo()));
+    });
+}
+
+cpp::ReferenceSimpleAny AnyVector::emplace_back()
+{
+    constructBack([&](void* where)
+    {
+        _typeInfo.defaultConstruct(where);
+    });
+
+    return {_data + (_size - 1)*stride(), _typeInfo};
+}
+
+void AnyVector::pop_back()
+{
+    SIPLASPLAS_ASSERT_FALSE(empty());
+    destroy(_data + (_size - 1)*stride(), 1);
+    --_size;
+}
+
+void AnyVector::resize(std::size_t count)
+{
+    if(count < _size)
+    {
+        destroy(_data + count*stride(), _size - count);
+        _size = count;
+    }
+    else if(count > _size)
+    {
+        reserve(count);
+
+        for(char* element = _data + _size*stride(); _size < count; element += stride(), ++_size)
+        {
+            _typeInfo.defaultConstruct(element);
+        }
+    }
+}
+
+void AnyVector::reserve(std::size_t count)
+{
+    if(count > _capacity)
+    {
+        reallocate(count);
+    }
+}
+
+void AnyVector::clear()
+{
+    destroy(_data, _size);
+    _size = 0;
+}
+
+void AnyVector::swap(AnyVector& other)
+{
+    std::swap(_typeInfo, other._typeInfo);
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+}
+
+bool AnyVector::triviallyCopyable() const
+{
+    return _typeInfo(cpp::TypeTrait::is_trivially_copyable);
+}
+
+bool AnyVector::triviallyDestructible() const
+{
+    return _typeInfo(cpp::TypeTrait::is_trivially_destructible);
+}
+
+char* AnyVector::allocate(std::size_t capacity) const
+{
+    char* data = reinterpret_cast<char*>(
+        cpp::detail::aligned_malloc(capacity*stride(), _typeInfo.alignment())
+    );
+
+    if(data == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+
+    return data;
+}
+
+void AnyVector::adopt(char* data, std::size_t capacity)
+{
+    if(_data != nullptr)
+    {
+        relocate(data, _data, _size);
+        cpp::detail::aligned_free(_data);
+    }
+
+    _data = data;
+    _capacity = capacity;
+}
+
+void AnyVector::reallocate(std::size_t capacity)
+{
+    SIPLASPLAS_ASSERT_BE(capacity, _size);
+
+    if(capacity == 0)
+    {
+        return;
+    }
+
+    adopt(allocate(capacity), capacity);
+}
+
+void AnyVector::copyConstruct(char* where, const char* other, std::size_t count) const
+{
+    if(triviallyCopyable())
+    {
+        if(count > 0)
+        {
+            std::memcpy(where, other, count*stride());
+        }
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i, where += stride(), other += stride())
+        {
+            _typeInfo.copyConstruct(where, other);
+        }
+    }
+}
+
+void AnyVector::relocate(char* where, char* other, std::size_t count) const
+{
+    if(triviallyCopyable())
+    {
+        if(count > 0)
+        {
+            std::memcpy(where, other, count*stride());
+        }
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i, where += stride(), other += stride())
+        {
+            _typeInfo.moveConstruct(where, other);
+            _typeInfo.destroy(other);
+        }
+    }
+}
+
+void AnyVector::destroy(char* where, std::size_t count) const
+{
+    if(!triviallyDestructible())
+    {
+        for(std::size_t i = 0; i < count; ++i, where += stride())
+        {
+            _typeInfo.destroy(where);
+        }
+    }
+}
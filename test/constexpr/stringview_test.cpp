@@ -9,3 +9,15 @@ TEST(ArrayViewTest, stringView_toStdString)
     EXPECT_EQ(ConstStringView("hello").str(), std::string("hello"));
     EXPECT_EQ(std::string(ConstStringView("hello").c_str()), std::string("hello"));
 }
+
+TEST(ArrayViewTest, stringView_lengthExcludesNullTerminator)
+{
+    constexpr ConstStringView literal = "hello";
+    const std::string string = "hello";
+    const char* const pointer = "hello";
+
+    static_assert(literal.length() == 5, "");
+    EXPECT_EQ(5u, ConstStringView(string).length());
+    EXPECT_EQ(5u, ConstStringView(pointer).length());
+    EXPECT_EQ(0u, ConstStringView(std::string{}).length());
+}
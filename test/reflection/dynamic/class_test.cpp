@@ -0,0 +1,108 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/dynamic/class.hpp>
+#include <siplasplas/reflection/dynamic/runtime.hpp>
+
+using namespace ::testing;
+using namespace ::cpp::dynamic_reflection;
+
+namespace
+{
+
+class Counter
+{
+public:
+    int value = 40;
+
+    int add(int x) const
+    {
+        return value + x;
+    }
+
+    int twice() const
+    {
+        return 2 * value;
+    }
+};
+
+}
+
+class ClassTest : public Test
+{
+public:
+    ClassTest() :
+        runtime{"ClassTest"}
+    {
+        runtime.addEntity(Class::create(
+            SourceInfo{"::Counter", SourceInfo::Kind::CLASS},
+            cpp::typeerasure::TypeInfo::get<Counter>()
+        ));
+        runtime.addEntity(Function::create(
+            SourceInfo{"::Counter::add", SourceInfo::Kind::FUNCTION},
+            &Counter::add
+        ));
+    }
+
+protected:
+    Runtime runtime;
+
+    Class& counter()
+    {
+        return Class::fromEntity(runtime.getEntity("::Counter").pointer());
+    }
+};
+
+TEST_F(ClassTest, methods_builtOnceWithTheMemberFunctions)
+{
+    const auto methods = counter().methods();
+
+    ASSERT_NE(nullptr, methods);
+    EXPECT_EQ(1, methods->size());
+    EXPECT_NE(methods->end(), methods->find("add"));
+    EXPECT_EQ(methods, counter().methods());
+}
+
+TEST_F(ClassTest, methods_rebuiltWhenAMethodIsAdded)
+{
+    const auto before = counter().methods();
+
+    runtime.addEntity(Function::create(
+        SourceInfo{"::Counter::twice", SourceInfo::Kind::FUNCTION},
+        &Counter::twice
+    ));
+
+    const auto after = counter().methods();
+
+    EXPECT_NE(before, after);
+    EXPECT_EQ(before->end(), before->find("twice"));
+    EXPECT_NE(after->end(), after->find("add"));
+    EXPECT_NE(after->end(), after->find("twice"));
+}
+
+TEST_F(ClassTest, create_objectsShareTheMethodTable)
+{
+    auto object = counter().create();
+    auto other = counter().create();
+
+    EXPECT_TRUE(object.hasType<Counter>());
+    EXPECT_EQ(40, object.get<Counter>().value);
+    EXPECT_EQ(counter().methods(), object.sharedMethods());
+    EXPECT_EQ(counter().methods(), other.sharedMethods());
+    EXPECT_EQ(42, object("add")(2).get<int>());
+}
+
+TEST_F(ClassTest, create_objectsKeepTheirTableAfterARebuild)
+{
+    auto object = counter().create();
+
+    runtime.addEntity(Function::create(
+        SourceInfo{"::Counter::twice", SourceInfo::Kind::FUNCTION},
+        &Counter::twice
+    ));
+
+    auto newObject = counter().create();
+
+    EXPECT_FALSE(object.hasMethod("twice"));
+    EXPECT_TRUE(newObject.hasMethod("twice"));
+    EXPECT_EQ(80, newObject("twice")().get<int>());
+    EXPECT_EQ(42, object("add")(2).get<int>());
+}
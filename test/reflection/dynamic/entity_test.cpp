@@ -1,6 +1,9 @@
 #include <gmock/gmock.h>
 #include <siplasplas/reflection/dynamic/entity.hpp>
 #include <siplasplas/reflection/dynamic/runtime.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
 
 using namespace ::testing;
 using namespace ::cpp::dynamic_reflection;
@@ -16,6 +19,12 @@ public:
     {
         return std::shared_ptr<Entity>{new EntityForTest{sourceInfo}};
     }
+
+private:
+    std::shared_ptr<Entity> clone() const override
+    {
+        return std::shared_ptr<Entity>{new EntityForTest{*this}};
+    }
 };
 
 class EntityTest : public Test
@@ -101,3 +110,268 @@ TEST_F(EntityTest, addChild_detachedEntity_entityAttachedAndIsChild)
     EXPECT_TRUE(runtime.namespace_().isChild(entity));
     EXPECT_EQ(runtime.namespace_(), entity->parent());
 }
+
+TEST_F(EntityTest, detachedEntity_hasNoId)
+{
+    EXPECT_EQ(Entity::InvalidId, entity->id());
+}
+
+TEST_F(EntityTest, addChild_entityRegisteredWithId)
+{
+    runtime.namespace_().addChild(entity);
+
+    ASSERT_NE(Entity::InvalidId, entity->id());
+    EXPECT_EQ(entity.get(), &runtime.getEntity(entity->id()));
+    EXPECT_EQ(entity->id(), runtime.getEntityId("::MyClass"));
+    EXPECT_EQ(Entity::InvalidId, runtime.getEntityId("::NotRegistered"));
+}
+
+TEST_F(EntityTest, addChild_childrenKeepRegistrationOrder)
+{
+    auto other = EntityForTest::create(SourceInfo{"::MyOtherClass", SourceInfo::Kind::CLASS});
+    const auto childrenBefore = runtime.namespace_().children().size();
+
+    runtime.namespace_().addChild(entity);
+    runtime.namespace_().addChild(other);
+
+    const auto& children = runtime.namespace_().children();
+    ASSERT_EQ(childrenBefore + 2, children.size());
+    EXPECT_EQ(entity->id(), children[childrenBefore]);
+    EXPECT_EQ(other->id(), children[childrenBefore + 1]);
+}
+
+TEST_F(EntityTest, addChild_childFoundByName)
+{
+    runtime.namespace_().addChild(entity);
+
+    EXPECT_EQ(entity.get(), runtime.findChild(runtime.namespace_().id(), "MyClass"));
+    EXPECT_EQ(nullptr, runtime.findChild(runtime.namespace_().id(), "MyClas"));
+    EXPECT_EQ(nullptr, runtime.findChild(entity->id(), "MyClass"));
+    EXPECT_TRUE(runtime.namespace_().isChildByName("MyClass"));
+    EXPECT_EQ(*entity, runtime.namespace_().getChildByName("MyClass"));
+}
+
+TEST_F(EntityTest, addChild_duplicateFullName_childLeftDetachedAndOrphan)
+{
+    auto other = EntityForTest::create(SourceInfo{"::MyOtherClass", SourceInfo::Kind::CLASS});
+    auto duplicate = EntityForTest::create(sourceInfo);
+    runtime.namespace_().addChild(entity);
+    runtime.namespace_().addChild(other);
+
+    EXPECT_THROW(other->addChild(duplicate), std::runtime_error);
+    EXPECT_TRUE(duplicate->detached());
+    EXPECT_TRUE(duplicate->orphan());
+    EXPECT_EQ(Entity::InvalidId, duplicate->id());
+    EXPECT_TRUE(other->children().empty());
+    EXPECT_EQ(entity.get(), &runtime.getEntity("::MyClass"));
+}
+
+TEST_F(EntityTest, addEntity_entityIndexedByKind)
+{
+    const auto classesBefore = runtime.getEntitiesByKind(SourceInfo::Kind::CLASS).size();
+    const auto namespacesBefore = runtime.getEntitiesByKind(SourceInfo::Kind::NAMESPACE).size();
+
+    runtime.addEntity(entity);
+
+    const auto& classes = runtime.getEntitiesByKind(SourceInfo::Kind::CLASS);
+    ASSERT_EQ(classesBefore + 1, classes.size());
+    EXPECT_EQ(entity->id(), classes.back());
+    EXPECT_EQ(namespacesBefore, runtime.getEntitiesByKind(SourceInfo::Kind::NAMESPACE).size());
+}
+
+TEST_F(EntityTest, clear_removesAllButGlobalNamespace)
+{
+    runtime.addEntity(entity);
+    runtime.clear();
+
+    EXPECT_EQ(1, runtime.entityCount());
+    EXPECT_FALSE(runtime.hasEntity("::MyClass"));
+    EXPECT_TRUE(runtime.namespace_().children().empty());
+}
+
+TEST_F(EntityTest, entityLoader_loadsMissingEntitiesOnLookup)
+{
+    std::vector<std::string> requested;
+
+    runtime.setEntityLoader([&](const std::string& fullName)
+    {
+        requested.push_back(fullName);
+
+        if(fullName == "::MyClass")
+        {
+            runtime.addEntity(entity);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    });
+
+    EXPECT_FALSE(runtime.hasLoadedEntity("::MyClass"));
+    EXPECT_EQ(entity.get(), runtime.findChild(runtime.namespace_().id(), "MyClass"));
+    EXPECT_TRUE(runtime.hasLoadedEntity("::MyClass"));
+    EXPECT_EQ(*entity, runtime.getEntity("::MyClass"));
+    EXPECT_EQ(nullptr, runtime.findChild(runtime.namespace_().id(), "Other"));
+    EXPECT_THAT(requested, ElementsAre("::MyClass", "::Other"));
+}
+
+TEST_F(EntityTest, entityLoader_existenceQueriesLoadMissingEntities)
+{
+    std::vector<std::string> requested;
+
+    runtime.setEntityLoader([&](const std::string& fullName)
+    {
+        requested.push_back(fullName);
+
+        if(fullName == "::MyClass")
+        {
+            runtime.addEntity(entity);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    });
+
+    EXPECT_TRUE(runtime.hasEntity("::MyClass"));
+    EXPECT_EQ(*entity, runtime.getEntity("::MyClass"));
+    EXPECT_EQ(entity->id(), runtime.getEntityId("::MyClass"));
+    EXPECT_FALSE(runtime.hasEntity("::Other"));
+    EXPECT_EQ(Entity::InvalidId, runtime.getEntityId("::Other"));
+    EXPECT_FALSE(runtime.namespace_().isChildByFullName("::Another"));
+    EXPECT_THAT(requested, ElementsAre("::MyClass", "::Other", "::Other", "::Another"));
+}
+
+TEST_F(EntityTest, entityLoader_isChildByFullNameLoadsMissingEntities)
+{
+    runtime.setEntityLoader([&](const std::string& fullName)
+    {
+        runtime.addEntity(entity);
+        return fullName == "::MyClass";
+    });
+
+    EXPECT_TRUE(runtime.namespace_().isChildByFullName("::MyClass"));
+    EXPECT_TRUE(runtime.hasLoadedEntity("::MyClass"));
+}
+
+TEST_F(EntityTest, freeze_snapshotNotAffectedByLaterChanges)
+{
+    runtime.addEntity(entity);
+    auto snapshot = runtime.freeze();
+    const Entity::Id globalNamespace = runtime.namespace_().id();
+
+    runtime.addEntity(EntityForTest::create(SourceInfo{"::Other", SourceInfo::Kind::CLASS}));
+    runtime.clear();
+
+    ASSERT_EQ(2, snapshot->entityCount());
+    EXPECT_EQ("EntityTest", snapshot->name());
+    ASSERT_NE(nullptr, snapshot->findEntity("::MyClass"));
+    EXPECT_NE(entity.get(), snapshot->findEntity("::MyClass"));
+    EXPECT_EQ(entity->id(), snapshot->findEntity("::MyClass")->id());
+    EXPECT_EQ(nullptr, snapshot->findEntity("::Other"));
+    EXPECT_EQ(snapshot->findEntity("::MyClass"), snapshot->findChild(globalNamespace, "MyClass"));
+    EXPECT_EQ(nullptr, snapshot->findChild(globalNamespace, "Other"));
+    EXPECT_THAT(snapshot->children(globalNamespace), ElementsAre(entity->id()));
+    EXPECT_THAT(snapshot->getEntitiesByKind(SourceInfo::Kind::CLASS), ElementsAre(entity->id()));
+}
+
+TEST_F(EntityTest, publish_readersKeepTheirSnapshotWhileANewOneIsPublished)
+{
+    EXPECT_EQ(nullptr, runtime.snapshot());
+
+    runtime.publish();
+    auto before = runtime.snapshot();
+
+    std::vector<std::thread> readers;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> misses{0};
+
+    for(int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while(!done)
+            {
+                auto snapshot = runtime.snapshot();
+
+                if(snapshot->entityCount() == 2 && snapshot->findEntity("::MyClass") == nullptr)
+                {
+                    ++misses;
+                }
+            }
+        });
+    }
+
+    runtime.addEntity(entity);
+    runtime.publish();
+    done = true;
+
+    for(auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, misses);
+    EXPECT_EQ(1, before->entityCount());
+    ASSERT_NE(nullptr, runtime.snapshot()->findEntity("::MyClass"));
+    EXPECT_EQ(entity->id(), runtime.snapshot()->findEntity("::MyClass")->id());
+}
+
+TEST_F(EntityTest, publish_snapshotsCanBeReadWhileTheRuntimeIsModified)
+{
+    runtime.publish();
+    const Entity::Id globalNamespace = runtime.namespace_().id();
+
+    std::vector<std::thread> readers;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> errors{0};
+
+    for(int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while(!done)
+            {
+                auto snapshot = runtime.snapshot();
+                const auto& children = snapshot->getEntity(globalNamespace).children();
+
+                if(children != snapshot->children(globalNamespace) ||
+                   children.size() + 1 != snapshot->entityCount())
+                {
+                    ++errors;
+                }
+
+                for(Entity::Id id : children)
+                {
+                    const Entity& child = snapshot->getEntity(id);
+
+                    if(child.id() != id || snapshot->findChild(globalNamespace, child.name()) != &child)
+                    {
+                        ++errors;
+                    }
+                }
+            }
+        });
+    }
+
+    // Registering children reallocates the children of the live global namespace
+    for(int i = 0; i < 200; ++i)
+    {
+        runtime.addEntity(EntityForTest::create(
+            SourceInfo{"::Class" + std::to_string(i), SourceInfo::Kind::CLASS}
+        ));
+        runtime.publish();
+    }
+
+    done = true;
+
+    for(auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, errors);
+    EXPECT_EQ(201, runtime.snapshot()->entityCount());
+}
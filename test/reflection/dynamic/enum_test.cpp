@@ -0,0 +1,98 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/dynamic/enum.hpp>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cpp::dynamic_reflection;
+
+namespace
+{
+
+enum class Color
+{
+    RED, GREEN, BLUE
+};
+
+std::shared_ptr<Enum> makeEnum(
+    const std::vector<std::string>& names,
+    const std::vector<std::int64_t>& values)
+{
+    return Enum::create(
+        SourceInfo{"::Color", Kind::ENUM},
+        ::cpp::typeerasure::TypeInfo::get<Color>(),
+        ::cpp::typeerasure::TypeInfo::get<int>(),
+        names,
+        values
+    );
+}
+
+}
+
+TEST(EnumTest, fromString_returnsConstantValue)
+{
+    auto colors = makeEnum({"RED", "GREEN", "BLUE"}, {0, 1, 2});
+    const std::string green = "GREEN";
+
+    EXPECT_EQ(0, colors->fromString("RED"));
+    EXPECT_EQ(1, colors->fromString(green));
+    EXPECT_EQ(2, colors->fromString("BLUE_AND_MORE", 4));
+    EXPECT_THROW(colors->fromString("YELLOW"), std::domain_error);
+    EXPECT_THROW(colors->fromString("RE", 2), std::domain_error);
+}
+
+TEST(EnumTest, has_checksNamesAndValues)
+{
+    auto colors = makeEnum({"RED", "GREEN", "BLUE"}, {0, 1, 2});
+
+    EXPECT_TRUE(colors->has("BLUE"));
+    EXPECT_FALSE(colors->has("blue"));
+    EXPECT_FALSE(colors->has(""));
+    EXPECT_TRUE(colors->has(2));
+    EXPECT_FALSE(colors->has(3));
+    EXPECT_FALSE(colors->has(-1));
+}
+
+TEST(EnumTest, toString_contiguousValues_returnsFirstConstantWithValue)
+{
+    auto colors = makeEnum({"RED", "GREEN", "BLUE", "DEFAULT"}, {-1, 0, 1, 0});
+
+    EXPECT_EQ("RED", colors->toString(-1));
+    EXPECT_EQ("GREEN", colors->toString(0));
+    EXPECT_EQ("BLUE", colors->toString(1));
+    EXPECT_THROW(colors->toString(2), std::domain_error);
+}
+
+TEST(EnumTest, toString_sparseValues_returnsFirstConstantWithValue)
+{
+    auto flags = makeEnum(
+        {"NONE", "LOW", "HIGH", "ALIAS", "MIN"},
+        {0, 1 << 10, std::int64_t{1} << 40, 1 << 10, std::numeric_limits<std::int64_t>::min()}
+    );
+
+    EXPECT_EQ("NONE", flags->toString(0));
+    EXPECT_EQ("LOW", flags->toString(1 << 10));
+    EXPECT_EQ("HIGH", flags->toString(std::int64_t{1} << 40));
+    EXPECT_EQ("MIN", flags->toString(std::numeric_limits<std::int64_t>::min()));
+    EXPECT_FALSE(flags->has(1));
+}
+
+TEST(EnumTest, manyConstants_allNamesAndValuesFound)
+{
+    std::vector<std::string> names;
+    std::vector<std::int64_t> values;
+
+    for(int i = 0; i < 500; ++i)
+    {
+        names.push_back("CONSTANT_" + std::to_string(i));
+        values.push_back(100 + i);
+    }
+
+    auto e = makeEnum(names, values);
+
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        EXPECT_EQ(values[i], e->fromString(names[i]));
+        EXPECT_EQ(names[i], e->toString(values[i]));
+    }
+}
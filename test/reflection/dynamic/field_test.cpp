@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/dynamic/field.hpp>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cpp::dynamic_reflection;
+
+// ::testing has a Field matcher
+using FieldEntity = ::cpp::dynamic_reflection::Field;
+
+namespace
+{
+
+struct Point
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    std::string name;
+};
+
+class NotStandardLayout
+{
+public:
+    virtual ~NotStandardLayout() = default;
+
+    int i = 0;
+};
+
+}
+
+class FieldTest : public Test
+{
+public:
+    FieldTest() :
+        x{FieldEntity::create(SourceInfo{"::Point::x", Kind::FIELD}, &Point::x)},
+        name{FieldEntity::create(SourceInfo{"::Point::name", Kind::FIELD}, &Point::name)},
+        i{FieldEntity::create(SourceInfo{"::NotStandardLayout::i", Kind::FIELD}, &NotStandardLayout::i)}
+    {}
+
+protected:
+    std::shared_ptr<FieldEntity> x, name, i;
+};
+
+TEST_F(FieldTest, standardLayoutClass_fieldHasOffset)
+{
+    EXPECT_TRUE(x->hasOffset());
+    EXPECT_EQ(offsetof(Point, x), x->offset());
+    EXPECT_EQ(offsetof(Point, name), name->offset());
+    EXPECT_EQ(::cpp::typeerasure::TypeInfo::get<float>(), x->typeInfo());
+    EXPECT_EQ(::cpp::typeerasure::TypeInfo::get<Point>(), x->classTypeInfo());
+}
+
+TEST_F(FieldTest, notStandardLayoutClass_fieldHasNoOffset)
+{
+    EXPECT_FALSE(i->hasOffset());
+    EXPECT_EQ(FieldEntity::NoOffset, i->offset());
+}
+
+TEST_F(FieldTest, address_pointsToMemberObject)
+{
+    Point point;
+    NotStandardLayout object;
+
+    EXPECT_EQ(&point.x, x->address(&point));
+    EXPECT_EQ(&point.name, name->address(static_cast<const void*>(&point)));
+    EXPECT_EQ(&object.i, i->address(&object));
+}
+
+TEST_F(FieldTest, valueAndSet_accessMemberObject)
+{
+    Point point;
+    NotStandardLayout object;
+    const std::string hello = "hello";
+    const int answer = 42;
+
+    x->value<float>(&point) = 1.5f;
+    name->set(&point, &hello);
+    i->set(&object, &answer);
+
+    EXPECT_EQ(1.5f, point.x);
+    EXPECT_EQ("hello", point.name);
+    EXPECT_EQ(42, object.i);
+    EXPECT_EQ(42, i->value<int>(static_cast<const void*>(&object)));
+}
+
+TEST_F(FieldTest, gather_readsMemberOfEachObject)
+{
+    std::vector<Point> points(5);
+
+    for(std::size_t j = 0; j < points.size(); ++j)
+    {
+        points[j].x = static_cast<float>(j);
+        points[j].name = std::to_string(j);
+    }
+
+    std::vector<float> xs(points.size());
+    x->gather(points.data(), points.size(), sizeof(Point), xs.data());
+    EXPECT_THAT(xs, ElementsAre(0.0f, 1.0f, 2.0f, 3.0f, 4.0f));
+
+    std::vector<float> erasedXs(points.size());
+    x->gather(points.data(), points.size(), sizeof(Point), static_cast<void*>(erasedXs.data()));
+    EXPECT_EQ(xs, erasedXs);
+
+    std::vector<std::string> names(points.size());
+    name->gather(points.data(), points.size(), sizeof(Point), names.data());
+    EXPECT_THAT(names, ElementsAre("0", "1", "2", "3", "4"));
+}
+
+TEST_F(FieldTest, gather_notStandardLayoutClass_readsMemberOfEachObject)
+{
+    std::vector<NotStandardLayout> objects(3);
+    objects[0].i = 1;
+    objects[1].i = 2;
+    objects[2].i = 3;
+
+    std::vector<int> is(objects.size());
+    i->gather(objects.data(), objects.size(), sizeof(NotStandardLayout), static_cast<void*>(is.data()));
+
+    EXPECT_THAT(is, ElementsAre(1, 2, 3));
+}
@@ -0,0 +1,115 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/dynamic/metadata.hpp>
+
+using namespace ::testing;
+using namespace ::cpp::dynamic_reflection;
+
+class MetadataTest : public Test
+{
+public:
+    MetadataTest()
+    {
+        // Added out of order on purpose
+        builder.add(SourceInfo{"::MyClass::method", Kind::FUNCTION}, 0);
+        builder.add(SourceInfo{"::MyClass", Kind::CLASS}, 1);
+        builder.add(SourceInfo{"::MyEnum", Kind::ENUM}, 2);
+        builder.add(SourceInfo{"::MyClass::Nested", Kind::CLASS}, 3);
+        builder.add(SourceInfo{"::MyClass::Nested::field", Kind::FIELD}, 4);
+        builder.add(SourceInfo{"::MyClass::field", Kind::FIELD}, 5);
+        builder.add(SourceInfo{"::MyClass", Kind::CLASS}, 6);
+
+        blob = builder.build(keys);
+        metadata = Metadata{blob.data(), blob.size() * sizeof(std::uint32_t)};
+    }
+
+protected:
+    detail::MetadataBuilder builder;
+    std::vector<std::uint32_t> blob;
+    std::vector<std::size_t> keys;
+    Metadata metadata;
+
+    std::string fullName(Metadata::Index index) const
+    {
+        return {metadata.fullName(index), metadata.fullNameLength(index)};
+    }
+};
+
+TEST_F(MetadataTest, defaultConstructed_isEmpty)
+{
+    Metadata empty;
+
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(Metadata::InvalidIndex, empty.find("::MyClass"));
+}
+
+TEST_F(MetadataTest, duplicatedEntitiesAreStoredOnce)
+{
+    ASSERT_EQ(6, metadata.count());
+    EXPECT_EQ(6, keys.size());
+}
+
+TEST_F(MetadataTest, find_returnsEntityWithThatName)
+{
+    for(const auto* name : {"::MyClass", "::MyClass::method", "::MyEnum", "::MyClass::Nested::field"})
+    {
+        const auto index = metadata.find(name);
+
+        ASSERT_NE(Metadata::InvalidIndex, index) << name;
+        EXPECT_EQ(name, fullName(index));
+    }
+
+    EXPECT_EQ(Metadata::InvalidIndex, metadata.find("::MyClas"));
+    EXPECT_EQ(Metadata::InvalidIndex, metadata.find("::MyClass::"));
+    EXPECT_EQ(Metadata::InvalidIndex, metadata.find(""));
+}
+
+TEST_F(MetadataTest, keysFollowRecordOrder)
+{
+    EXPECT_EQ(1, keys[metadata.find("::MyClass")]);
+    EXPECT_EQ(0, keys[metadata.find("::MyClass::method")]);
+    EXPECT_EQ(4, keys[metadata.find("::MyClass::Nested::field")]);
+}
+
+TEST_F(MetadataTest, childrenAreContiguous)
+{
+    const auto myClass = metadata.find("::MyClass");
+
+    EXPECT_EQ(Kind::CLASS, metadata.kind(myClass));
+    EXPECT_EQ(Metadata::InvalidIndex, metadata.parent(myClass));
+    ASSERT_EQ(3, metadata.childCount(myClass));
+
+    std::vector<std::string> children;
+
+    for(std::size_t i = 0; i < metadata.childCount(myClass); ++i)
+    {
+        const auto child = metadata.firstChild(myClass) + static_cast<Metadata::Index>(i);
+        EXPECT_EQ(myClass, metadata.parent(child));
+        children.push_back(fullName(child));
+    }
+
+    EXPECT_THAT(children, UnorderedElementsAre("::MyClass::method", "::MyClass::Nested", "::MyClass::field"));
+}
+
+TEST_F(MetadataTest, blobIsRelocatable)
+{
+    std::vector<std::uint32_t> copy{blob};
+    blob.assign(blob.size(), 0);
+    Metadata relocated{copy.data(), copy.size() * sizeof(std::uint32_t)};
+
+    EXPECT_EQ("::MyClass::Nested::field", std::string(
+        relocated.fullName(relocated.find("::MyClass::Nested::field")),
+        relocated.fullNameLength(relocated.find("::MyClass::Nested::field"))
+    ));
+}
+
+TEST_F(MetadataTest, invalidBlobThrows)
+{
+    auto truncated = blob;
+    truncated.pop_back();
+    auto badMagic = blob;
+    badMagic[0] = 0;
+
+    EXPECT_THROW(Metadata(blob.data(), 4), std::runtime_error);
+    EXPECT_THROW(Metadata(truncated.data(), truncated.size() * sizeof(std::uint32_t)), std::runtime_error);
+    EXPECT_THROW(Metadata(badMagic.data(), badMagic.size() * sizeof(std::uint32_t)), std::runtime_error);
+}
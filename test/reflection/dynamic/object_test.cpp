@@ -3,6 +3,7 @@
 
 #include "mockspecialfunctions.hpp"
 
+#include <array>
 #include <iostream>
 
 using namespace ::testing;
@@ -191,3 +192,54 @@ TEST_F(ObjectTest, destructorOfReferenceObject_notInvokeDestructor)
 
     Type1::reset(&functions);
 }
+
+TEST_F(ObjectTest, smallValue_storedInline)
+{
+    Object object{42};
+    const char* begin = reinterpret_cast<const char*>(&object);
+
+    EXPECT_TRUE(Object::storedInline(Type::get<int>()));
+    EXPECT_TRUE(object.isInline());
+    EXPECT_GE(static_cast<const char*>(object.raw()), begin);
+    EXPECT_LT(static_cast<const char*>(object.raw()), begin + sizeof(Object));
+}
+
+TEST_F(ObjectTest, bigValue_notStoredInline)
+{
+    using Big = std::array<char, Object::InlineStorageSize + 1>;
+    Object object{Big{}};
+
+    EXPECT_FALSE(Object::storedInline(Type::get<Big>()));
+    EXPECT_FALSE(object.isInline());
+}
+
+TEST_F(ObjectTest, copyAndMoveInlineValue_valueRelocatedInline)
+{
+    Object object{"hello"s};
+    Object copy{object};
+    Object moved{std::move(copy)};
+
+    ASSERT_TRUE(moved.isInline());
+    EXPECT_NE(moved.raw(), copy.raw());
+    EXPECT_EQ("hello", moved.get<std::string>());
+    EXPECT_EQ("hello", object.get<std::string>());
+}
+
+TEST_F(ObjectTest, assignDifferentTypeInlineValue_valueReplaced)
+{
+    Object object{42};
+    object = Object{"hello"s};
+
+    EXPECT_TRUE(object.isInline());
+    EXPECT_EQ(Type::get<std::string>(), object.type());
+    EXPECT_EQ("hello", object.get<std::string>());
+}
+
+TEST_F(ObjectTest, fromString_inlineValue)
+{
+    Type::registerType<int>();
+    Object object = Object::fromString("int", "42");
+
+    EXPECT_TRUE(object.isInline());
+    EXPECT_EQ(42, object.get<int>());
+}
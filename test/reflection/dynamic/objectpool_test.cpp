@@ -0,0 +1,69 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/dynamic/detail/objectpool.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cpp::dynamic_reflection::detail;
+
+namespace
+{
+
+// Each test uses its own type, so they get their own pool
+template<int Id>
+struct Object
+{
+    char data[64];
+};
+
+}
+
+TEST(ObjectPoolTest, slotsAreReusedAfterDeallocate)
+{
+    using Pool = ObjectPool<Object<0>>;
+
+    void* first = Pool::allocate();
+    Pool::deallocate(first);
+
+    EXPECT_EQ(first, Pool::allocate());
+}
+
+TEST(ObjectPoolTest, cacheOfAThreadThatOnlyFreesGoesBackToThePool)
+{
+    using Pool = ObjectPool<Object<1>>;
+    const std::size_t count = Pool::slotsPerBlock();
+    std::vector<void*> allocated;
+    std::vector<void*> reallocated;
+
+    // Takes the whole first block
+    std::thread{[&]
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            allocated.push_back(Pool::allocate());
+        }
+    }}.join();
+
+    // Frees everything, keeping some slots in its cache until it exits
+    std::thread{[&]
+    {
+        for(void* pointer : allocated)
+        {
+            Pool::deallocate(pointer);
+        }
+    }}.join();
+
+    // No new block is needed if the freeing thread gave back its cache
+    std::thread{[&]
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            reallocated.push_back(Pool::allocate());
+        }
+    }}.join();
+
+    std::sort(allocated.begin(), allocated.end());
+    std::sort(reallocated.begin(), reallocated.end());
+    EXPECT_EQ(allocated, reallocated);
+}
@@ -1,6 +1,8 @@
 #include <gmock/gmock.h>
 #include <siplasplas/reflection/dynamic/type.hpp>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 
 #include "mockspecialfunctions.hpp"
 
@@ -8,6 +10,35 @@ using namespace ::testing;
 using namespace ::cpp;
 using namespace ::cpp::dynamic_reflection;
 
+namespace
+{
+
+struct alignas(64) OverAligned
+{
+    char value[3];
+};
+
+struct ThrowOnCopy
+{
+    ThrowOnCopy() = default;
+    ThrowOnCopy(const ThrowOnCopy&)
+    {
+        throw std::runtime_error{"copy"};
+    }
+};
+
+}
+
+namespace typenames
+{
+
+struct Forced {};
+struct Custom {};
+
+}
+
+CPP_REFLECTION_FORCE_TYPENAME(typenames::Forced)
+CPP_REFLECTION_CUSTOM_TYPENAME_FOR(typenames::Custom, "custom_type_name")
 
 class TypeTest : public MockSpecialFunctionsTest, public Test
 {
@@ -111,3 +142,92 @@ TEST_F(TypeTest, typeWithRightShiftOverload_fromStringNoThrow)
     EXPECT_EQ(*integer, 0);
     Type::get<int>().destroy(integer);
 }
+
+TEST_F(TypeTest, destroy_storageReusedByNextConstruct)
+{
+    Type type = Type::get<std::string>();
+    void* first = type.construct();
+    type.destroy(first);
+    void* second = type.construct();
+
+    EXPECT_EQ(first, second);
+    type.destroy(second);
+}
+
+TEST_F(TypeTest, construct_objectsAreAligned)
+{
+    Type type = Type::get<OverAligned>();
+    std::vector<void*> objects;
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        objects.push_back(type.construct());
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(objects.back()) % alignof(OverAligned));
+    }
+
+    std::sort(objects.begin(), objects.end());
+    EXPECT_EQ(std::end(objects), std::adjacent_find(std::begin(objects), std::end(objects)));
+
+    for(void* object : objects)
+    {
+        type.destroy(object);
+    }
+}
+
+TEST_F(TypeTest, copyConstructThrows_storageReturnedToPool)
+{
+    Type type = Type::get<ThrowOnCopy>();
+    ThrowOnCopy value;
+    void* object = type.construct();
+    type.destroy(object);
+
+    EXPECT_THROW(type.copy_construct(&value), std::runtime_error);
+    void* next = type.construct();
+    EXPECT_EQ(object, next);
+    type.destroy(next);
+}
+
+TEST_F(TypeTest, handlesAreTriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable<Type>::value);
+    EXPECT_EQ(sizeof(void*), sizeof(Type));
+}
+
+TEST_F(TypeTest, getSameType_sameHandle)
+{
+    Type a = Type::get<int>();
+    Type b = Type::get<int>();
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, Type::get<float>());
+    EXPECT_EQ(&a.typeInfo(), &b.typeInfo());
+}
+
+TEST_F(TypeTest, getByName_ignoresTypeKeywordPrefixes)
+{
+    Type::registerType<OverAligned>();
+    const std::string name = Type::get<OverAligned>().typeName();
+
+    EXPECT_EQ(Type::get<OverAligned>(), Type::get(name));
+    EXPECT_EQ(Type::get<OverAligned>(), Type::get("struct " + name));
+    EXPECT_EQ(Type::get<OverAligned>(), Type::get(cpp::constexp::ConstStringView{name}));
+    EXPECT_THROW(Type::get("NotRegistered"), std::runtime_error);
+}
+
+TEST_F(TypeTest, fromId_returnsTypeWithThatId)
+{
+    Type type = Type::get<int>();
+
+    EXPECT_EQ(type, Type::fromId(type.id()));
+    EXPECT_NE(type.id(), Type::get<float>().id());
+    EXPECT_THROW(Type::fromId(0), std::runtime_error);
+}
+
+TEST_F(TypeTest, customTypeName_registeredWithThatName)
+{
+    Type::registerTypes<typenames::Forced, typenames::Custom>();
+
+    EXPECT_EQ(Type::get<typenames::Forced>(), Type::get("typenames::Forced"));
+    EXPECT_EQ(Type::get<typenames::Custom>(), Type::get("custom_type_name"));
+    EXPECT_THROW(Type::get("typenames::Custom"), std::runtime_error);
+}
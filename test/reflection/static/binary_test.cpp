@@ -0,0 +1,210 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/static/binary.hpp>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cpp::static_reflection;
+
+namespace
+{
+
+enum class Color : std::uint8_t
+{
+    RED, GREEN, BLUE
+};
+
+struct Vector3
+{
+    float x, y, z;
+};
+
+struct Particle
+{
+    std::string name;
+    Vector3 position;
+    Color color;
+    std::vector<Vector3> trail;
+    std::map<std::string, int> tags;
+    std::tuple<int, std::string, bool> extra;
+    std::vector<bool> flags;
+};
+
+template<typename Class, typename... Fields>
+using ClassInfo = meta::Class<
+    meta::EmptySourceInfo<Class>,
+    Class,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<Fields...>,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<>
+>;
+
+template<typename FieldType, FieldType field>
+using FieldInfo = meta::Field<meta::EmptySourceInfo<Vector3>, FieldType, field>;
+
+}
+
+// Static reflection information, as the reflection parser generates it
+namespace cpp
+{
+namespace static_reflection
+{
+namespace codegen
+{
+
+template<>
+class Class<Vector3> : public ClassInfo<Vector3,
+    FieldInfo<float Vector3::*, &Vector3::x>,
+    FieldInfo<float Vector3::*, &Vector3::y>,
+    FieldInfo<float Vector3::*, &Vector3::z>
+>
+{};
+
+template<>
+class Class<Particle> : public ClassInfo<Particle,
+    FieldInfo<std::string Particle::*, &Particle::name>,
+    FieldInfo<Vector3 Particle::*, &Particle::position>,
+    FieldInfo<Color Particle::*, &Particle::color>,
+    FieldInfo<std::vector<Vector3> Particle::*, &Particle::trail>,
+    FieldInfo<std::map<std::string, int> Particle::*, &Particle::tags>,
+    FieldInfo<std::tuple<int, std::string, bool> Particle::*, &Particle::extra>,
+    FieldInfo<std::vector<bool> Particle::*, &Particle::flags>
+>
+{};
+
+}
+}
+}
+
+static_assert(binary::Serializer<Vector3>::packed, "Vector3 should be packed");
+static_assert(!binary::Serializer<Particle>::packed, "Particle has strings, cannot be packed");
+
+TEST(BinarySerializationTest, packedClass_serializedAsObjectRepresentation)
+{
+    const Vector3 vector{1.0f, 2.0f, 3.0f};
+    const auto buffer = binary::serialize(vector);
+
+    ASSERT_EQ(sizeof(Vector3), buffer.size());
+    EXPECT_EQ(0, std::memcmp(buffer.data(), &vector, sizeof(Vector3)));
+
+    const auto result = binary::deserialize<Vector3>(buffer);
+    EXPECT_EQ(1.0f, result.x);
+    EXPECT_EQ(2.0f, result.y);
+    EXPECT_EQ(3.0f, result.z);
+}
+
+TEST(BinarySerializationTest, vectorOfPackedClass_serializedAsCountAndElements)
+{
+    const std::vector<Vector3> vectors(100, Vector3{1.0f, 2.0f, 3.0f});
+    const auto buffer = binary::serialize(vectors);
+
+    // 100 fits in a one byte varint
+    ASSERT_EQ(1 + 100 * sizeof(Vector3), buffer.size());
+
+    const auto result = binary::deserialize<std::vector<Vector3>>(buffer);
+    ASSERT_EQ(100u, result.size());
+    EXPECT_EQ(3.0f, result.back().z);
+}
+
+TEST(BinarySerializationTest, class_roundTrip)
+{
+    Particle particle;
+    particle.name = "a particle with a name long enough to not fit in the SSO buffer";
+    particle.position = {1.0f, -2.0f, 3.5f};
+    particle.color = Color::BLUE;
+    particle.trail = {{0.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}};
+    particle.tags = {{"mass", 42}, {"charge", -1}};
+    particle.extra = std::make_tuple(7, "seven", true);
+    particle.flags = {true, false, true};
+
+    std::vector<char> buffer;
+    binary::serialize(particle, buffer);
+
+    Particle result;
+    EXPECT_EQ(buffer.size(), binary::deserialize(buffer.data(), buffer.size(), result));
+    EXPECT_EQ(particle.name, result.name);
+    EXPECT_EQ(-2.0f, result.position.y);
+    EXPECT_EQ(Color::BLUE, result.color);
+    ASSERT_EQ(2u, result.trail.size());
+    EXPECT_EQ(0.5f, result.trail[1].x);
+    EXPECT_EQ(particle.tags, result.tags);
+    EXPECT_EQ(particle.extra, result.extra);
+    EXPECT_EQ(particle.flags, result.flags);
+}
+
+TEST(BinarySerializationTest, containers_roundTrip)
+{
+    const std::unordered_map<int, std::vector<std::string>> map{
+        {1, {"one", "uno"}},
+        {2, {}},
+        {300, {std::string(200, 'x')}}
+    };
+    const std::array<std::pair<int, std::string>, 2> array{{{1, "a"}, {2, "b"}}};
+
+    EXPECT_EQ(map, binary::deserialize<std::decay_t<decltype(map)>>(binary::serialize(map)));
+    EXPECT_EQ(array, binary::deserialize<std::decay_t<decltype(array)>>(binary::serialize(array)));
+    EXPECT_EQ(std::string{}, binary::deserialize<std::string>(binary::serialize(std::string{})));
+}
+
+TEST(BinarySerializationTest, truncatedData_throws)
+{
+    Particle particle;
+    particle.name = "name";
+    particle.trail.resize(10);
+
+    const auto buffer = binary::serialize(particle);
+    Particle result;
+
+    for(std::size_t size = 0; size < buffer.size(); ++size)
+    {
+        EXPECT_THROW(binary::deserialize(buffer.data(), size, result), std::runtime_error);
+    }
+}
+
+TEST(BinarySerializationTest, corruptCount_throwsWithoutAllocating)
+{
+    // Varint encoding of 2^62 followed by a few bytes
+    const std::vector<char> buffer{
+        '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x40', 'a', 'b'
+    };
+
+    EXPECT_THROW(binary::deserialize<std::string>(buffer), std::runtime_error);
+    EXPECT_THROW(binary::deserialize<std::vector<Vector3>>(buffer), std::runtime_error);
+}
+
+TEST(BinarySerializationTest, corruptCountOfEmptyElements_throws)
+{
+    // Varint encoding of 2^62, nothing after it
+    const std::vector<char> buffer{
+        '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', '\x40'
+    };
+
+    EXPECT_THROW(binary::deserialize<std::vector<std::tuple<>>>(buffer), std::runtime_error);
+}
+
+TEST(BinarySerializationTest, varintOverflowingTheTenthByte_throws)
+{
+    // Tenth byte with more bits than the 64th
+    const std::vector<char> buffer{
+        '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\x02'
+    };
+
+    binary::Reader reader{buffer.data(), buffer.size()};
+    EXPECT_THROW(reader.readVarint(), std::runtime_error);
+}
+
+TEST(BinarySerializationTest, invalidBoolAndEnumBytes_areNotCopiedAsIs)
+{
+    static_assert(!binary::Serializer<bool>::packed, "bool values must be validated");
+    static_assert(!binary::Serializer<Color>::packed, "enum values must be read as their underlying type");
+
+    EXPECT_THROW(binary::deserialize<bool>(std::vector<char>{'\x02'}), std::runtime_error);
+    EXPECT_THROW(binary::deserialize<std::vector<bool>>(std::vector<char>{'\x01', '\x7F'}), std::runtime_error);
+    EXPECT_TRUE(binary::deserialize<bool>(std::vector<char>{'\x01'}));
+    EXPECT_EQ(Color::BLUE, binary::deserialize<Color>(binary::serialize(Color::BLUE)));
+}
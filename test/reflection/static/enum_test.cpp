@@ -0,0 +1,84 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/static/sourceinfo.hpp>
+#include <siplasplas/reflection/static/enum.hpp>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cpp::static_reflection;
+
+namespace
+{
+
+enum class Dense : unsigned char
+{
+    A = 1, B = 2, C = 3, ALIAS = 2
+};
+
+enum class Sparse : long long
+{
+    NONE = 0, LOW = 1 << 10, HIGH = 1ll << 40, MIN = -(1ll << 50)
+};
+
+template<typename EnumType, EnumType... Values>
+using EnumConstants = ::cpp::meta::list<std::integral_constant<EnumType, Values>...>;
+
+using DenseEnum = meta::Enum<
+    meta::EmptySourceInfo<Dense>,
+    Dense,
+    EnumConstants<Dense, Dense::A, Dense::B, Dense::C, Dense::ALIAS>,
+    ::cpp::meta::list<
+        ::cpp::meta::string<'A'>,
+        ::cpp::meta::string<'B'>,
+        ::cpp::meta::string<'C'>,
+        ::cpp::meta::string<'A', 'L', 'I', 'A', 'S'>
+    >
+>;
+
+using SparseEnum = meta::Enum<
+    meta::EmptySourceInfo<Sparse>,
+    Sparse,
+    EnumConstants<Sparse, Sparse::NONE, Sparse::LOW, Sparse::HIGH, Sparse::MIN>,
+    ::cpp::meta::list<
+        ::cpp::meta::string<'N', 'O', 'N', 'E'>,
+        ::cpp::meta::string<'L', 'O', 'W'>,
+        ::cpp::meta::string<'H', 'I', 'G', 'H'>,
+        ::cpp::meta::string<'M', 'I', 'N'>
+    >
+>;
+
+// Conversions are constant expressions
+static_assert(DenseEnum::fromString("C") == Dense::C, "");
+static_assert(DenseEnum::has("ALIAS") && !DenseEnum::has("ALIA") && !DenseEnum::has("ALIASES"), "");
+static_assert(DenseEnum::has(3) && !DenseEnum::has(4) && !DenseEnum::has(200), "");
+static_assert(SparseEnum::fromString("MIN") == Sparse::MIN, "");
+static_assert(SparseEnum::has(1ll << 40) && !SparseEnum::has(1), "");
+
+}
+
+TEST(StaticEnumTest, denseValues_toStringReturnsFirstConstantWithValue)
+{
+    EXPECT_STREQ("A", DenseEnum::toString(Dense::A));
+    EXPECT_STREQ("B", DenseEnum::toString(Dense::ALIAS));
+    EXPECT_STREQ("C", DenseEnum::toString(Dense::C));
+    EXPECT_EQ(nullptr, DenseEnum::toString(static_cast<Dense>(200)));
+}
+
+TEST(StaticEnumTest, sparseValues_toStringReturnsConstantName)
+{
+    EXPECT_STREQ("NONE", SparseEnum::toString(Sparse::NONE));
+    EXPECT_STREQ("LOW", SparseEnum::toString(Sparse::LOW));
+    EXPECT_STREQ("HIGH", SparseEnum::toString(Sparse::HIGH));
+    EXPECT_STREQ("MIN", SparseEnum::toString(Sparse::MIN));
+    EXPECT_EQ(nullptr, SparseEnum::toString(static_cast<Sparse>(7)));
+}
+
+TEST(StaticEnumTest, fromString_returnsConstantValue)
+{
+    const std::string low = "LOW";
+
+    EXPECT_EQ(Dense::A, DenseEnum::fromString("A"));
+    EXPECT_EQ(Dense::ALIAS, DenseEnum::fromString("ALIAS"));
+    EXPECT_EQ(Sparse::LOW, SparseEnum::fromString(low.c_str()));
+    EXPECT_FALSE(SparseEnum::has("low"));
+    EXPECT_FALSE(SparseEnum::has(""));
+}
@@ -0,0 +1,321 @@
+#include <gmock/gmock.h>
+#include <siplasplas/reflection/static/protobuf.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cpp::static_reflection;
+
+namespace
+{
+
+// Same layout as the protoserialization example data model, whose
+// messages are defined in examples/reflection/static/protoserialization/commmodel.proto
+struct NetworkSettings
+{
+    std::string ipAddress;
+    std::string gateway;
+    std::chrono::milliseconds pingInterval;
+};
+
+struct ServerSettings
+{
+    int port;
+};
+
+struct Settings
+{
+    NetworkSettings networkSettings;
+    ServerSettings serverSettings;
+};
+
+enum class Operation
+{
+    Set, Get
+};
+
+struct SettingsOperation
+{
+    Operation operation;
+    Settings settings;
+};
+
+struct Sample
+{
+    std::vector<int> values;
+    double ratio;
+    float scale;
+    bool enabled;
+    std::vector<std::string> names;
+};
+
+template<typename Class, typename... Fields>
+using ClassInfo = meta::Class<
+    meta::EmptySourceInfo<Class>,
+    Class,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<Fields...>,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<>,
+    ::cpp::meta::list<>
+>;
+
+template<typename FieldType, FieldType field>
+using FieldInfo = meta::Field<meta::EmptySourceInfo<Sample>, FieldType, field>;
+
+// Length delimited value counting how many times its size is computed
+struct Counted
+{
+    std::string payload;
+};
+
+std::size_t countedSizes = 0;
+
+struct Inner
+{
+    Counted counted;
+};
+
+struct Outer
+{
+    Inner inner;
+    std::vector<Inner> inners;
+};
+
+std::vector<char> bytes(std::initializer_list<int> values)
+{
+    std::vector<char> result;
+
+    for(int value : values)
+    {
+        result.push_back(static_cast<char>(value));
+    }
+
+    return result;
+}
+
+void append(std::vector<char>& buffer, const std::string& string)
+{
+    buffer.insert(buffer.end(), string.begin(), string.end());
+}
+
+}
+
+// Static reflection information, as the reflection parser generates it
+namespace cpp
+{
+namespace static_reflection
+{
+namespace codegen
+{
+
+template<>
+class Class<NetworkSettings> : public ClassInfo<NetworkSettings,
+    FieldInfo<std::string NetworkSettings::*, &NetworkSettings::ipAddress>,
+    FieldInfo<std::string NetworkSettings::*, &NetworkSettings::gateway>,
+    FieldInfo<std::chrono::milliseconds NetworkSettings::*, &NetworkSettings::pingInterval>
+>
+{};
+
+template<>
+class Class<ServerSettings> : public ClassInfo<ServerSettings,
+    FieldInfo<int ServerSettings::*, &ServerSettings::port>
+>
+{};
+
+template<>
+class Class<Settings> : public ClassInfo<Settings,
+    FieldInfo<NetworkSettings Settings::*, &Settings::networkSettings>,
+    FieldInfo<ServerSettings Settings::*, &Settings::serverSettings>
+>
+{};
+
+template<>
+class Class<SettingsOperation> : public ClassInfo<SettingsOperation,
+    FieldInfo<Operation SettingsOperation::*, &SettingsOperation::operation>,
+    FieldInfo<Settings SettingsOperation::*, &SettingsOperation::settings>
+>
+{};
+
+template<>
+class Class<Inner> : public ClassInfo<Inner,
+    FieldInfo<Counted Inner::*, &Inner::counted>
+>
+{};
+
+template<>
+class Class<Outer> : public ClassInfo<Outer,
+    FieldInfo<Inner Outer::*, &Outer::inner>,
+    FieldInfo<std::vector<Inner> Outer::*, &Outer::inners>
+>
+{};
+
+template<>
+class Class<Sample> : public ClassInfo<Sample,
+    FieldInfo<std::vector<int> Sample::*, &Sample::values>,
+    FieldInfo<double Sample::*, &Sample::ratio>,
+    FieldInfo<float Sample::*, &Sample::scale>,
+    FieldInfo<bool Sample::*, &Sample::enabled>,
+    FieldInfo<std::vector<std::string> Sample::*, &Sample::names>
+>
+{};
+
+}
+
+namespace protobuf
+{
+
+template<>
+class FieldNumbers<Sample> : public Numbers<1, 2, 5, 16, 3>
+{};
+
+template<>
+class Codec<Counted>
+{
+public:
+    static constexpr WireType wireType = WireType::LENGTH_DELIMITED;
+
+    static std::size_t size(const Counted& counted, SizeCache& cache)
+    {
+        ++countedSizes;
+        return Codec<std::string>::size(counted.payload, cache);
+    }
+
+    static char* write(char* out, const Counted& counted, SizeCache& cache)
+    {
+        return Codec<std::string>::write(out, counted.payload, cache);
+    }
+
+    static void read(binary::Reader& reader, Counted& counted)
+    {
+        Codec<std::string>::read(reader, counted.payload);
+    }
+};
+
+}
+}
+}
+
+TEST(ProtobufSerializationTest, varintFieldsMatchProtobufEncoding)
+{
+    EXPECT_EQ(protobuf::serialize(ServerSettings{4242}), bytes({0x08, 0x92, 0x21}));
+    EXPECT_EQ(protobuf::serialize(ServerSettings{0}), bytes({0x08, 0x00}));
+
+    // Negative int32 values are sign extended to ten bytes
+    EXPECT_EQ(protobuf::serialize(ServerSettings{-1}),
+        bytes({0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}));
+    EXPECT_EQ(protobuf::deserialize<ServerSettings>(protobuf::serialize(ServerSettings{-1})).port, -1);
+}
+
+TEST(ProtobufSerializationTest, embeddedMessagesAreLengthDelimited)
+{
+    const SettingsOperation operation{
+        Operation::Get,
+        Settings{
+            NetworkSettings{"192.168.1.2", "192.168.1.1", std::chrono::milliseconds(10000)},
+            ServerSettings{4242}
+        }
+    };
+
+    std::vector<char> expected = bytes({0x08, 0x01, 0x12, 0x24, 0x0A, 0x1D, 0x0A, 0x0B});
+    append(expected, "192.168.1.2");
+    append(expected, std::string{"\x12\x0B", 2});
+    append(expected, "192.168.1.1");
+    append(expected, std::string{"\x18\x90\x4E\x12\x03\x08\x92\x21", 8});
+
+    EXPECT_EQ(protobuf::byteSize(operation), expected.size());
+    EXPECT_EQ(protobuf::serialize(operation), expected);
+
+    const auto result = protobuf::deserialize<SettingsOperation>(expected);
+    EXPECT_EQ(result.operation, Operation::Get);
+    EXPECT_EQ(result.settings.networkSettings.ipAddress, "192.168.1.2");
+    EXPECT_EQ(result.settings.networkSettings.gateway, "192.168.1.1");
+    EXPECT_EQ(result.settings.networkSettings.pingInterval.count(), 10000);
+    EXPECT_EQ(result.settings.serverSettings.port, 4242);
+}
+
+TEST(ProtobufSerializationTest, customFieldNumbers)
+{
+    const Sample sample{{1, 300}, 0.5, 2.0f, true, {"a", ""}};
+
+    const auto buffer = protobuf::serialize(sample);
+    EXPECT_EQ(buffer, bytes({
+        0x08, 0x01, 0x08, 0xAC, 0x02,                             // values = 1, values = 300
+        0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x3F,     // ratio (fixed64)
+        0x2D, 0x00, 0x00, 0x00, 0x40,                             // scale (fixed32, field 5)
+        0x80, 0x01, 0x01,                                         // enabled (field 16)
+        0x1A, 0x01, 'a', 0x1A, 0x00                               // names (field 3)
+    }));
+
+    const auto result = protobuf::deserialize<Sample>(buffer);
+    EXPECT_EQ(result.values, (std::vector<int>{1, 300}));
+    EXPECT_EQ(result.ratio, 0.5);
+    EXPECT_EQ(result.scale, 2.0f);
+    EXPECT_TRUE(result.enabled);
+    EXPECT_EQ(result.names, (std::vector<std::string>{"a", ""}));
+}
+
+TEST(ProtobufSerializationTest, readsPackedRepeatedScalars)
+{
+    const auto result = protobuf::deserialize<Sample>(bytes({
+        0x0A, 0x03, 0x01, 0xAC, 0x02,  // values = [1, 300], packed
+        0x08, 0x07                     // values = 7, unpacked
+    }));
+
+    EXPECT_EQ(result.values, (std::vector<int>{1, 300, 7}));
+}
+
+TEST(ProtobufSerializationTest, skipsUnknownFields)
+{
+    std::vector<char> buffer = bytes({
+        0x48, 0x96, 0x01,                                       // field 9, varint
+        0x51, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,   // field 10, fixed64
+        0x5A, 0x02, 0x01, 0x02,                                 // field 11, length delimited
+        0x65, 0x01, 0x02, 0x03, 0x04,                           // field 12, fixed32
+        0x08, 0x92, 0x21                                        // port = 4242
+    });
+
+    EXPECT_EQ(protobuf::deserialize<ServerSettings>(buffer).port, 4242);
+}
+
+TEST(ProtobufSerializationTest, missingFieldsKeepTheirValue)
+{
+    ServerSettings settings{8080};
+    protobuf::deserialize(nullptr, 0, settings);
+
+    EXPECT_EQ(settings.port, 8080);
+}
+
+TEST(ProtobufSerializationTest, invalidDataThrows)
+{
+    // Truncated varint
+    EXPECT_THROW(protobuf::deserialize<ServerSettings>(bytes({0x08, 0x92})), std::runtime_error);
+    // Length past the end of the data
+    EXPECT_THROW(protobuf::deserialize<Settings>(bytes({0x0A, 0x10, 0x00})), std::runtime_error);
+    // Known field with the wrong wire type
+    EXPECT_THROW(protobuf::deserialize<ServerSettings>(bytes({0x0D, 0x00, 0x00, 0x00, 0x00})), std::runtime_error);
+    // Groups are not supported
+    EXPECT_THROW(protobuf::deserialize<ServerSettings>(bytes({0x4B, 0x4C})), std::runtime_error);
+}
+
+TEST(ProtobufSerializationTest, embeddedMessageSizesAreComputedOnce)
+{
+    const Outer outer{Inner{Counted{"a"}}, {Inner{Counted{"bc"}}, Inner{Counted{""}}}};
+    countedSizes = 0;
+
+    const auto buffer = protobuf::serialize(outer);
+
+    EXPECT_EQ(3u, countedSizes);
+    EXPECT_EQ(buffer, bytes({
+        0x0A, 0x03, 0x0A, 0x01, 'a',        // inner
+        0x12, 0x04, 0x0A, 0x02, 'b', 'c',   // inners[0]
+        0x12, 0x02, 0x0A, 0x00              // inners[1]
+    }));
+
+    const auto result = protobuf::deserialize<Outer>(buffer);
+    EXPECT_EQ(result.inner.counted.payload, "a");
+    ASSERT_EQ(result.inners.size(), 2u);
+    EXPECT_EQ(result.inners[0].counted.payload, "bc");
+    EXPECT_EQ(result.inners[1].counted.payload, "");
+}
@@ -190,3 +190,53 @@ TEST(AnyTest, Any64_setFieldValue)
     EXPECT_EQ(43, any["i"].get<int>());
     EXPECT_EQ("hello, world!", any["str"].get<std::string>());
 }
+
+TEST(AnyTest, sharedMethods_invokedWithoutAssigning)
+{
+    auto methods = std::make_shared<Any32::Methods>();
+    (*methods)["addIntsByValue"] = &Class::addIntsByValue;
+    (*methods)["addIntsByValueConst"] = &Class::addIntsByValueConst;
+
+    Any32 any{Class()};
+    const Any32& constAny = any;
+    any.setMethods(methods);
+
+    EXPECT_TRUE(any.hasMethod("addIntsByValue"));
+    EXPECT_TRUE(any.hasMethod("addIntsByValueConst"));
+    EXPECT_FALSE(any.hasMethod("addStringsByConstReference"));
+    EXPECT_EQ(42, any("addIntsByValue")(20, 22).get<int>());
+    EXPECT_EQ(42, constAny("addIntsByValueConst")(20, 22).get<int>());
+    EXPECT_EQ(&(*methods)["addIntsByValue"], &constAny("addIntsByValue").method());
+}
+
+TEST(AnyTest, sharedMethods_assignedMethodShadowsSharedOne)
+{
+    auto methods = std::make_shared<Any32::Methods>();
+    (*methods)["add"] = &Class::addIntsByValue;
+
+    Any32 any{Class()}, other{Class()};
+    any.setMethods(methods);
+    other.setMethods(methods);
+
+    any("add") = [](const Class&, int a, int b) { return a * b; };
+
+    EXPECT_EQ(440, any("add")(20, 22).get<int>());
+    EXPECT_EQ(42, other("add")(20, 22).get<int>());
+    EXPECT_EQ(42, (*methods)["add"](Class(), 20, 22).get<int>());
+}
+
+TEST(AnyTest, sharedMethods_proxyOutlivesTheLookupName)
+{
+    const std::string name = "a method name too long for the small string buffer";
+    auto methods = std::make_shared<Any32::Methods>();
+    (*methods)[name] = &Class::addIntsByValue;
+
+    Any32 any{Class()};
+    any.setMethods(methods);
+
+    auto proxy = any(std::string{name});
+    proxy = [](const Class&, int a, int b) { return a * b; };
+
+    EXPECT_EQ(440, any(name)(20, 22).get<int>());
+    EXPECT_EQ(42, (*methods)[name](Class(), 20, 22).get<int>());
+}
@@ -0,0 +1,228 @@
+#include <siplasplas/typeerasure/anyvector.hpp>
+#include <gmock/gmock.h>
+#include <string>
+#include <array>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+
+struct alignas(32) OverAligned
+{
+    int value = 0;
+};
+
+struct CountInstances
+{
+    static int instances;
+
+    CountInstances() { ++instances; }
+    CountInstances(const CountInstances&) { ++instances; }
+    CountInstances(CountInstances&&) { ++instances; }
+    CountInstances& operator=(const CountInstances&) = default;
+    CountInstances& operator=(CountInstances&&) = default;
+    ~CountInstances() { --instances; }
+};
+
+int CountInstances::instances = 0;
+
+}
+
+TEST(AnyVectorTest, create_isEmpty)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(0, vector.size());
+    EXPECT_TRUE(vector.hasType<std::string>());
+    EXPECT_FALSE(vector.hasType<int>());
+}
+
+TEST(AnyVectorTest, createWithCount_defaultConstructsElements)
+{
+    auto vector = cpp::AnyVector::create<std::string>(4);
+
+    ASSERT_EQ(4, vector.size());
+
+    for(std::size_t i = 0; i < vector.size(); ++i)
+    {
+        EXPECT_EQ("", vector.get<std::string>(i));
+    }
+}
+
+TEST(AnyVectorTest, elementsAreContiguous)
+{
+    auto vector = cpp::AnyVector::create<std::array<char, 7>>(3);
+
+    EXPECT_EQ(sizeof(std::array<char, 7>), vector.stride());
+    EXPECT_EQ(vector.at(0), vector.data());
+    EXPECT_EQ(static_cast<char*>(vector.data()) + 2*vector.stride(), vector.at(2));
+}
+
+TEST(AnyVectorTest, elementsAreAligned)
+{
+    auto vector = cpp::AnyVector::create<OverAligned>();
+
+    for(int i = 0; i < 10; ++i)
+    {
+        vector.push_back(OverAligned{i});
+    }
+
+    for(std::size_t i = 0; i < vector.size(); ++i)
+    {
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(vector.at(i)) % alignof(OverAligned));
+        EXPECT_EQ(static_cast<int>(i), vector.get<OverAligned>(i).value);
+    }
+}
+
+TEST(AnyVectorTest, pushBack_growsKeepingValues)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+
+    for(int i = 0; i < 100; ++i)
+    {
+        vector.push_back(std::to_string(i));
+    }
+
+    ASSERT_EQ(100, vector.size());
+    EXPECT_GE(vector.capacity(), vector.size());
+
+    for(int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(std::to_string(i), vector.get<std::string>(i));
+    }
+}
+
+TEST(AnyVectorTest, pushBack_typeErasedValue_copiesValue)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+    std::string str = "hello";
+    cpp::SimpleAny32 any{"world"s};
+
+    vector.push_back(cpp::ConstReferenceSimpleAny{str});
+    vector.push_back(any);
+
+    ASSERT_EQ(2, vector.size());
+    EXPECT_EQ("hello", vector.get<std::string>(0));
+    EXPECT_EQ("world", vector.get<std::string>(1));
+    EXPECT_EQ("hello", str);
+    EXPECT_EQ("world", any.get<std::string>());
+}
+
+TEST(AnyVectorTest, pushBack_elementOfTheSameVector_copiedBeforeReallocating)
+{
+    const std::string longString(100, 'x');
+    auto vector = cpp::AnyVector::create<std::string>();
+    vector.push_back(longString);
+
+    // Each insertion below fills the buffer, so the next one reallocates
+    ASSERT_EQ(vector.size(), vector.capacity());
+    vector.push_back(vector.get<std::string>(0));
+    ASSERT_EQ(vector.size(), vector.capacity());
+    vector.push_back(vector[0]);
+    vector.push_back(longString);
+    ASSERT_EQ(vector.size(), vector.capacity());
+    vector.emplace_back<std::string>(vector.get<std::string>(0));
+
+    ASSERT_EQ(5u, vector.size());
+
+    for(std::size_t i = 0; i < vector.size(); ++i)
+    {
+        EXPECT_EQ(longString, vector.get<std::string>(i));
+    }
+}
+
+TEST(AnyVectorTest, pushBack_wrongType_assertThrows)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+
+    EXPECT_THROW(vector.push_back(42), cpp::AssertException);
+    EXPECT_THROW(vector.push_back(cpp::SimpleAny32{42}), cpp::AssertException);
+}
+
+TEST(AnyVectorTest, subscript_referencesElement)
+{
+    auto vector = cpp::AnyVector::create<int>();
+    vector.push_back(1);
+    vector.push_back(2);
+
+    cpp::ReferenceSimpleAny second = vector[1];
+    second.get<int>() = 42;
+
+    EXPECT_TRUE(second.hasType<int>());
+    EXPECT_EQ(vector.at(1), &second.get<int>());
+    EXPECT_EQ(42, vector.get<int>(1));
+
+    const auto& constVector = vector;
+    EXPECT_EQ(42, constVector[1].get<int>());
+}
+
+TEST(AnyVectorTest, copy_copiesElements)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+    vector.push_back("hello"s);
+    vector.push_back("world"s);
+
+    auto copy = vector;
+    copy.get<std::string>(0) = "bye";
+
+    ASSERT_EQ(2, copy.size());
+    EXPECT_NE(copy.data(), vector.data());
+    EXPECT_EQ("bye", copy.get<std::string>(0));
+    EXPECT_EQ("world", copy.get<std::string>(1));
+    EXPECT_EQ("hello", vector.get<std::string>(0));
+}
+
+TEST(AnyVectorTest, move_stealsBuffer)
+{
+    auto vector = cpp::AnyVector::create<std::string>();
+    vector.push_back("hello"s);
+    void* buffer = vector.data();
+
+    auto moved = std::move(vector);
+
+    EXPECT_EQ(buffer, moved.data());
+    EXPECT_EQ(1, moved.size());
+    EXPECT_TRUE(vector.empty());
+}
+
+TEST(AnyVectorTest, assignment_changesElementType)
+{
+    auto ints = cpp::AnyVector::create<int>(2);
+    auto strings = cpp::AnyVector::create<std::string>(3);
+
+    ints = strings;
+
+    EXPECT_TRUE(ints.hasType<std::string>());
+    EXPECT_EQ(3, ints.size());
+}
+
+TEST(AnyVectorTest, elementsDestroyed)
+{
+    {
+        auto vector = cpp::AnyVector::create<CountInstances>(10);
+        EXPECT_EQ(10, CountInstances::instances);
+
+        for(int i = 0; i < 100; ++i)
+        {
+            vector.emplace_back();
+        }
+        EXPECT_EQ(110, CountInstances::instances);
+
+        vector.pop_back();
+        EXPECT_EQ(109, CountInstances::instances);
+
+        vector.resize(50);
+        EXPECT_EQ(50, CountInstances::instances);
+
+        auto copy = vector;
+        EXPECT_EQ(100, CountInstances::instances);
+
+        copy.clear();
+        EXPECT_EQ(50, CountInstances::instances);
+    }
+
+    EXPECT_EQ(0, CountInstances::instances);
+}
@@ -1,6 +1,7 @@
 #include "mocks/invoke.hpp"
 #include <siplasplas/typeerasure/function.hpp>
 #include <gmock/gmock.h>
+#include <array>
 
 using namespace ::testing;
 using namespace ::cpp::typeerasure;
@@ -54,3 +55,200 @@ TEST(FunctionTest, Function32_constMemberFunctionStringsByConstReference)
     EXPECT_EQ("hello, world!", Function32(&Class::addStringsByConstReferenceConst)(Class(), "hello, "s, "world!"s).get<std::string>());
     EXPECT_EQ("hello, world!", Function32(&Class::addStringsByConstReferenceConst).invoke(std::vector<cpp::AnyArg>{Class(), "hello, "s, "world!"s}).get<std::string>());
 }
+
+TEST(FunctionTest, Function8_bigCallable_copyAndMoveKeepState)
+{
+    std::array<int, 16> values;
+    values.fill(1);
+    values[0] = 27;
+
+    Function8 function{[values](int i) { return values[0] + values[1] + i; }};
+    Function8 copy{function};
+    Function8 moved{std::move(function)};
+
+    EXPECT_TRUE(function.empty());
+    EXPECT_EQ(42, copy(14).get<int>());
+    EXPECT_EQ(42, moved(14).get<int>());
+
+    copy = moved;
+    EXPECT_EQ(42, copy(14).get<int>());
+}
+
+TEST(FunctionTest, Function32_smallCallable_copyAndMoveKeepState)
+{
+    std::string str = "hello, ";
+
+    Function32 function{[str](const std::string& other) { return str + other; }};
+    Function32 copy{function};
+    Function32 moved{std::move(function)};
+
+    EXPECT_TRUE(function.empty());
+    EXPECT_EQ("hello, world!", copy("world!"s).get<std::string>());
+    EXPECT_EQ("hello, world!", moved("world!"s).get<std::string>());
+}
+
+TEST(FunctionTest, assignCallable_replacesCallable)
+{
+    Function32 function{addIntsByValue};
+    function = [](int a, int b) { return a * b; };
+
+    EXPECT_EQ(42, function(6, 7).get<int>());
+}
+
+TEST(FunctionTest, get_returnsUnderlyingCallable)
+{
+    Function32 function{addIntsByValue};
+
+    EXPECT_EQ(&addIntsByValue, function.get<decltype(&addIntsByValue)>());
+    EXPECT_EQ(cpp::FunctionKind::FREE_FUNCTION, function.kind());
+}
+
+TEST(FunctionTest, invokeInto_constructsResultInCallerStorage)
+{
+    Function32 function{addStringsByConstReference};
+    std::aligned_storage_t<sizeof(std::string), alignof(std::string)> storage;
+    cpp::AnyArg args[] = {"hello, "s, "world!"s, cpp::AnyArg(nullptr)};
+
+    ASSERT_FALSE(function.returnsVoid());
+    ASSERT_EQ(cpp::typeerasure::TypeInfo::get<std::string>(), function.returnType());
+
+    function.invokeInto(&storage, cpp::typeerasure::TypeInfo::get<std::string>(), args);
+    std::string& result = *reinterpret_cast<std::string*>(&storage);
+
+    EXPECT_EQ("hello, world!", result);
+    result.~basic_string();
+}
+
+TEST(FunctionTest, invokeInto_assignsResultToReference)
+{
+    Function32 function{&Class::addIntsByValue};
+    Class object;
+    int result = 0;
+    cpp::AnyArg args[] = {object, 20, 22, cpp::AnyArg(nullptr)};
+
+    function.invokeInto(cpp::ReferenceSimpleAny{result}, args);
+
+    EXPECT_EQ(42, result);
+}
+
+TEST(FunctionTest, invokeInto_voidCallable_ignoresResult)
+{
+    int calls = 0;
+    Function32 function{[&calls](int i) { calls += i; }};
+    cpp::AnyArg args[] = {42, cpp::AnyArg(nullptr)};
+
+    ASSERT_TRUE(function.returnsVoid());
+    function.invokeInto(nullptr, cpp::typeerasure::TypeInfo::get<int>(), args);
+
+    EXPECT_EQ(42, calls);
+}
+
+TEST(FunctionTest, invokeInto_wrongResultType_assertThrows)
+{
+    Function32 function{addIntsByValue};
+    std::string result;
+    cpp::AnyArg args[] = {20, 22, cpp::AnyArg(nullptr)};
+
+    EXPECT_THROW(function.invokeInto(cpp::ReferenceSimpleAny{result}, args), cpp::AssertException);
+}
+
+TEST(FunctionTest, invokeBatch_freeFunction_appendsResults)
+{
+    Function32 function{addIntsByValue};
+    std::vector<cpp::AnyVector> columns = {
+        cpp::AnyVector::create<int>(),
+        cpp::AnyVector::create<int>()
+    };
+    auto results = cpp::AnyVector::create<int>();
+
+    for(int i = 0; i < 10; ++i)
+    {
+        columns[0].push_back(i);
+        columns[1].push_back(42 - i);
+    }
+
+    function.invokeBatch(columns, &results);
+
+    ASSERT_EQ(10, results.size());
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(42, results.get<int>(i));
+    }
+}
+
+TEST(FunctionTest, invokeBatch_memberFunction_objectsColumn)
+{
+    Function32 function{&Class::addStringsByConstReference};
+    std::vector<cpp::AnyVector> columns = {
+        cpp::AnyVector::create<Class>(3),
+        cpp::AnyVector::create<std::string>(),
+        cpp::AnyVector::create<std::string>()
+    };
+    auto results = cpp::AnyVector::create<std::string>();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        columns[1].push_back(std::to_string(i));
+        columns[2].push_back("!"s);
+    }
+
+    function.invokeBatch(columns, &results);
+
+    ASSERT_EQ(3, results.size());
+    EXPECT_EQ("0!", results.get<std::string>(0));
+    EXPECT_EQ("1!", results.get<std::string>(1));
+    EXPECT_EQ("2!", results.get<std::string>(2));
+}
+
+TEST(FunctionTest, invokeBatch_referenceParameters_referenceColumnElements)
+{
+    Function32 function{[](int& i) { i *= 2; }};
+    std::vector<cpp::AnyVector> columns = {cpp::AnyVector::create<int>()};
+
+    for(int i = 0; i < 4; ++i)
+    {
+        columns[0].push_back(i);
+    }
+
+    function.invokeBatch(columns);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(2*i, columns[0].get<int>(i));
+    }
+}
+
+TEST(FunctionTest, invokeBatch_wrongColumnType_assertThrows)
+{
+    Function32 function{addIntsByValue};
+    std::vector<cpp::AnyVector> columns = {
+        cpp::AnyVector::create<int>(1),
+        cpp::AnyVector::create<std::string>(1)
+    };
+
+    EXPECT_THROW(function.invokeBatch(columns), cpp::AssertException);
+}
+
+TEST(FunctionTest, invokeBatch_nullaryFunction_throws)
+{
+    int calls = 0;
+    Function32 function{[&calls] { return ++calls; }};
+    std::vector<cpp::AnyVector> columns;
+    auto results = cpp::AnyVector::create<int>();
+
+    EXPECT_THROW(function.invokeBatch(columns, &results), std::exception);
+    EXPECT_EQ(0, calls);
+    EXPECT_TRUE(results.empty());
+}
+
+TEST(FunctionTest, invokeBatch_emptyFunction_assertThrows)
+{
+    Function32 function;
+    const Function32 constFunction;
+    std::vector<cpp::AnyVector> columns = {
+        cpp::AnyVector::create<int>(1)
+    };
+
+    EXPECT_THROW(function.invokeBatch(columns), cpp::AssertException);
+    EXPECT_THROW(constFunction.invokeBatch(columns), cpp::AssertException);
+}
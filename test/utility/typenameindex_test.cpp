@@ -0,0 +1,68 @@
+#include <siplasplas/utility/typenameindex.hpp>
+#include <gmock/gmock.h>
+
+using namespace ::testing;
+
+TEST(TypeNameIndexTest, find_ignoresTypeKeywordPrefixes)
+{
+    cpp::TypeNameIndex<int> index;
+    index.insert("class Foo", 1);
+    index.insert("Bar", 2);
+
+    ASSERT_NE(nullptr, index.find("Foo"));
+    EXPECT_EQ(1, *index.find("Foo"));
+    EXPECT_EQ(1, *index.find("struct Foo"));
+    EXPECT_EQ(2, *index.find("class Bar"));
+    EXPECT_EQ(nullptr, index.find("Baz"));
+    EXPECT_EQ("Foo", index.entries().front().name);
+}
+
+TEST(TypeNameIndexTest, find_doesNotRequireNullTerminatedNames)
+{
+    cpp::TypeNameIndex<int> index;
+    index.insert("Foo", 1);
+    const char names[] = "FooBar";
+
+    ASSERT_NE(nullptr, index.find(names, 3));
+    EXPECT_EQ(1, *index.find(names, 3));
+    EXPECT_EQ(nullptr, index.find(names, 6));
+}
+
+TEST(TypeNameIndexTest, insertExistingName_keepsRegisteredValue)
+{
+    cpp::TypeNameIndex<int> index;
+    EXPECT_TRUE(index.insert("Foo", 1).second);
+
+    auto result = index.insert("struct Foo", 2);
+
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first);
+    EXPECT_EQ(1, index.size());
+}
+
+TEST(TypeNameIndexTest, id_stableAndIgnoresPrefixes)
+{
+    using Index = cpp::TypeNameIndex<int>;
+    constexpr Index::Id id = Index::id("Foo", 3);
+    Index index;
+    index.insert("class Foo", 42);
+
+    EXPECT_EQ(id, Index::id("struct Foo"));
+    EXPECT_EQ(0xf2bb95199c92e1d7ull, Index::id("Foo")); // FNV-1a 64 of "Foo"
+    ASSERT_NE(nullptr, index.find(id));
+    EXPECT_EQ(42, *index.find(id));
+}
+
+TEST(TypeNameIndexTest, find_nullTerminatedNames)
+{
+    cpp::TypeNameIndex<int> index;
+    index.insert("Foo", 1);
+    const auto& constIndex = index;
+    const char* name = "struct Foo";
+
+    ASSERT_NE(nullptr, index.find(name));
+    EXPECT_EQ(1, *index.find(name));
+    ASSERT_NE(nullptr, constIndex.find(name));
+    EXPECT_EQ(1, *constIndex.find(name));
+    EXPECT_EQ(nullptr, constIndex.find("Bar"));
+}
@@ -0,0 +1,148 @@
+#include <gmock/gmock.h>
+#include <siplasplas/variant/messagebus.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+    using Event = cpp::Message<1, int, std::string>;
+    using PairEvent = cpp::Message<2, int, std::string>;
+
+    struct Handler : public cpp::HandlerFor<Handler, Event>,
+                     public cpp::HandlerFor<Handler, PairEvent>
+    {
+        using cpp::HandlerFor<Handler, Event>::receive;
+        using cpp::HandlerFor<Handler, PairEvent>::receive;
+
+        std::vector<std::string> received;
+
+        void process(int i)
+        {
+            received.push_back("int " + std::to_string(i));
+        }
+
+        void process(const std::string& str)
+        {
+            received.push_back("string " + str);
+        }
+
+        void process(const std::string& str, int i)
+        {
+            received.push_back("pair " + str + " " + std::to_string(i));
+        }
+    };
+}
+
+TEST(MessageBusTest, MessageHandler_RoutesToProcessOverload)
+{
+    Handler handler;
+
+    handler.receive(Event{42});
+    handler.receive(Event{"hello"s});
+    handler.receive(PairEvent{"hello"s, 42});
+    handler.receive(PairEvent{42, 42}); // No process(int, int), ignored
+
+    EXPECT_THAT(handler.received, ElementsAre("int 42", "string hello", "pair hello 42"));
+}
+
+TEST(MessageBusTest, MessageQueue_BoundedFifo)
+{
+    cpp::MessageQueue<int, 4> queue;
+
+    EXPECT_TRUE(queue.empty());
+
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.push(i));
+    }
+
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(4, queue.size());
+
+    int value = -1;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(queue.push(4));
+
+    std::vector<int> values;
+    EXPECT_EQ(2, queue.consume([&values](int i) { values.push_back(i); }, 2));
+    EXPECT_EQ(2, queue.consume([&values](int i) { values.push_back(i); }));
+    EXPECT_THAT(values, ElementsAre(1, 2, 3, 4));
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(MessageBusTest, Dispatch_DeliversToHandlersInOrder)
+{
+    Handler first, second;
+    cpp::MessageBus<Event, 8> bus;
+    bus.connect(first);
+    bus.connect(second);
+
+    EXPECT_TRUE(bus.publish(Event{1}));
+    EXPECT_TRUE(bus.publish(Event{"hello"s}));
+    EXPECT_TRUE(first.received.empty());
+    EXPECT_EQ(2, bus.pending());
+
+    EXPECT_EQ(2, bus.dispatch());
+    EXPECT_THAT(first.received, ElementsAre("int 1", "string hello"));
+    EXPECT_THAT(second.received, ElementsAre("int 1", "string hello"));
+
+    bus.disconnect(first);
+    bus.publish(Event{2});
+    bus.dispatch();
+    EXPECT_EQ(2, first.received.size());
+    EXPECT_EQ(3, second.received.size());
+}
+
+TEST(MessageBusTest, Mailbox_DeliversOnDispatch)
+{
+    Handler handler;
+    cpp::Mailbox<Handler, Event, 2> mailbox{handler};
+    cpp::MessageBus<Event, 8> bus;
+    bus.connect(mailbox);
+
+    bus.publish(Event{1});
+    bus.publish(Event{2});
+    bus.publish(Event{3});
+    bus.dispatch();
+
+    EXPECT_TRUE(handler.received.empty());
+    EXPECT_EQ(2, mailbox.pending());
+    EXPECT_EQ(1, bus.dropped());
+
+    EXPECT_EQ(2, mailbox.dispatch());
+    EXPECT_THAT(handler.received, ElementsAre("int 1", "int 2"));
+}
+
+TEST(MessageBusTest, Mailbox_CrossThreadDelivery)
+{
+    constexpr int count = 10000;
+    Handler handler;
+    cpp::Mailbox<Handler, Event, 16> mailbox{handler};
+
+    std::thread receiver{[&]
+    {
+        while(handler.received.size() < count)
+        {
+            mailbox.dispatch();
+        }
+    }};
+
+    for(int i = 0; i < count; ++i)
+    {
+        while(!mailbox.post(Event{i}));
+    }
+
+    receiver.join();
+
+    ASSERT_EQ(count, handler.received.size());
+
+    for(int i = 0; i < count; ++i)
+    {
+        EXPECT_EQ("int " + std::to_string(i), handler.received[i]);
+    }
+}
@@ -1,8 +1,11 @@
 #include <gmock/gmock.h>
 #include <siplasplas/variant/variant.hpp>
+#include <siplasplas/variant/multi_visitor.hpp>
+#include <siplasplas/variant/optional.hpp>
 #include "test_util.hpp"
 #include <unordered_map>
 #include <stdexcept>
+#include <cstring>
 
 using namespace ::testing;
 
@@ -32,7 +35,7 @@ TYPED_TEST_P(VariantTest, MoveAssignmentOfValue_NotEmpty)
 
     ASSERT_NO_THROW(v = TypeParam::getValue());
     EXPECT_FALSE(v.empty());
-    EXPECT_EQ(ctti::unnamed_type_id<test_case::value_type<TypeParam>>(), v.tag());
+    EXPECT_EQ(ctti::unnamed_type_id<test_case::value_type<TypeParam>>(), v.type_id());
 }
 
 TYPED_TEST_P(VariantTest, CopyAssignmentOfValue_NotEmpty)
@@ -42,7 +45,7 @@ TYPED_TEST_P(VariantTest, CopyAssignmentOfValue_NotEmpty)
 
     ASSERT_NO_THROW(v = lvalue);
     EXPECT_FALSE(v.empty());
-    EXPECT_EQ(ctti::unnamed_type_id<test_case::value_type<TypeParam>>(), v.tag());
+    EXPECT_EQ(ctti::unnamed_type_id<test_case::value_type<TypeParam>>(), v.type_id());
 }
 
 TYPED_TEST_P(VariantTest, ValueDestructorCalled)
@@ -56,12 +59,49 @@ TYPED_TEST_P(VariantTest, ValueDestructorCalled)
     EXPECT_TRUE(LifetimeRegistered<test_case::value_type<TypeParam>>::latestWasDestroyed());
 }
 
+TYPED_TEST_P(VariantTest, Index_IsIndexOfAlternative)
+{
+    using Variant = test_case::Variant<TypeParam>;
+    Variant v{TypeParam::getValue()};
+    Variant empty;
+
+    EXPECT_EQ(Variant::template index_of<test_case::value_type<TypeParam>>(), v.index());
+    EXPECT_TRUE(Variant::template has_type<test_case::value_type<TypeParam>>());
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(ctti::unnamed_type_id<void>(), empty.type_id());
+}
+
+TYPED_TEST_P(VariantTest, CopyAndMove_KeepAlternative)
+{
+    using Variant = test_case::Variant<TypeParam>;
+    Variant v{TypeParam::getValue()};
+
+    Variant copy{v};
+    EXPECT_EQ(v.index(), copy.index());
+
+    Variant moved{std::move(copy)};
+    EXPECT_EQ(v.index(), moved.index());
+
+    if(!std::is_trivially_copyable<Variant>::value)
+    {
+        EXPECT_TRUE(copy.empty());
+    }
+
+    Variant assigned;
+    assigned = moved;
+    EXPECT_EQ(v.index(), assigned.index());
+
+    assigned.clear();
+    EXPECT_TRUE(assigned.empty());
+}
+
 
 
 REGISTER_TYPED_TEST_CASE_P(VariantTest,
                            DefaultConstruction_Empty, ConstructionFromValue_NotEmpty,
                            ValueDestructorCalled,
-                           MoveAssignmentOfValue_NotEmpty, CopyAssignmentOfValue_NotEmpty);
+                           MoveAssignmentOfValue_NotEmpty, CopyAssignmentOfValue_NotEmpty,
+                           Index_IsIndexOfAlternative, CopyAndMove_KeepAlternative);
 
 
 
@@ -81,3 +121,190 @@ using test_cases = detail::functor_t<TestCases<variants>, Types>;
 INSTANTIATE_TYPED_TEST_CASE_P(TestMultipleVariantInstances, VariantTest, 
     test_cases
 );
+
+TEST(VariantTest, IndexTag_SmallestUnsignedType)
+{
+#ifndef SIPLASPLAS_VARIANT_HASH_TAG
+    EXPECT_EQ(sizeof(std::uint8_t), sizeof(cpp::Variant<int, char, bool>::tag_t));
+    EXPECT_LT(sizeof(cpp::Variant<int, float>), sizeof(int) + sizeof(ctti::unnamed_type_id_t));
+#else
+    EXPECT_EQ(sizeof(ctti::unnamed_type_id_t), sizeof(cpp::Variant<int, char, bool>::tag_t));
+#endif
+}
+
+TEST(VariantTest, TrivialAlternatives_TriviallyCopyable)
+{
+    struct Pod
+    {
+        float values[4][4];
+    };
+
+    using TrivialVariant = cpp::Variant<int, float, Pod>;
+    using Variant = cpp::Variant<int, std::string>;
+
+    EXPECT_TRUE(std::is_trivially_copyable<TrivialVariant>::value);
+    EXPECT_TRUE(std::is_trivially_destructible<TrivialVariant>::value);
+    EXPECT_TRUE(std::is_trivially_copyable<cpp::Optional<Pod>>::value);
+    EXPECT_FALSE(std::is_trivially_copyable<Variant>::value);
+    EXPECT_FALSE(std::is_trivially_destructible<Variant>::value);
+    EXPECT_FALSE(std::is_trivially_copyable<cpp::Optional<std::string>>::value);
+
+    TrivialVariant variants[] = {42, 42.0f, Pod{}, TrivialVariant{}};
+    TrivialVariant copies[4];
+    std::memcpy(copies, variants, sizeof(variants));
+
+    EXPECT_EQ(42, copies[0].get<int>());
+    EXPECT_EQ(42.0f, copies[1].get<float>());
+    EXPECT_EQ(2, copies[2].index());
+    EXPECT_TRUE(copies[3].empty());
+}
+
+namespace
+{
+    struct CountCopies
+    {
+        static int copies;
+        static int moves;
+        static int destructions;
+
+        int value;
+
+        CountCopies(int value) : value{value} {}
+        CountCopies(const CountCopies& other) : value{other.value} { ++copies; }
+        CountCopies(CountCopies&& other) : value{other.value} { ++moves; }
+        CountCopies& operator=(const CountCopies& other) { value = other.value; ++copies; return *this; }
+        CountCopies& operator=(CountCopies&& other) { value = other.value; ++moves; return *this; }
+        ~CountCopies() { ++destructions; }
+
+        static void reset()
+        {
+            copies = moves = destructions = 0;
+        }
+    };
+
+    int CountCopies::copies = 0;
+    int CountCopies::moves = 0;
+    int CountCopies::destructions = 0;
+}
+
+TEST(VariantTest, Emplace_ConstructsInPlace)
+{
+    cpp::Variant<std::string, CountCopies> v{std::string{"hello"}};
+    CountCopies::reset();
+
+    CountCopies& value = v.emplace<CountCopies>(42);
+
+    EXPECT_EQ(1, v.index());
+    EXPECT_EQ(&value, &v.get<CountCopies>());
+    EXPECT_EQ(42, value.value);
+    EXPECT_EQ(0, CountCopies::copies);
+    EXPECT_EQ(0, CountCopies::moves);
+    EXPECT_EQ(0, CountCopies::destructions);
+
+    EXPECT_EQ("wwwww", v.emplace<std::string>(5, 'w'));
+    EXPECT_EQ(1, CountCopies::destructions);
+}
+
+TEST(VariantTest, AssignSameAlternative_AssignsInPlace)
+{
+    cpp::Variant<std::string, CountCopies> v{CountCopies{1}};
+    CountCopies value{2};
+    CountCopies::reset();
+
+    v = value;
+    EXPECT_EQ(2, v.get<CountCopies>().value);
+    EXPECT_EQ(1, CountCopies::copies);
+    EXPECT_EQ(0, CountCopies::moves);
+    EXPECT_EQ(0, CountCopies::destructions);
+
+    v = CountCopies{3};
+    EXPECT_EQ(3, v.get<CountCopies>().value);
+    EXPECT_EQ(1, CountCopies::moves);
+    EXPECT_EQ(1, CountCopies::destructions); // The temporary
+}
+
+TEST(OptionalTest, ConstructAndAssign_InPlace)
+{
+    struct Aggregate
+    {
+        int a, b;
+    };
+
+    CountCopies::reset();
+    cpp::Optional<CountCopies> optional{42};
+    EXPECT_EQ(42, optional->value);
+    EXPECT_EQ(0, CountCopies::copies + CountCopies::moves);
+
+    optional = 43;
+    EXPECT_EQ(43, optional->value);
+    EXPECT_EQ(1, CountCopies::moves); // Assigned from a CountCopies{43} temporary
+
+    optional.clear();
+    optional.emplace(44);
+    EXPECT_EQ(44, optional->value);
+    EXPECT_EQ(1, CountCopies::moves);
+
+    cpp::Optional<Aggregate> aggregate{1, 2};
+    EXPECT_EQ(1, aggregate->a);
+    EXPECT_EQ(2, aggregate->b);
+
+    cpp::Optional<CountCopies> copy = optional;
+    EXPECT_EQ(44, copy->value);
+    cpp::Optional<CountCopies> empty;
+    copy = empty;
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST(VariantTest, AssignDifferentAlternative_DestroysPrevious)
+{
+    cpp::Variant<std::string, int> v{std::string{"hello"}};
+
+    v = 42;
+    EXPECT_EQ(1, v.index());
+    EXPECT_EQ(42, v.get<int>());
+
+    v = std::string{"world"};
+    EXPECT_EQ(0, v.index());
+    EXPECT_EQ("world", v.get<std::string>());
+}
+
+TEST(VariantTest, Visit_DispatchesActiveAlternative)
+{
+    cpp::Variant<int, std::string, float> v{std::string{"hello"}};
+    cpp::Variant<int, std::string, float> empty;
+
+    auto visitor = [](const auto& value) { return ctti::unnamed_type_id<std::decay_t<decltype(value)>>(); };
+
+    EXPECT_EQ(ctti::unnamed_type_id<std::string>(), v.visit<ctti::unnamed_type_id_t>(visitor));
+    EXPECT_THROW(empty.visit<ctti::unnamed_type_id_t>(visitor), std::runtime_error);
+}
+
+TEST(VariantTest, MultiVisitor_DispatchesActiveCombination)
+{
+    cpp::Variant<int, std::string> a{std::string{"hello"}};
+    cpp::Variant<int, std::string, float> b{42.0f};
+    cpp::Variant<char, int> c{42};
+
+    auto visitor = cpp::multi_visitor<std::string>(
+        [](const auto&, const auto&, const auto&) { return std::string{"other"}; },
+        [](const std::string& str, float f, int i) { return str + std::to_string(static_cast<int>(f) + i); }
+    );
+
+    EXPECT_EQ("hello84", visitor(a, b, c));
+
+    c = 'c';
+    EXPECT_EQ("other", visitor(a, b, c));
+}
+
+TEST(VariantTest, MultiVisitor_EmptyVariantThrows)
+{
+    cpp::Variant<int, std::string> a{42};
+    cpp::Variant<int, std::string> empty;
+
+    auto visitor = cpp::multi_visitor<int>(
+        [](const auto&, const auto&) { return 0; }
+    );
+
+    EXPECT_EQ(0, visitor(a, a));
+    EXPECT_THROW(visitor(a, empty), std::runtime_error);
+}
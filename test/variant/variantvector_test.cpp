@@ -0,0 +1,118 @@
+#include <gmock/gmock.h>
+#include <siplasplas/variant/variantvector.hpp>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+    using Vector = cpp::VariantVector<int, float, std::string>;
+
+    Vector makeVector()
+    {
+        Vector vector;
+        vector.push_back(1);
+        vector.push_back("hello"s);
+        vector.push_back(2.0f);
+        vector.push_back(3);
+        vector.push_back("world"s);
+
+        return vector;
+    }
+
+    struct ToString
+    {
+        std::vector<std::string>& result;
+
+        void operator()(int i) const { result.push_back("int " + std::to_string(i)); }
+        void operator()(float f) const { result.push_back("float " + std::to_string(static_cast<int>(f))); }
+        void operator()(const std::string& str) const { result.push_back("string " + str); }
+    };
+}
+
+TEST(VariantVectorTest, DefaultConstructed_Empty)
+{
+    Vector vector;
+
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(0, vector.size());
+    EXPECT_EQ(0, vector.count<int>());
+}
+
+TEST(VariantVectorTest, PushBack_PartitionsByType)
+{
+    auto vector = makeVector();
+
+    ASSERT_EQ(5, vector.size());
+    ASSERT_EQ(2, vector.count<int>());
+    ASSERT_EQ(1, vector.count<float>());
+    ASSERT_EQ(2, vector.count<std::string>());
+
+    EXPECT_EQ(1, vector.data<int>()[0]);
+    EXPECT_EQ(3, vector.data<int>()[1]);
+    EXPECT_EQ("hello", vector.data<std::string>()[0]);
+    EXPECT_EQ("world", vector.data<std::string>()[1]);
+
+    EXPECT_EQ(0, vector.index(0));
+    EXPECT_EQ(2, vector.index(1));
+    EXPECT_EQ(1, vector.index(2));
+}
+
+TEST(VariantVectorTest, PushBackVariant_InsertsActiveValue)
+{
+    Vector vector;
+    vector.push_back(cpp::Variant<int, float, std::string>{"hello"s});
+    vector.push_back(cpp::Variant<int, float, std::string>{});
+
+    ASSERT_EQ(1, vector.size());
+    EXPECT_EQ("hello", vector.data<std::string>()[0]);
+}
+
+TEST(VariantVectorTest, Visit_InsertionOrder)
+{
+    const auto vector = makeVector();
+    std::vector<std::string> result;
+
+    vector.visit(ToString{result});
+
+    EXPECT_THAT(result, ElementsAre("int 1", "string hello", "float 2", "int 3", "string world"));
+}
+
+TEST(VariantVectorTest, VisitPartitions_GroupedByType)
+{
+    auto vector = makeVector();
+    std::vector<std::string> result;
+
+    vector.visit_partitions(ToString{result});
+
+    EXPECT_THAT(result, ElementsAre("int 1", "int 3", "float 2", "string hello", "string world"));
+}
+
+TEST(VariantVectorTest, VisitType_VisitsOnlyType)
+{
+    auto vector = makeVector();
+
+    vector.visit_type<int>([](int& i) { i *= 10; });
+
+    int sum = 0;
+    vector.visit_type<int>([&sum](int i) { sum += i; });
+    EXPECT_EQ(40, sum);
+    EXPECT_EQ("hello", vector.data<std::string>()[0]);
+}
+
+TEST(VariantVectorTest, Clear_RemovesAllElements)
+{
+    auto vector = makeVector();
+
+    vector.clear();
+
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(0, vector.count<int>());
+    EXPECT_EQ(0, vector.count<std::string>());
+
+    vector.emplace_back<std::string>(3, 'a');
+    EXPECT_EQ(1, vector.size());
+    EXPECT_EQ("aaa", vector.data<std::string>()[0]);
+}